@@ -249,7 +249,11 @@ def show_results(results):
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument('ffi_type')
+    parser.add_argument('--invoke-cache-size', type=int, default=None,
+                        help='entries of the imperative invoke cache, 0 disables it')
     parsed = parser.parse_args()
+    if parsed.invoke_cache_size is not None:
+        os.environ['MXNET_IMPERATIVE_INVOKE_CACHE_SIZE'] = str(parsed.invoke_cache_size)
     if parsed.ffi_type == "cython":
         os.environ['MXNET_ENABLE_CYTHON'] = '1'
         os.environ['MXNET_ENFORCE_CYTHON'] = '1'
@@ -0,0 +1,62 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import time
+import mxnet as mx
+from mxnet import np, npx
+
+def measure_cost(repeat, func_name, *args, **kwargs):
+    """Measure time cost of running a function
+    """
+    mx.nd.waitall()
+    start = time.time()
+    for _ in range(repeat):
+        func_name(*args, **kwargs)
+    mx.nd.waitall()
+    end = time.time()
+    diff = end - start
+    return diff / repeat
+
+
+def sldwin_atten(query, key, value, dilation, w, symmetric):
+    score = npx.sldwin_atten_score(query, key, dilation, w=w, symmetric=symmetric)
+    return npx.sldwin_atten_context(score, value, dilation, w=w, symmetric=symmetric)
+
+
+def test_sldwin_atten():
+    # Longformer-base: 12 heads of 64 units, window sizes (2w) of 128 to 512
+    batch_size, seq_length, num_heads, num_head_units = 1, 4096, 12, 64
+    shape = (batch_size, seq_length, num_heads, num_head_units)
+    query = np.random.normal(0, 1, size=shape)
+    key = np.random.normal(0, 1, size=shape)
+    value = np.random.normal(0, 1, size=shape)
+    for symmetric in [True, False]:
+        for d in [1, 2]:
+            dilation = np.ones((num_heads,), dtype=np.int32) * d
+            for w in [64, 128, 256]:
+                w_len = 2 * w + 1 if symmetric else w + 1
+                # one multiply-add per window element and head unit, for score and context
+                flops = 2 * 2 * batch_size * seq_length * num_heads * w_len * num_head_units
+                args = [query, key, value, dilation, w, symmetric]
+                cost = measure_cost(10, sldwin_atten, *args)
+                print('symmetric={} dilation={} window={}: {:.3f} ms, {:.2f} GFLOPS'.format(
+                    symmetric, d, 2 * w, cost * 1000, flops / cost / 1e9))
+
+
+if __name__ == "__main__":
+    npx.set_np(dtype=False)
+    test_sldwin_atten()
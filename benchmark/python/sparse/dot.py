@@ -39,6 +39,10 @@ PARSER.add_argument('--gpu', action='store_true',
 # TODO: Use logging later
 PARSER.add_argument('--verbose', action='store_true',
                     help="Verbose output")
+PARSER.add_argument('--libsvm-data', type=str, default=None,
+                    help="path of an additional libsvm dataset (e.g. click logs) to benchmark")
+PARSER.add_argument('--feature-dim', type=int, default=None,
+                    help="number of features of the dataset given by --libsvm-data")
 ARGS = PARSER.parse_args()
 
 # some data information
@@ -200,7 +204,7 @@ def _compare_sparse_dense(data_dir, file_name, mini_file_name, feature_dim,
 
 def test_dot_real(data_dict):
     """Dot operator testing with real datasets"""
-    data_dir = os.path.join(os.getcwd(), 'data')
+    data_dir = data_dict.get('data_dir', os.path.join(os.getcwd(), 'data'))
 
     path = os.path.join(data_dir, data_dict['data_name'])
     if not os.path.exists(path):
@@ -457,6 +461,20 @@ def test_dot_synthetic(data_dict):
 
 if __name__ == "__main__":
     begin_time = time.time()
+    if ARGS.libsvm_data is not None:
+        assert ARGS.feature_dim is not None, "--feature-dim is required with --libsvm-data"
+        data_dir, data_name = os.path.split(os.path.abspath(ARGS.libsvm_data))
+        test_dot_real({
+            'data_dir': data_dir,
+            'data_mini': data_name + '.mini',
+            'data_name': data_name,
+            'feature_dim': ARGS.feature_dim,
+            'm': [1, 8, 32, 64],
+            'batch_size': [64, 128, 512],
+            'default_index': {'batch_size': 1,
+                              'output_dim': 2},
+            'num_batches': 10
+        })
     test_dot_real(KDDA)
     test_dot_real(AVAZU)
     test_dot_real(CRITEO)
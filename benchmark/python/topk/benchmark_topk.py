@@ -0,0 +1,60 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import argparse
+import time
+import mxnet as mx
+
+
+def measure_cost(repeat, func_name, *args, **kwargs):
+    """Measure time cost of running a function
+    """
+    mx.nd.waitall()
+    start = time.time()
+    for _ in range(repeat):
+        func_name(*args, **kwargs)
+    mx.nd.waitall()
+    end = time.time()
+    diff = end - start
+    return diff / repeat
+
+
+def test_topk(num_rows, row_lengths, ks, repeat):
+    # retrieval-like workloads: a few rows of millions of candidate scores
+    for n in row_lengths:
+        for m in num_rows:
+            data = mx.nd.random.uniform(shape=(m, n))
+            for k in ks:
+                if k > n:
+                    continue
+                cost = measure_cost(repeat, mx.nd.topk, data, axis=-1, k=k, ret_typ='both')
+                print('M={} N={} K={}: {:.3f} ms, {:.1f} M elements/s'.format(
+                    m, n, k, cost * 1000, m * n / cost / 1e6))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Benchmark topk on long rows")
+    parser.add_argument('--num-rows', type=int, nargs='+', default=[1, 4, 8],
+                        help='number of rows M')
+    parser.add_argument('--row-lengths', type=int, nargs='+',
+                        default=[100000, 1000000, 5000000, 50000000],
+                        help='number of elements N in every row')
+    parser.add_argument('--ks', type=int, nargs='+', default=[1, 10, 100, 1000, 100000],
+                        help='number of top elements K')
+    parser.add_argument('--repeat', type=int, default=5)
+    args = parser.parse_args()
+    test_topk(args.num_rows, args.row_lengths, args.ks, args.repeat)
@@ -28,6 +28,7 @@
 #define MXNET_CPP_MXNETCPP_H_
 
 #include "mxnet-cpp/executor.hpp"
+#include "mxnet-cpp/batching.hpp"
 #include "mxnet-cpp/symbol.hpp"
 #include "mxnet-cpp/ndarray.hpp"
 #include "mxnet-cpp/operator.hpp"
@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+* \file batching.h
+* \brief dynamic batching of concurrent inference requests
+*/
+
+#ifndef MXNET_CPP_BATCHING_H_
+#define MXNET_CPP_BATCHING_H_
+
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+#include "mxnet-cpp/base.h"
+#include "mxnet-cpp/ndarray.h"
+#include "mxnet-cpp/symbol.h"
+
+namespace mxnet {
+namespace cpp {
+
+/*!
+* \brief Runs the requests of concurrent callers of an inference model in batches.
+*  Requests queued within max_delay_us of each other are concatenated along their
+*  first axis, up to max_batch_size samples, padded to a bucket size and run in one
+*  forward. Each request gets the slices of the outputs that belong to it.
+*/
+class BatchingCachedOp {
+ public:
+  /*!
+  * \param symbol the model
+  * \param data_names the inputs that every request supplies
+  * \param params the values of all the other inputs of the symbol, by name
+  * \param context the context the batches run on
+  * \param flags max_batch_size, max_delay_us and batch_buckets, see
+  *  MXCreateBatchingCachedOp
+  */
+  BatchingCachedOp(const Symbol &symbol,
+                   const std::vector<std::string> &data_names,
+                   const std::map<std::string, NDArray> &params,
+                   const Context &context,
+                   const std::map<std::string, std::string> &flags =
+                       std::map<std::string, std::string>());
+  /*!
+  * \brief runs the queued requests and frees the handles
+  */
+  ~BatchingCachedOp();
+  /*!
+  * \brief queue a request
+  * \param data the inputs in the order of data_names, with the number of samples
+  *  of the request as first dimension. They must not be written until the outputs
+  *  are ready.
+  * \return the outputs of the request
+  */
+  std::future<std::vector<NDArray> > Submit(const std::vector<NDArray> &data);
+
+ private:
+  BatchingCachedOp(const BatchingCachedOp &);
+  BatchingCachedOp &operator=(const BatchingCachedOp &);
+  CachedOpHandle cached_op_;
+  BatchingCachedOpHandle handle_;
+};
+
+}  // namespace cpp
+}  // namespace mxnet
+#endif  // MXNET_CPP_BATCHING_H_
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+* \file batching.hpp
+* \brief implementation of BatchingCachedOp
+*/
+
+#ifndef MXNET_CPP_BATCHING_HPP_
+#define MXNET_CPP_BATCHING_HPP_
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mxnet-cpp/batching.h"
+
+namespace mxnet {
+namespace cpp {
+
+inline BatchingCachedOp::BatchingCachedOp(
+    const Symbol &symbol, const std::vector<std::string> &data_names,
+    const std::map<std::string, NDArray> &params, const Context &context,
+    const std::map<std::string, std::string> &flags) {
+  const std::vector<std::string> input_names = symbol.ListInputs();
+  std::vector<std::string> data_indices(data_names.size());
+  std::string param_indices = "[";
+  std::vector<NDArrayHandle> param_handles;
+  for (size_t i = 0; i < input_names.size(); ++i) {
+    auto data = std::find(data_names.begin(), data_names.end(), input_names[i]);
+    if (data != data_names.end()) {
+      data_indices[data - data_names.begin()] = std::to_string(i);
+      continue;
+    }
+    auto param = params.find(input_names[i]);
+    CHECK(param != params.end()) << "No value for the input " << input_names[i];
+    param_handles.push_back(param->second.GetHandle());
+    param_indices += (param_handles.size() > 1 ? ", " : "") + std::to_string(i);
+  }
+  param_indices += "]";
+  std::string data_str = "[";
+  for (size_t i = 0; i < data_indices.size(); ++i) {
+    CHECK(!data_indices[i].empty()) << "The symbol has no input " << data_names[i];
+    data_str += (i > 0 ? ", " : "") + data_indices[i];
+  }
+  data_str += "]";
+
+  // only the dispatcher thread runs the op, so it does not need to be thread safe
+  std::vector<const char *> op_keys{"data_indices", "param_indices",
+                                    "static_alloc"};
+  std::vector<const char *> op_vals{data_str.c_str(), param_indices.c_str(),
+                                    "true"};
+  CHECK_EQ(MXCreateCachedOp(symbol.GetHandle(), op_keys.size(), op_keys.data(),
+                            op_vals.data(), &cached_op_, false), 0)
+      << MXGetLastError();
+
+  std::vector<const char *> keys{"data_indices"};
+  std::vector<const char *> vals{data_str.c_str()};
+  for (const auto &flag : flags) {
+    keys.push_back(flag.first.c_str());
+    vals.push_back(flag.second.c_str());
+  }
+  CHECK_EQ(MXCreateBatchingCachedOp(cached_op_, param_handles.size(),
+                                    param_handles.data(),
+                                    context.GetDeviceType(),
+                                    context.GetDeviceId(), keys.size(),
+                                    keys.data(), vals.data(), &handle_), 0)
+      << MXGetLastError();
+}
+
+inline BatchingCachedOp::~BatchingCachedOp() {
+  MXFreeBatchingCachedOp(handle_);
+  MXFreeCachedOp(cached_op_);
+}
+
+inline std::future<std::vector<NDArray> > BatchingCachedOp::Submit(
+    const std::vector<NDArray> &data) {
+  std::vector<NDArrayHandle> handles;
+  for (const auto &array : data) {
+    handles.push_back(array.GetHandle());
+  }
+  BatchRequestHandle request;
+  CHECK_EQ(MXBatchingCachedOpSubmit(handle_, handles.size(), handles.data(),
+                                    &request), 0)
+      << MXGetLastError();
+  std::shared_ptr<void> owner(request, MXFreeBatchRequest);
+  // waits for the batch of the request in the thread that gets the outputs
+  return std::async(std::launch::deferred, [owner]() {
+    int num_outputs = 0;
+    NDArrayHandle *outputs = nullptr;
+    CHECK_EQ(MXBatchRequestWait(owner.get(), &num_outputs, &outputs), 0)
+        << MXGetLastError();
+    std::vector<NDArray> ret;
+    ret.reserve(num_outputs);
+    for (int i = 0; i < num_outputs; ++i) {
+      ret.push_back(NDArray(outputs[i]));
+    }
+    return ret;
+  });
+}
+
+}  // namespace cpp
+}  // namespace mxnet
+
+#endif  // MXNET_CPP_BATCHING_HPP_
@@ -71,6 +71,10 @@ typedef const void *FunctionHandle;
 typedef void *AtomicSymbolCreator;
 /*! \brief handle to cached operator */
 typedef void *CachedOpHandle;
+/*! \brief handle to a cached operator that batches concurrent requests */
+typedef void *BatchingCachedOpHandle;
+/*! \brief handle to a request queued on a BatchingCachedOp */
+typedef void *BatchRequestHandle;
 /*! \brief handle to a symbol that can be bind as operator */
 typedef void *SymbolHandle;
 /*! \brief handle to a AtomicSymbol */
@@ -505,6 +509,28 @@ MXNET_DLL int MXSetNumOMPThreads(int thread_num);
  */
 MXNET_DLL int MXEngineSetBulkSize(int bulk_size, int* prev_bulk_size);
 
+/*!
+ * \brief create a named execution lane, a set of CPU workers with its own queue
+ * \param name name of the lane
+ * \param num_threads number of worker threads of the lane
+ * \param out id of the lane, that of the existing lane if name is taken
+ */
+MXNET_DLL int MXEngineCreateExecutionLane(const char* name, int num_threads, int* out);
+
+/*!
+ * \brief get the id of a named execution lane
+ * \param name name of the lane, the empty name being the shared lane 0
+ * \param out id of the lane, -1 if there is none
+ */
+MXNET_DLL int MXEngineGetExecutionLane(const char* name, int* out);
+
+/*!
+ * \brief set the execution lane of the CPU operators pushed by the calling thread
+ * \param lane id of the lane, 0 for the shared workers
+ * \param prev_lane previous lane of the thread
+ */
+MXNET_DLL int MXEngineSetExecutionLane(int lane, int* prev_lane);
+
 /*!
  * \brief Get the number of GPUs.
  * \param pointer to int that will hold the number of GPUs available.
@@ -775,6 +801,77 @@ MXNET_DLL int MXNDArrayLoadFromBuffer(const void *ndarray_buffer,
                                       uint32_t *out_name_size,
                                       const char*** out_names);
 
+/*!
+ * \brief Export the weights packed into the layouts of oneDNN primitives, to be saved
+ * along with the parameters. Empty when MXNet is built without oneDNN.
+ * \param out_size number of packed weights
+ * \param out_arr uint8 arrays of the packed weights, freed by the caller
+ * \param out_names the names of the packed weights, which start with "onednn:"
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayExportPackedWeights(uint32_t *out_size,
+                                           NDArrayHandle** out_arr,
+                                           const char*** out_names);
+/*!
+ * \brief Import weights exported by MXNDArrayExportPackedWeights, so that the oneDNN
+ * operators use them instead of packing their weights again. Weights packed by another
+ * version of oneDNN are skipped.
+ * \param num_args number of packed weights
+ * \param args the packed weights
+ * \param names the names of the packed weights
+ * \param out_imported number of packed weights imported
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayImportPackedWeights(uint32_t num_args,
+                                           NDArrayHandle* args,
+                                           const char** names,
+                                           uint32_t *out_imported);
+/*!
+ * \brief Release the packed weights held by the process-wide cache of oneDNN weights
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayClearPackedWeights();
+/*!
+ * \brief Publish arrays in the named shared memory segment, which the processes serving
+ * the same model attach to instead of loading their own copy. Fails when the segment exists.
+ * \param name the name of the segment
+ * \param num_args number of arrays
+ * \param args the dense arrays
+ * \param keys the names of the arrays
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayPublishShared(const char* name,
+                                     uint32_t num_args,
+                                     NDArrayHandle* args,
+                                     const char** keys);
+/*!
+ * \brief Attach to the named shared memory segment. All the calls of a process return
+ * read-only arrays sharing the same memory, until the process detaches from the segment.
+ * \param name the name of the segment
+ * \param out_size number of arrays
+ * \param out_arr the arrays of the segment, freed by the caller
+ * \param out_names the names of the arrays
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayAttachShared(const char* name,
+                                    uint32_t *out_size,
+                                    NDArrayHandle** out_arr,
+                                    const char*** out_names);
+/*!
+ * \brief Drop the reference of the process to the named shared memory segment, which is
+ * unmapped once its arrays are freed
+ * \param name the name of the segment
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayDetachShared(const char* name);
+/*!
+ * \brief Detach from the named shared memory segment and remove it, so that no other process
+ * can attach to it. The processes attached keep their arrays.
+ * \param name the name of the segment
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXNDArrayRemoveShared(const char* name);
+
 /*!
  * \brief Perform a synchronize copy from a contiguous CPU memory region.
  *
@@ -1364,6 +1461,31 @@ MXNET_DLL int MXInvokeCachedOp(CachedOpHandle handle,
                                int *num_outputs,
                                NDArrayHandle **outputs,
                                const int** out_stypes);
+/*!
+ * \brief invoke a cached op for some of its outputs, running only the part of the graph
+ * they depend on
+ * \param handle the handle to the cached op
+ * \param num_inputs number of input NDArrays
+ * \param inputs input NDArrays
+ * \param default_dev_type the default context type
+ * \param default_dev_id the default context device id
+ * \param num_requested number of requested outputs
+ * \param requested the indices of the requested outputs, increasing
+ * \param num_outputs number of output NDArrays
+ * \param outputs output NDArrays, for the requested outputs
+ * \param out_stypes output ndarrays' stypes
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXInvokeCachedOpPartial(CachedOpHandle handle,
+                                      int num_inputs,
+                                      NDArrayHandle *inputs,
+                                      int default_dev_type,
+                                      int default_dev_id,
+                                      int num_requested,
+                                      const uint32_t *requested,
+                                      int *num_outputs,
+                                      NDArrayHandle **outputs,
+                                      const int** out_stypes);
 
 /*!
  * \brief cached op set monitor callback
@@ -1372,6 +1494,103 @@ MXNET_DLL int MXCachedOpRegisterOpHook(CachedOpHandle handle,
                                        CachedOpMonitorCallback callback,
                                        bool monitor_all);
 
+/*!
+ * \brief get the statistics of the shape cache of a cached op
+ * \param handle the cached op
+ * \param out_json JSON object with the hits and misses of the cache, and the input shapes,
+ *        hits and forward memory in bytes of its states
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXCachedOpGetShapeCacheStats(CachedOpHandle handle, const char** out_json);
+
+/*!
+ * \brief save the compiled model of a cached op: its graph, the plan of its forward on CPU for
+ *        the specs of the inputs, and its parameters, which can be mapped from the file
+ * \param handle the cached op. It requires static_alloc
+ * \param fname the file
+ * \param num_inputs number of inputs
+ * \param inputs example data inputs and the parameters, in the order of the inputs
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXCachedOpSaveCompiled(CachedOpHandle handle,
+                                     const char* fname,
+                                     int num_inputs,
+                                     NDArrayHandle* inputs);
+
+/*!
+ * \brief load a compiled model on CPU, with its forward planned and run once
+ * \param fname the file
+ * \param out the cached op
+ * \param num_inputs number of inputs of the cached op
+ * \param inputs the parameters, backed by the file, and NULL at the positions of the data
+ *        inputs. The parameters are freed by the caller
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXLoadCompiledModel(const char* fname,
+                                  CachedOpHandle* out,
+                                  int* num_inputs,
+                                  NDArrayHandle** inputs);
+
+/*!
+ * \brief create a cached op that runs the requests of concurrent callers in batches
+ * \param handle the cached op of the model. It must not be invoked elsewhere at the same time
+ *        unless it is thread safe
+ * \param num_params number of parameter NDArrays
+ * \param params the values of the inputs of the cached op that are not per request data,
+ *        in the order of the inputs
+ * \param dev_type the context type the batches run on
+ * \param dev_id the context device id the batches run on
+ * \param num_flags number of flags
+ * \param keys the keys of the flags: data_indices, max_batch_size, max_delay_us and
+ *        batch_buckets
+ * \param vals the values of the flags
+ * \param out the created batching cached op
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXCreateBatchingCachedOp(CachedOpHandle handle,
+                                       int num_params,
+                                       NDArrayHandle *params,
+                                       int dev_type,
+                                       int dev_id,
+                                       int num_flags,
+                                       const char** keys,
+                                       const char** vals,
+                                       BatchingCachedOpHandle *out);
+
+/*!
+ * \brief free a batching cached op after running its queued requests
+ */
+MXNET_DLL int MXFreeBatchingCachedOp(BatchingCachedOpHandle handle);
+
+/*!
+ * \brief queue a request on a batching cached op
+ * \param handle the batching cached op
+ * \param num_inputs number of input NDArrays
+ * \param inputs the per request inputs, batched along their first axis
+ * \param out the request, to wait on with MXBatchRequestWait
+ * \return 0 when success, -1 when failure happens
+ */
+MXNET_DLL int MXBatchingCachedOpSubmit(BatchingCachedOpHandle handle,
+                                       int num_inputs,
+                                       NDArrayHandle *inputs,
+                                       BatchRequestHandle *out);
+
+/*!
+ * \brief wait until the batch of a request has been run, and get its outputs
+ * \param handle the request
+ * \param num_outputs number of output NDArrays
+ * \param outputs the outputs of the request, to free with MXNDArrayFree
+ * \return 0 when success, -1 when failure happens, including a failure of its batch
+ */
+MXNET_DLL int MXBatchRequestWait(BatchRequestHandle handle,
+                                 int *num_outputs,
+                                 NDArrayHandle **outputs);
+
+/*!
+ * \brief free a request
+ */
+MXNET_DLL int MXFreeBatchRequest(BatchRequestHandle handle);
+
 /*!
  * \brief Get current status of deferred compute mode
  * \param curr returns the current status.
@@ -30,6 +30,7 @@
 #include <memory>
 #include <functional>
 #endif
+#include <string>
 #include <vector>
 #include "./base.h"
 
@@ -315,6 +316,29 @@ class MXNET_API Engine {
   virtual int set_bulk_size(int) {
     return 0;
   }
+  /*!
+   * \brief create a named execution lane: a set of CPU workers with its own task queue, which
+   *        runs the CPU operators pushed from the threads that select it, apart from the
+   *        operators of the other lanes. Engines without lanes run them all on lane 0.
+   * \param name name of the lane
+   * \param num_threads number of worker threads of the lane, per CPU device
+   * \return the id of the lane, that of the existing lane if name is taken
+   */
+  virtual int CreateExecutionLane(const std::string& name, int num_threads) {
+    return 0;
+  }
+  /*! \brief id of the execution lane named name, -1 if there is none */
+  virtual int GetExecutionLane(const std::string& name) {
+    return 0;
+  }
+  /*! \brief execution lane of the operators pushed by this thread, 0 for the shared workers */
+  virtual int execution_lane() const {
+    return 0;
+  }
+  /*! \brief set the execution lane of the operators pushed by this thread, returns the previous */
+  virtual int set_execution_lane(int) {
+    return 0;
+  }
 };  // class Engine
 #endif  // DMLC_USE_CXX11
 }  // namespace mxnet
@@ -64,6 +64,14 @@ class Imperative {
     AGInfo() :
       grad_req(kNullOp), fresh_out_grad(false) {}
 
+    /*! \brief AGInfo is allocated from a pool when created by a node */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    static void* operator new(std::size_t size, void* where) {
+      return where;
+    }
+    static void operator delete(void*, void*) {}
+
     static void Clear(const nnvm::ObjectPtr& node) {
       if (node == nullptr || node->info.empty()) return;
       AGInfo& info = Get(node);
@@ -260,6 +268,15 @@ class Imperative {
                     const nnvm::NodeAttrs& attrs,
                     const std::vector<NDArray*>& inputs,
                     const std::vector<NDArray*>& outputs);
+  /*!
+   * \brief Invoke, with the inferred output attributes cached for attrs_key, a key that
+   *        identifies attrs, and the inputs. An empty key disables the cache
+   */
+  OpStatePtr Invoke(const Context& default_ctx,
+                    const nnvm::NodeAttrs& attrs,
+                    const std::vector<NDArray*>& inputs,
+                    const std::vector<NDArray*>& outputs,
+                    const std::string& attrs_key);
   /*! \brief */
   OpStatePtr InvokeOp(const Context& ctx,
                       const nnvm::NodeAttrs& attrs,
@@ -94,7 +94,7 @@ class NDArray {
           Context ctx,
           bool delay_alloc = false,
           int dtype        = mshadow::default_type_flag)
-      : ptr_(std::make_shared<Chunk>(shape, ctx, delay_alloc, dtype)),
+      : ptr_(NewChunk(shape, ctx, delay_alloc, dtype)),
         shape_(shape),
         dtype_(dtype),
         storage_type_(kDefaultStorage),
@@ -118,7 +118,7 @@ class NDArray {
    * \param dtype data type of this ndarray
    */
   explicit NDArray(Context ctx, int dtype = mshadow::default_type_flag)
-      : ptr_(std::make_shared<Chunk>(mxnet::TShape(mshadow::Shape1(0)), ctx, true, dtype)),
+      : ptr_(NewChunk(mxnet::TShape(mshadow::Shape1(0)), ctx, true, dtype)),
         shape_(),
         dtype_(dtype),
         storage_type_(kDefaultStorage),
@@ -347,6 +347,10 @@ class NDArray {
   inline bool is_none() const {
     return ptr_.get() == nullptr;
   }
+  /*! \return whether the data is mapped read-only, as the arrays of shared parameters are */
+  inline bool IsReadOnly() const {
+    return ptr_ != nullptr && ptr_->read_only;
+  }
   /*! \return updated grad state in autograd_entry_ */
   bool fresh_out_grad() const;
   /*! \return updated grad state in autograd_entry_ */
@@ -841,8 +845,20 @@ class NDArray {
    */
   static void Load(dmlc::Stream* fi, std::vector<NDArray>* data, std::vector<std::string>* keys);
 
+  /*! \brief NDArrays created with new, such as the handles of the C API, come from a pool */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+  static void* operator new(std::size_t size, void* where) {
+    return where;
+  }
+  static void operator delete(void*, void*) {}
+
  private:
   friend class Imperative;
+  friend class SharedParams;
+#if MXNET_USE_ONEDNN == 1
+  friend class MKLDNNWeightCache;
+#endif
   /*! \brief the real data chunk that backs NDArray */
   // shandle is used to store the actual values in the NDArray
   // aux_handles store the aux data(such as indices) if it's needed by non-default storage.
@@ -873,6 +889,9 @@ class NDArray {
     /*! \brief whether data allocation is delayed. This doesn't indicate whether aux data
                allocation is delayed. */
     bool delay_alloc;
+    /*! \brief whether the data is mapped read-only, so that nothing writes to it, not even an
+               in-place reorder */
+    bool read_only = false;
     // the type of the storage. The storage_type is never kUndefinedStorage once the chunk
     // is constructed.
     NDArrayStorageType storage_type = kDefaultStorage;
@@ -1139,6 +1158,12 @@ class NDArray {
     ~Chunk();
   };  // struct Chunk
 
+  /*! \brief creates a dense chunk, allocated with its reference count from a pool */
+  static std::shared_ptr<Chunk> NewChunk(const mxnet::TShape& shape,
+                                         Context ctx,
+                                         bool delay_alloc,
+                                         int dtype);
+
   /*!
    * \brief initialize the NDArray
    */
@@ -21,9 +21,11 @@
 """CachedOp API."""
 
 import ctypes
+import json
+from array import array
 
-from ..base import _LIB
-from ..base import c_handle_array
+from ..base import _LIB, py_str, c_str, mx_uint
+from ..base import c_handle_array, c_array_buf
 from ..base import NDArrayHandle, CachedOpHandle, SymbolHandle
 from ..base import check_call
 from .. import _global_var
@@ -70,15 +72,85 @@ class CachedOp(object):
         ret = Symbol(sym_handle)
         return ret
 
+    def shape_cache_stats(self):
+        """Get the statistics of the shape cache.
+
+        Returns
+        -------
+        stats : dict
+            The hits and misses of the cache, and for each cached state its context,
+            input shapes, hits and forward memory in bytes under 'buckets'.
+        """
+        out = ctypes.c_char_p()
+        check_call(_LIB.MXCachedOpGetShapeCacheStats(self.handle, ctypes.byref(out)))
+        return json.loads(py_str(out.value))
+
+    def save_compiled(self, fname, inputs):
+        """Save the compiled model of the op: its graph, the plan of its forward on CPU
+        for the shapes and types of `inputs`, and its parameters, aligned so that they
+        are mapped from the file when it is loaded. The op requires static_alloc.
+
+        Parameters
+        ----------
+        fname : str
+            The file.
+        inputs : list of NDArray
+            Example data inputs and the parameters, in the order of the inputs.
+        """
+        check_call(_LIB.MXCachedOpSaveCompiled(
+            self.handle,
+            c_str(fname),
+            ctypes.c_int(len(inputs)),
+            c_handle_array(inputs)))
+
+    @classmethod
+    def load_compiled(cls, fname):
+        """Load a compiled model saved by `save_compiled` on CPU, with its forward
+        planned and run once.
+
+        Parameters
+        ----------
+        fname : str
+            The file.
+
+        Returns
+        -------
+        op : CachedOp
+            The op.
+        inputs : list of NDArray
+            The parameters, backed by the file, and None at the positions of the data
+            inputs.
+        """
+        from ..util import is_np_array
+        handle = CachedOpHandle()
+        num_inputs = ctypes.c_int()
+        input_vars = ctypes.POINTER(NDArrayHandle)()
+        check_call(_LIB.MXLoadCompiledModel(
+            c_str(fname),
+            ctypes.byref(handle),
+            ctypes.byref(num_inputs),
+            ctypes.byref(input_vars)))
+        op = cls.__new__(cls)
+        op.handle = handle
+        op.is_np_sym = is_np_array()
+        op._monitor_callback = None
+        create_ndarray_fn = _global_var._ndarray_cls
+        inputs = [create_ndarray_fn(ctypes.cast(input_vars[i], NDArrayHandle))
+                  if input_vars[i] else None for i in range(num_inputs.value)]
+        return op, inputs
+
     def __call__(self, *args, **kwargs):
         """ctypes implementation of imperative invoke wrapper"""
         # New FFI only supports numpy ndarray
         default_ctx = kwargs.pop('default_ctx', None)
         out = kwargs.pop('out', None)
+        requested_outputs = kwargs.pop('requested_outputs', None)
         if kwargs:
             raise TypeError(
                 "CachedOp.__call__ got unexpected keyword argument(s): " + \
                 ', '.join(kwargs.keys()))
+        if requested_outputs is not None:
+            return self._invoke_partial(args, requested_outputs, default_ctx, out)
         if self.is_np_sym:
             if len(args) == 1 and args[0] is None:
                 args = []
@@ -143,6 +215,48 @@ class CachedOp(object):
                 return [create_ndarray_fn(ctypes.cast(output_vars[i], NDArrayHandle),
                                           stype=out_stypes[i]) for i in range(num_output.value)]
 
+    def _invoke_partial(self, args, requested_outputs, default_ctx, out):
+        """Invokes the op for the outputs at the increasing indices `requested_outputs`,
+        running only the operators they depend on."""
+        if out is not None:
+            original_output = out
+            if isinstance(out, NDArrayBase):
+                out = (out,)
+            num_output = ctypes.c_int(len(out))
+            output_vars = c_handle_array(out)
+            output_vars = ctypes.cast(output_vars, ctypes.POINTER(NDArrayHandle))
+        else:
+            original_output = None
+            output_vars = ctypes.POINTER(NDArrayHandle)()
+            num_output = ctypes.c_int(0)
+        out_stypes = ctypes.POINTER(ctypes.c_int)()
+
+        if len(args) == 1 and args[0] is None:
+            args = []
+            assert default_ctx is not None, 'default_ctx is required if no input is provided'
+        else:
+            default_ctx = args[0].ctx if default_ctx is None else default_ctx
+
+        check_call(_LIB.MXInvokeCachedOpPartial(
+            self.handle,
+            ctypes.c_int(len(args)),
+            c_handle_array(args),
+            ctypes.c_int(default_ctx.device_typeid),
+            ctypes.c_int(default_ctx.device_id),
+            ctypes.c_int(len(requested_outputs)),
+            c_array_buf(mx_uint, array('I', requested_outputs)),
+            ctypes.byref(num_output),
+            ctypes.byref(output_vars),
+            ctypes.byref(out_stypes)))
+
+        if original_output is not None:
+            return original_output
+        create_ndarray_fn = _global_var._np_ndarray_cls if self.is_np_sym \
+            else _global_var._ndarray_cls
+        outputs = [create_ndarray_fn(ctypes.cast(output_vars[i], NDArrayHandle),
+                                     stype=out_stypes[i]) for i in range(num_output.value)]
+        return outputs[0] if len(outputs) == 1 else outputs
+
     def _register_op_hook(self, callback, monitor_all=False):
         """Install callback for monitor.
 
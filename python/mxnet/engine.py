@@ -19,7 +19,7 @@
 """Engine properties management."""
 
 import ctypes
-from .base import _LIB, check_call
+from .base import _LIB, check_call, c_str
 
 
 def set_bulk_size(size):
@@ -72,3 +72,79 @@ def bulk(size):
                 x += 1
     """
     return _BulkScope(size)
+
+
+def create_execution_lane(name, num_threads):
+    """Create a named execution lane.
+
+    An execution lane is a set of CPU worker threads with its own task queue.
+    The CPU operators pushed from a thread that selected the lane run on its
+    workers only, so that latency-sensitive requests do not queue behind the
+    operators of other requests.
+
+    Parameters
+    ----------
+    name : str
+        Name of the lane.
+    num_threads : int
+        Number of worker threads of the lane.
+
+    Returns
+    -------
+    int
+        Id of the lane, that of the existing lane if the name is taken.
+    """
+    lane = ctypes.c_int()
+    check_call(_LIB.MXEngineCreateExecutionLane(
+        c_str(name), ctypes.c_int(num_threads), ctypes.byref(lane)))
+    return lane.value
+
+
+def set_execution_lane(lane):
+    """Set the execution lane of the CPU operators pushed by this thread.
+
+    Parameters
+    ----------
+    lane : int
+        Id of the lane, 0 for the shared workers.
+
+    Returns
+    -------
+    int
+        Previous lane of the thread.
+    """
+    prev = ctypes.c_int()
+    check_call(_LIB.MXEngineSetExecutionLane(
+        ctypes.c_int(lane), ctypes.byref(prev)))
+    return prev.value
+
+
+class _ExecutionLaneScope(object):
+    """Scope object for execution lanes."""
+    def __init__(self, lane):
+        self._lane = lane
+        self._old_lane = None
+
+    def __enter__(self):
+        self._old_lane = set_execution_lane(self._lane)
+        return self
+
+    def __exit__(self, ptype, value, trace):
+        set_execution_lane(self._old_lane)
+
+
+def execution_lane(name):
+    """Runs the CPU operators pushed in the scope on the execution lane `name`,
+    created beforehand with `create_execution_lane` or MXNET_CPU_EXECUTION_LANES.
+
+    Returns a scope for managing the execution lane::
+
+        mx.engine.create_execution_lane('latency', 2)
+        with mx.engine.execution_lane('latency'):
+            out = net(x)
+    """
+    lane = ctypes.c_int()
+    check_call(_LIB.MXEngineGetExecutionLane(c_str(name), ctypes.byref(lane)))
+    if lane.value < 0:
+        raise ValueError('Unknown execution lane %s' % name)
+    return _ExecutionLaneScope(lane.value)
@@ -461,8 +461,13 @@ class Block:
             filename = None
         params = self.collect_params()
         error_str = "file: %s" % (filename) if filename else "param_dict"
+        # weights packed for oneDNN, saved by export(packed_weights=True)
+        packed = {k: v.as_nd_ndarray() if isinstance(v, _mx_np.ndarray) else v
+                  for k, v in param_dict.items() if k.startswith('onednn:')}
+        if packed:
+            nd.import_packed_weights(packed)
         loaded = {k[4:] if k.startswith('arg:') or k.startswith('aux:') else k: v \
-                  for k, v in param_dict.items()}
+                  for k, v in param_dict.items() if not k.startswith('onednn:')}
 
         if not allow_missing:
             params_inv = defaultdict(list)
@@ -489,6 +494,44 @@ class Block:
                     param = _mx_np.array(param) if is_np_array() else nd.array(param)
                 params[name]._load_init(param, ctx, cast_dtype=cast_dtype, dtype_source=dtype_source)
 
+    def load_shared_parameters(self, name, allow_missing=False, ignore_extra=False):
+        """Attaches the parameters to the named shared memory segment published by
+        `mx.nd.publish_shared_params`, instead of loading a copy.
+
+        All the blocks and processes attached to the segment use the same memory. The parameters
+        are on cpu(0) and read-only, and are not trained: their `grad_req` is set to 'null'.
+
+        Parameters
+        ----------
+        name : str
+            The name of the segment.
+        allow_missing : bool, default False
+            Whether to silently skip parameters not present in the segment.
+        ignore_extra : bool, default False
+            Whether to silently ignore arrays of the segment that are not parameters of this Block.
+        """
+        params = self.collect_params()
+        shared = {k[4:] if k.startswith('arg:') or k.startswith('aux:') else k: v
+                  for k, v in nd.attach_shared_params(name).items()}
+        if is_np_array():
+            shared = {k: v.as_np_ndarray() for k, v in shared.items()}
+        if not allow_missing:
+            for param_name in params:
+                assert param_name in shared, \
+                    "Parameter '%s' is missing in shared parameters '%s', which contain: %s. " \
+                    "Set allow_missing=True to ignore missing parameters."%(
+                        param_name, name, _brief_print_list(shared.keys()))
+        for param_name, data in shared.items():
+            if param_name not in params:
+                if not ignore_extra:
+                    raise ValueError(
+                        "Parameter '%s' of shared parameters '%s' is not present in Dict, " \
+                        "which contains parameters %s. Set ignore_extra=True to ignore. "%(
+                            param_name, name, _brief_print_list(params.keys())))
+                continue
+            params[param_name].grad_req = 'null'
+            params[param_name]._load_init(data, data.context, share=True)
+
     def register_child(self, block, name=None):
         """Registers block as a child of self. :py:class:`Block` s assigned to self as
         attributes will be registered automatically."""
@@ -1382,7 +1425,11 @@ class HybridBlock(Block):
                   static_shape=False,
                   inline_limit=2,
                   forward_bulk_size=None,
-                  backward_bulk_size=None):
+                  backward_bulk_size=None,
+                  shape_cache_size=None,
+                  bucket_axis=None,
+                  shape_buckets=None,
+                  execution_lane=None):
         """Activates or deactivates :py:class:`HybridBlock` s recursively. Has no effect on
         non-hybrid children.
 
@@ -1404,6 +1451,19 @@ class HybridBlock(Block):
             Segment size of bulk execution during forward pass.
         backward_bulk_size : optional int, default None
             Segment size of bulk execution during backward pass.
+        shape_cache_size : optional int, default None
+            Number of input shapes whose static memory plan is kept, least recently
+            used first out. Must also set static_alloc to True.
+        bucket_axis : optional int, default None
+            Axis along which the data inputs are padded with zeros to a bucket length
+            in inference. The outputs are sliced back. Must also set static_alloc to True.
+        shape_buckets : optional list of int, default None
+            Increasing bucket lengths along bucket_axis. Learned from the input lengths
+            if not set.
+        execution_lane : optional str, default None
+            Name of the engine execution lane the forward runs its CPU operators on,
+            created with `mx.engine.create_execution_lane`. Uses the lane of the
+            calling thread if not set.
         """
 
         self._active = active
@@ -1414,6 +1474,14 @@ class HybridBlock(Block):
             self._flags.append(("forward_bulk_size", forward_bulk_size))
         if backward_bulk_size is not None:
             self._flags.append(("backward_bulk_size", backward_bulk_size))
+        if shape_cache_size is not None:
+            self._flags.append(("shape_cache_size", shape_cache_size))
+        if bucket_axis is not None:
+            self._flags.append(("bucket_axis", bucket_axis))
+        if shape_buckets is not None:
+            self._flags.append(("shape_buckets", tuple(shape_buckets)))
+        if execution_lane is not None:
+            self._flags.append(("execution_lane", execution_lane))
         self._clear_cached_op()
         if active and self._forward_hooks or self._forward_pre_hooks:
             warnings.warn('"{block}" is being hybridized while still having forward hook/pre-hook. '
@@ -1424,7 +1492,11 @@ class HybridBlock(Block):
                                            static_shape=static_shape,
                                            inline_limit=inline_limit,
                                            forward_bulk_size=forward_bulk_size,
-                                           backward_bulk_size=backward_bulk_size)
+                                           backward_bulk_size=backward_bulk_size,
+                                           shape_cache_size=shape_cache_size,
+                                           bucket_axis=bucket_axis,
+                                           shape_buckets=shape_buckets,
+                                           execution_lane=execution_lane)
 
     def cast(self, dtype):
         if self._active:
@@ -1468,7 +1540,7 @@ class HybridBlock(Block):
         """Infers data type of Parameters from inputs."""
         self._infer_attrs('infer_type', 'dtype', *args)
 
-    def export(self, path, epoch=0, remove_amp_cast=True):
+    def export(self, path, epoch=0, remove_amp_cast=True, packed_weights=False):
         """Export HybridBlock to json format that can be loaded by
         `gluon.SymbolBlock.imports` or the C++ interface.
 
@@ -1486,6 +1558,10 @@ class HybridBlock(Block):
             Epoch number of saved model.
         remove_amp_cast : bool, optional
             Whether to remove the amp_cast and amp_multicast operators, before saving the model.
+        packed_weights : bool, optional
+            Whether to also save the weights packed into the layouts of oneDNN primitives by
+            the inference forwards run so far in the process, so that the processes loading
+            the model skip packing them.
 
         Returns
         -------
@@ -1529,6 +1605,9 @@ class HybridBlock(Block):
                                       .format(name=name), stacklevel=3)
                     else:
                         arg_dict['aux:%s'%name] = param._reduce()
+        if packed_weights:
+            for name, weight in nd.export_packed_weights().items():
+                arg_dict[name] = weight.as_np_ndarray() if is_np_array() else weight
         params_filename = '%s-%04d.params'%((path if path is not None else ""), epoch)
 
         if path is not None:
@@ -265,7 +265,7 @@ class Parameter(object):
         trainer._row_sparse_pull(self, results, row_id)
         return results
 
-    def _load_init(self, data, ctx, cast_dtype=False, dtype_source='current'):
+    def _load_init(self, data, ctx, cast_dtype=False, dtype_source='current', share=False):
         """
         (Re)initializes by loading from data.
         Parameters
@@ -280,6 +280,8 @@ class Parameter(object):
             must be in {'current', 'saved'}
             Only valid if cast_dtype=True, specify the source of the dtype for casting
             the parameters
+        share : bool, default False
+            Use data as the parameter instead of a copy. ctx must be the context of data.
         """
         if cast_dtype:
             assert dtype_source in ['current', 'saved']
@@ -315,7 +317,12 @@ class Parameter(object):
             data = data.tostype(self._stype)
         if isinstance(ctx, Context):
             ctx = [ctx]
-        if self._data is None:
+        if share:
+            assert list(ctx) == [data.context], \
+                "Failed to share data of Parameter '%s', which is on %s, on %s."%(
+                    self.name, str(data.context), str(ctx))
+            self._init_impl(data, ctx, share=True)
+        elif self._data is None:
             if self._deferred_init:
                 assert ctx is None or set(ctx) == set(self._deferred_init[1]), \
                     "Failed to load Parameter '%s' on %s because it was " \
@@ -363,7 +370,7 @@ class Parameter(object):
 
             self._init_impl(data, ctx)
 
-    def _init_impl(self, data, ctx_list):
+    def _init_impl(self, data, ctx_list, share=False):
         """Sets data and grad."""
         self._ctx_list = list(ctx_list)
         self._ctx_map = [[], []]
@@ -373,7 +380,10 @@ class Parameter(object):
                 dev_list.append(None)
             dev_list[ctx.device_id] = i
 
-        self._data = [data.copyto(ctx) for ctx in self._ctx_list]
+        if share:
+            self._data = [data]
+        else:
+            self._data = [data.copyto(ctx) for ctx in self._ctx_list]
         self._init_grad()
 
     def _init_grad(self):
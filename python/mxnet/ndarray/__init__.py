@@ -28,6 +28,9 @@ from .op import *
 from .ndarray import *
 # pylint: enable=wildcard-import
 from .utils import load, load_frombuffer, save, zeros, empty, array
+from .utils import export_packed_weights, import_packed_weights, clear_packed_weights
+from .utils import publish_shared_params, attach_shared_params, detach_shared_params
+from .utils import remove_shared_params
 from .sparse import _ndarray_cls
 from .ndarray import _GRAD_REQ_MAP, _DTYPE_MX_TO_NP, _DTYPE_NP_TO_MX, _new_empty_handle
 from . import numpy as np
@@ -34,7 +34,10 @@ try:
 except ImportError:
     spsp = None
 
-__all__ = ['zeros', 'empty', 'array', 'load', 'load_frombuffer', 'save']
+__all__ = ['zeros', 'empty', 'array', 'load', 'load_frombuffer', 'save',
+           'export_packed_weights', 'import_packed_weights', 'clear_packed_weights',
+           'publish_shared_params', 'attach_shared_params', 'detach_shared_params',
+           'remove_shared_params']
 
 
 def zeros(shape, ctx=None, dtype=None, stype=None, **kwargs):
@@ -269,3 +272,118 @@ def save(fname, data):
         raise ValueError("data needs to either be a NDArray, dict of str, NDArray pairs "
                          "or a list of NDarrays.")
     check_call(_LIB.MXNDArrayLegacySave(c_str(fname), mx_uint(len(handles)), handles, keys))
+
+
+def export_packed_weights():
+    """Exports the weights packed into the layouts of oneDNN primitives by the operators
+    alive, so that they can be saved along with the parameters.
+
+    Returns
+    -------
+    dict of str to NDArray
+        The packed weights, whose names start with ``onednn:``. Empty when MXNet is built
+        without oneDNN.
+    """
+    out_size = mx_uint()
+    handles = ctypes.POINTER(NDArrayHandle)()
+    names = ctypes.POINTER(ctypes.c_char_p)()
+    check_call(_LIB.MXNDArrayExportPackedWeights(ctypes.byref(out_size),
+                                                 ctypes.byref(handles),
+                                                 ctypes.byref(names)))
+    return dict(
+        (py_str(names[i]), _ndarray_cls(NDArrayHandle(handles[i])))
+        for i in range(out_size.value))
+
+
+def import_packed_weights(data):
+    """Imports weights exported by ``export_packed_weights``, so that the oneDNN operators
+    use them instead of packing their weights again.
+
+    Parameters
+    ----------
+    data : dict of str to NDArray
+        Loaded parameters. Only the entries whose names start with ``onednn:`` are imported.
+
+    Returns
+    -------
+    int
+        The number of packed weights imported. Weights packed by another version of
+        oneDNN are skipped.
+    """
+    packed = {k: v for k, v in data.items() if k.startswith('onednn:')}
+    imported = mx_uint()
+    check_call(_LIB.MXNDArrayImportPackedWeights(mx_uint(len(packed)),
+                                                 c_handle_array(list(packed.values())),
+                                                 c_str_array(list(packed.keys())),
+                                                 ctypes.byref(imported)))
+    return imported.value
+
+
+def clear_packed_weights():
+    """Releases the packed weights held by the process-wide cache of oneDNN weights."""
+    check_call(_LIB.MXNDArrayClearPackedWeights())
+
+
+def publish_shared_params(name, data):
+    """Publishes parameters in the named shared memory segment, so that the processes serving
+    the same model attach to one copy instead of loading their own.
+
+    The segment lives until it is removed by ``remove_shared_params``.
+
+    Parameters
+    ----------
+    name : str
+        The name of the segment, which must not contain ``/``.
+    data : dict of str to NDArray
+        The dense parameters, as returned by ``load``.
+
+    Returns
+    -------
+    dict of str to NDArray
+        The parameters of the segment, as returned by ``attach_shared_params``.
+    """
+    check_call(_LIB.MXNDArrayPublishShared(c_str(name),
+                                           mx_uint(len(data)),
+                                           c_handle_array(list(data.values())),
+                                           c_str_array(list(data.keys()))))
+    return attach_shared_params(name)
+
+
+def attach_shared_params(name):
+    """Attaches to the parameters published in the named shared memory segment.
+
+    All the calls of a process return arrays sharing the same memory. The arrays are read-only:
+    the operators writing to them fail.
+
+    Parameters
+    ----------
+    name : str
+        The name of the segment.
+
+    Returns
+    -------
+    dict of str to NDArray
+        The parameters of the segment.
+    """
+    out_size = mx_uint()
+    handles = ctypes.POINTER(NDArrayHandle)()
+    names = ctypes.POINTER(ctypes.c_char_p)()
+    check_call(_LIB.MXNDArrayAttachShared(c_str(name),
+                                          ctypes.byref(out_size),
+                                          ctypes.byref(handles),
+                                          ctypes.byref(names)))
+    return dict(
+        (py_str(names[i]), _ndarray_cls(NDArrayHandle(handles[i])))
+        for i in range(out_size.value))
+
+
+def detach_shared_params(name):
+    """Drops the reference of the process to the named shared memory segment, which is unmapped
+    once the arrays attached are released."""
+    check_call(_LIB.MXNDArrayDetachShared(c_str(name)))
+
+
+def remove_shared_params(name):
+    """Detaches from the named shared memory segment and removes it, so that no other process
+    can attach to it. The processes attached keep their arrays."""
+    check_call(_LIB.MXNDArrayRemoveShared(c_str(name)))
@@ -19,8 +19,9 @@
 from __future__ import absolute_import
 import math
 from ..ndarray import (zeros, clip, sqrt, square)
-from ..ndarray import adam_update
+from ..ndarray import adam_update, multi_adam_update
 from .optimizer import Optimizer, register
+from .utils import _flatten_list
 
 __all__ = ['Adam']
 
@@ -163,6 +164,17 @@ class Adam(Optimizer):
         states : List of any obj
             List of state returned by `create_state()`.
         """
+        # multi_adam_update is implemented on CPU and does not support sparse weight or gradient.
+        aggregate = self.aggregate_num > 1
+        for weight, grad in zip(weights, grads):
+            aggregate = (aggregate and
+                         weight.context.device_type == 'cpu' and
+                         weight.stype == 'default' and
+                         grad.stype == 'default')
+        if aggregate:
+            self._aggregated_fused_step(indices, weights, grads, states)
+            return
+
         for index, weight, grad, state in zip(indices, weights, grads, states):
             self._update_count(index)
             lr = self._get_lr(index)
@@ -184,3 +196,26 @@ class Adam(Optimizer):
             # update weight with fused kernel
             adam_update(weight, grad, mean, var, out=weight,
                         lazy_update=self.lazy_update, lr=lr, wd=wd, **kwargs)
+
+    def _aggregated_fused_step(self, indices, weights, grads, states):
+        """Update `aggregate_num` weights at a time with the multi-tensor kernel."""
+        self._update_count(indices)
+        lrs = self._get_lrs(indices)
+        wds = self._get_wds(indices)
+        for i, index in enumerate(indices):
+            t = self._index_update_count[index]
+            coef1 = 1. - self.beta1**t
+            coef2 = 1. - self.beta2**t
+            lrs[i] *= math.sqrt(coef2)/coef1
+        kwargs = {'beta1': self.beta1, 'beta2': self.beta2, 'epsilon': self.epsilon,
+                  'rescale_grad': self.rescale_grad}
+        if self.clip_gradient:
+            kwargs['clip_gradient'] = self.clip_gradient
+        means, variances = list(zip(*states))
+        num = int(min(self.aggregate_num, len(indices)))
+        for sidx in range(0, len(indices), num):
+            eidx = min(sidx + num, len(indices))
+            multi_adam_update(*_flatten_list(zip(weights[sidx:eidx], grads[sidx:eidx],
+                                                 means[sidx:eidx], variances[sidx:eidx])),
+                              out=weights[sidx:eidx], num_weights=eidx - sidx,
+                              lrs=lrs[sidx:eidx], wds=wds[sidx:eidx], **kwargs)
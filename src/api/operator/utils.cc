@@ -102,7 +102,10 @@ std::vector<NDArray*> Invoke(const nnvm::Op* op,
     for (NDArray* input : ndinputs) {
       Imperative::DCInfo::Compute(*input);
     }
-    auto state = Imperative::Get()->Invoke(Context::CPU(), *attrs, ndinputs, ndoutputs);
+    // an operator without parameters is identified by its name
+    const bool by_name = attrs->parsed.empty() && attrs->dict.empty();
+    auto state         = Imperative::Get()->Invoke(
+        Context::CPU(), *attrs, ndinputs, ndoutputs, by_name ? op->name : std::string());
     if (is_recording()) {
       Imperative::Get()->RecordOp(std::move(*attrs), ndinputs, ndoutputs, state);
     }
@@ -49,7 +49,9 @@
 #include "mxnet/lib_api.h"
 #include "../initialize.h"
 #include "./c_api_common.h"
+#include "../ndarray/shared_params.h"
 #include "../operator/custom/custom-inl.h"
+#include "../operator/nn/mkldnn/mkldnn_weight_cache-inl.h"
 #include "../operator/operator_common.h"
 #include "../operator/subgraph/common.h"
 #include "../operator/tensor/matrix_op-inl.h"
@@ -1925,6 +1927,24 @@ int MXEngineSetBulkSize(int bulk_size, int* prev_bulk_size) {
   API_END();
 }
 
+int MXEngineCreateExecutionLane(const char* name, int num_threads, int* out) {
+  API_BEGIN();
+  *out = Engine::Get()->CreateExecutionLane(name, num_threads);
+  API_END();
+}
+
+int MXEngineGetExecutionLane(const char* name, int* out) {
+  API_BEGIN();
+  *out = Engine::Get()->GetExecutionLane(name);
+  API_END();
+}
+
+int MXEngineSetExecutionLane(int lane, int* prev_lane) {
+  API_BEGIN();
+  *prev_lane = Engine::Get()->set_execution_lane(lane);
+  API_END();
+}
+
 int MXGetGPUCount(int* out) {
   API_BEGIN();
   *out = Context::GetGPUCount();
@@ -2386,6 +2406,101 @@ int MXNDArrayLoadFromBuffer(const void* ndarray_buffer,
   API_END();
 }
 
+int MXNDArrayExportPackedWeights(uint32_t* out_size,
+                                 NDArrayHandle** out_arr,
+                                 const char*** out_names) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  ret->ret_vec_str.clear();
+  API_BEGIN();
+  std::vector<NDArray> data;
+#if MXNET_USE_ONEDNN == 1
+  MKLDNNWeightCache::Get()->Export(&ret->ret_vec_str, &data);
+#endif
+  ret->ret_handles.resize(data.size());
+  ret->ret_vec_charp.resize(data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    ret->ret_handles[i]   = new NDArray(data[i]);
+    ret->ret_vec_charp[i] = ret->ret_vec_str[i].c_str();
+  }
+  *out_size  = static_cast<uint32_t>(data.size());
+  *out_arr   = dmlc::BeginPtr(ret->ret_handles);
+  *out_names = dmlc::BeginPtr(ret->ret_vec_charp);
+  API_END();
+}
+
+int MXNDArrayImportPackedWeights(uint32_t num_args,
+                                 NDArrayHandle* args,
+                                 const char** names,
+                                 uint32_t* out_imported) {
+  API_BEGIN();
+  *out_imported = 0;
+#if MXNET_USE_ONEDNN == 1
+  std::vector<std::string> weight_names;
+  std::vector<NDArray> weights;
+  for (uint32_t i = 0; i < num_args; ++i) {
+    weight_names.emplace_back(names[i]);
+    weights.push_back(*static_cast<NDArray*>(args[i]));
+  }
+  *out_imported = MKLDNNWeightCache::Get()->Import(weight_names, weights);
+#endif
+  API_END();
+}
+
+int MXNDArrayClearPackedWeights() {
+  API_BEGIN();
+#if MXNET_USE_ONEDNN == 1
+  MKLDNNWeightCache::Get()->Clear();
+#endif
+  API_END();
+}
+
+int MXNDArrayPublishShared(const char* name,
+                           uint32_t num_args,
+                           NDArrayHandle* args,
+                           const char** keys) {
+  API_BEGIN();
+  std::vector<std::string> names;
+  std::vector<NDArray> arrays;
+  for (uint32_t i = 0; i < num_args; ++i) {
+    names.emplace_back(keys[i]);
+    arrays.push_back(*static_cast<NDArray*>(args[i]));
+  }
+  SharedParams::Get()->Publish(name, names, arrays);
+  API_END();
+}
+
+int MXNDArrayAttachShared(const char* name,
+                          uint32_t* out_size,
+                          NDArrayHandle** out_arr,
+                          const char*** out_names) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  auto segment     = SharedParams::Get()->Attach(name);
+  ret->ret_vec_str = segment->names;
+  ret->ret_handles.resize(segment->arrays.size());
+  ret->ret_vec_charp.resize(segment->arrays.size());
+  for (size_t i = 0; i < segment->arrays.size(); ++i) {
+    ret->ret_handles[i]   = new NDArray(segment->arrays[i]);
+    ret->ret_vec_charp[i] = ret->ret_vec_str[i].c_str();
+  }
+  *out_size  = static_cast<uint32_t>(segment->arrays.size());
+  *out_arr   = dmlc::BeginPtr(ret->ret_handles);
+  *out_names = dmlc::BeginPtr(ret->ret_vec_charp);
+  API_END();
+}
+
+int MXNDArrayDetachShared(const char* name) {
+  API_BEGIN();
+  SharedParams::Get()->Detach(name);
+  API_END();
+}
+
+int MXNDArrayRemoveShared(const char* name) {
+  API_BEGIN();
+  SharedParams::Get()->Remove(name);
+  API_END();
+}
+
 int MXNDArrayFree(NDArrayHandle handle) {
   API_BEGIN();
   delete static_cast<NDArray*>(handle);
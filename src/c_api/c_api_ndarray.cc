@@ -38,6 +38,8 @@
 #include "../imperative/imperative_utils.h"
 #include "../imperative/cached_op.h"
 #include "../imperative/cached_op_threadsafe.h"
+#include "../imperative/batching_cached_op.h"
+#include "../imperative/invoke_cache.h"
 #include "../profiler/profiler.h"
 
 using namespace mxnet;
@@ -98,12 +100,9 @@ void MXImperativeInvokeImpl(AtomicSymbolCreator creator,
   const nnvm::Op* op           = static_cast<nnvm::Op*>(creator);
   MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
 
-  nnvm::NodeAttrs attrs =
-      imperative::ParseAttrs(op, num_inputs, num_params, param_keys, param_vals);
-  attrs.dict["__profiler_scope__"] = profiler::ProfilerScope::Get()->GetCurrentProfilerScope();
-  if (attrs.op) {
-    attrs.name = attrs.op->name;
-  }
+  std::string attrs_key;
+  nnvm::NodeAttrs attrs = imperative::InvokeCache::Get()->ParseAttrs(
+      op, num_inputs, num_params, param_keys, param_vals, &attrs_key);
 
   int infered_num_outputs;
   int num_visible_outputs;
@@ -126,7 +125,8 @@ void MXImperativeInvokeImpl(AtomicSymbolCreator creator,
     for (NDArray* input : ndinputs) {
       Imperative::DCInfo::Compute(*input);
     }
-    auto state = Imperative::Get()->Invoke(Context::CPU(), attrs, ndinputs, ndoutputs);
+    auto state =
+        Imperative::Get()->Invoke(Context::CPU(), attrs, ndinputs, ndoutputs, attrs_key);
     if (Imperative::Get()->is_recording()) {
       Imperative::Get()->RecordOp(std::move(attrs), ndinputs, ndoutputs, state);
     }
@@ -268,6 +268,68 @@ int MXInvokeCachedOp(CachedOpHandle handle,
   API_END();
 }
 
+int MXInvokeCachedOpPartial(CachedOpHandle handle,
+                            int num_inputs,
+                            NDArrayHandle* inputs,
+                            int default_dev_type,
+                            int default_dev_id,
+                            int num_requested,
+                            const uint32_t* requested,
+                            int* num_outputs,
+                            NDArrayHandle** outputs,
+                            const int** out_stypes) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+
+  API_BEGIN();
+  CachedOpPtr op_shared = *static_cast<CachedOpPtr*>(handle);
+  CachedOp* op          = dynamic_cast<CachedOp*>(op_shared.get());
+  std::vector<NDArray*> ndinputs;
+  ndinputs.reserve(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    ndinputs.push_back(reinterpret_cast<NDArray*>(inputs[i]));
+  }
+
+  std::vector<NDArray*> ndoutputs;
+  ndoutputs.reserve(num_requested);
+  if (*outputs == nullptr) {
+    *num_outputs = num_requested;
+    for (int i = 0; i < *num_outputs; ++i)
+      ndoutputs.push_back(new NDArray());
+  } else {
+    CHECK_EQ(*num_outputs, num_requested) << "CachedOp expects " << num_requested
+                                          << " outputs, but " << *num_outputs << " was given.";
+    for (int i = 0; i < *num_outputs; ++i) {
+      ndoutputs.push_back(reinterpret_cast<NDArray*>((*outputs)[i]));
+    }
+  }
+  Context ctx = Context::Create(static_cast<Context::DeviceType>(default_dev_type), default_dev_id);
+  op->PartialForward(op_shared,
+                     std::vector<uint32_t>(requested, requested + num_requested),
+                     ndinputs,
+                     ndoutputs,
+                     ctx);
+
+  if (*outputs == nullptr) {
+    ret->ret_handles.clear();
+    ret->ret_handles.reserve(*num_outputs);
+    for (int i = 0; i < *num_outputs; ++i) {
+      ret->ret_handles.push_back(ndoutputs[i]);
+    }
+    *outputs = dmlc::BeginPtr(ret->ret_handles);
+  }
+  if (out_stypes != nullptr) {
+    NDArray** out_array = reinterpret_cast<NDArray**>(*outputs);
+    ret->out_types.clear();
+    ret->out_types.reserve(*num_outputs);
+    for (int i = 0; i < *num_outputs; ++i) {
+      ret->out_types.emplace_back(out_array[i]->storage_type());
+    }
+    *out_stypes = dmlc::BeginPtr(ret->out_types);
+  }
+
+  API_END();
+}
+
 int MXAutogradIsTraining(bool* curr) {
   API_BEGIN();
   *curr = Imperative::Get()->is_training();
@@ -432,6 +494,119 @@ int MXCachedOpRegisterOpHook(CachedOpHandle handle,
   API_END();
 }
 
+int MXCachedOpGetShapeCacheStats(CachedOpHandle handle, const char** out_json) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  CachedOpPtr op = *static_cast<CachedOpPtr*>(handle);
+  ret->ret_str   = op->ShapeCacheStats();
+  *out_json      = ret->ret_str.c_str();
+  API_END();
+}
+
+int MXCachedOpSaveCompiled(CachedOpHandle handle,
+                           const char* fname,
+                           int num_inputs,
+                           NDArrayHandle* inputs) {
+  API_BEGIN();
+  CachedOpPtr op = *static_cast<CachedOpPtr*>(handle);
+  std::vector<NDArray*> ndinputs;
+  ndinputs.reserve(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    ndinputs.push_back(reinterpret_cast<NDArray*>(inputs[i]));
+  }
+  op->SaveCompiled(fname, Context::CPU(), ndinputs);
+  API_END();
+}
+
+int MXLoadCompiledModel(const char* fname,
+                        CachedOpHandle* out,
+                        int* num_inputs,
+                        NDArrayHandle** inputs) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  std::vector<NDArray> ndinputs;
+  CachedOpPtr op = CachedOp::LoadCompiled(fname, Context::CPU(), &ndinputs);
+  ret->ret_handles.clear();
+  ret->ret_handles.reserve(ndinputs.size());
+  for (const NDArray& input : ndinputs) {
+    ret->ret_handles.push_back(input.is_none() ? nullptr : new NDArray(input));
+  }
+  *out        = new CachedOpPtr(op);
+  *num_inputs = static_cast<int>(ndinputs.size());
+  *inputs     = dmlc::BeginPtr(ret->ret_handles);
+  API_END();
+}
+
+int MXCreateBatchingCachedOp(CachedOpHandle handle,
+                             int num_params,
+                             NDArrayHandle* params,
+                             int dev_type,
+                             int dev_id,
+                             int num_flags,
+                             const char** keys,
+                             const char** vals,
+                             BatchingCachedOpHandle* out) {
+  API_BEGIN();
+  CachedOpPtr op = *static_cast<CachedOpPtr*>(handle);
+  std::vector<NDArray> ndparams;
+  ndparams.reserve(num_params);
+  for (int i = 0; i < num_params; ++i) {
+    ndparams.push_back(*reinterpret_cast<NDArray*>(params[i]));
+  }
+  std::vector<std::pair<std::string, std::string> > flags;
+  flags.reserve(num_flags);
+  for (int i = 0; i < num_flags; ++i) {
+    flags.emplace_back(keys[i], vals[i]);
+  }
+  Context ctx = Context::Create(static_cast<Context::DeviceType>(dev_type), dev_id);
+  *out        = new BatchingCachedOp(op, ndparams, ctx, flags);
+  API_END();
+}
+
+int MXFreeBatchingCachedOp(BatchingCachedOpHandle handle) {
+  API_BEGIN();
+  delete static_cast<BatchingCachedOp*>(handle);
+  API_END();
+}
+
+int MXBatchingCachedOpSubmit(BatchingCachedOpHandle handle,
+                             int num_inputs,
+                             NDArrayHandle* inputs,
+                             BatchRequestHandle* out) {
+  API_BEGIN();
+  std::vector<NDArray> data;
+  data.reserve(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    data.push_back(*reinterpret_cast<NDArray*>(inputs[i]));
+  }
+  *out = new std::future<BatchingCachedOp::Outputs>(
+      static_cast<BatchingCachedOp*>(handle)->Submit(data));
+  API_END();
+}
+
+int MXBatchRequestWait(BatchRequestHandle handle, int* num_outputs, NDArrayHandle** outputs) {
+  MXAPIThreadLocalEntry<>* ret = MXAPIThreadLocalStore<>::Get();
+  API_BEGIN();
+  auto request = static_cast<std::future<BatchingCachedOp::Outputs>*>(handle);
+  CHECK(request->valid()) << "the outputs of the request were already taken";
+  // rethrows the error of the batch, if any
+  BatchingCachedOp::Outputs ndoutputs = request->get();
+  ret->ret_handles.clear();
+  ret->ret_handles.reserve(ndoutputs.size());
+  for (NDArray& output : ndoutputs) {
+    ret->ret_handles.push_back(new NDArray(std::move(output)));
+  }
+  *num_outputs = ndoutputs.size();
+  *outputs     = dmlc::BeginPtr(ret->ret_handles);
+  API_END();
+}
+
+int MXFreeBatchRequest(BatchRequestHandle handle) {
+  API_BEGIN();
+  delete static_cast<std::future<BatchingCachedOp::Outputs>*>(handle);
+  API_END();
+}
+
 int MXNDArrayIsDeferredCompute(int* curr) {
   API_BEGIN();
   *curr = Imperative::Get()->is_deferred_compute();
@@ -23,7 +23,9 @@
 #ifndef MXNET_COMMON_OBJECT_POOL_H_
 #define MXNET_COMMON_OBJECT_POOL_H_
 #include <dmlc/logging.h>
+#include <dmlc/thread_local.h>
 #include <cstdlib>
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -32,6 +34,11 @@ namespace mxnet {
 namespace common {
 /*!
  * \brief Object pool for fast allocation and deallocation.
+ *
+ * Each thread keeps a cache of free objects, so that most allocations and deallocations do
+ * not take the lock of the pool. Objects may be freed by another thread than the one that
+ * allocated them. The pool is never destroyed, so that objects may also be freed during
+ * static destruction.
  */
 template <typename T>
 class ObjectPool {
@@ -53,6 +60,20 @@ class ObjectPool {
    * Make sure the pointer to delete is allocated from this pool.
    */
   void Delete(T* ptr);
+  /*!
+   * \brief Allocate raw memory for an object.
+   * \return Pointer to memory of sizeof(T) bytes, aligned for T.
+   */
+  void* Allocate();
+  /*!
+   * \brief Return memory obtained from Allocate.
+   * \param ptr The memory, whose object must already be destroyed.
+   */
+  void Free(void* ptr);
+  /*!
+   * \brief Number of pages allocated by the pool.
+   */
+  std::size_t num_pages();
 
   /*!
    * \brief Get singleton instance of pool.
@@ -81,12 +102,26 @@ class ObjectPool {
     };
 #endif
   };
+  /*!
+   * \brief Free objects cached by a thread, returned to the pool when the thread exits.
+   */
+  struct ThreadCache {
+    LinkedList* head{nullptr};
+    std::size_t size{0};
+    ~ThreadCache();
+  };
   /*!
    * \brief Page size of allocation.
    *
    * Currently defined to be 4KB.
    */
   constexpr static std::size_t kPageSize = 1 << 12;
+  /*!
+   * \brief Number of objects moved at once between a thread cache and the pool.
+   *
+   * A thread cache holds fewer than twice as many.
+   */
+  constexpr static std::size_t kThreadCacheBatch = 32;
   /*! \brief internal mutex */
   std::mutex m_;
   /*!
@@ -107,6 +142,10 @@ class ObjectPool {
    * This function is not protected and must be called with caution.
    */
   void AllocateChunk();
+  /*!
+   * \brief Push the list from first to last to the free list of the pool.
+   */
+  void Release(LinkedList* first, LinkedList* last);
   DISALLOW_COPY_AND_ASSIGN(ObjectPool);
 };  // class ObjectPool
 
@@ -130,6 +169,43 @@ struct ObjectPoolAllocatable {
   static void Delete(T* ptr);
 };  // struct ObjectPoolAllocatable
 
+/*!
+ * \brief Allocator of single objects from the object pool, such as the object and reference
+ *        count block of std::allocate_shared.
+ */
+template <typename T>
+struct ObjectPoolAllocator {
+  using value_type = T;
+
+  ObjectPoolAllocator() = default;
+  template <typename U>
+  ObjectPoolAllocator(const ObjectPoolAllocator<U>&) {}  // NOLINT(runtime/explicit)
+
+  T* allocate(std::size_t n) {
+    if (n != 1) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(ObjectPool<T>::Get()->Allocate());
+  }
+  void deallocate(T* ptr, std::size_t n) {
+    if (n != 1) {
+      std::allocator<T>().deallocate(ptr, n);
+    } else {
+      ObjectPool<T>::Get()->Free(ptr);
+    }
+  }
+};  // struct ObjectPoolAllocator
+
+template <typename T, typename U>
+bool operator==(const ObjectPoolAllocator<T>&, const ObjectPoolAllocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ObjectPoolAllocator<T>&, const ObjectPoolAllocator<U>&) {
+  return false;
+}
+
 template <typename T>
 ObjectPool<T>::~ObjectPool() {
   for (auto i : allocated_) {
@@ -144,27 +220,82 @@ ObjectPool<T>::~ObjectPool() {
 template <typename T>
 template <typename... Args>
 T* ObjectPool<T>::New(Args&&... args) {
-  LinkedList* ret;
-  {
-    std::lock_guard<std::mutex> lock{m_};
-    if (head_->next == nullptr) {
-      AllocateChunk();
-    }
-    ret   = head_;
-    head_ = head_->next;
-  }
-  return new (static_cast<void*>(ret)) T(std::forward<Args>(args)...);
+  return new (Allocate()) T(std::forward<Args>(args)...);
 }
 
 template <typename T>
 void ObjectPool<T>::Delete(T* ptr) {
   ptr->~T();
-  auto linked_list_ptr = reinterpret_cast<LinkedList*>(ptr);
-  {
+  Free(ptr);
+}
+
+template <typename T>
+void* ObjectPool<T>::Allocate() {
+  ThreadCache* cache = dmlc::ThreadLocalStore<ThreadCache>::Get();
+  if (cache->head == nullptr) {
     std::lock_guard<std::mutex> lock{m_};
-    linked_list_ptr->next = head_;
-    head_                 = linked_list_ptr;
+    for (std::size_t i = 0; i < kThreadCacheBatch; ++i) {
+      if (head_->next == nullptr) {
+        AllocateChunk();
+      }
+      LinkedList* node = head_;
+      head_            = head_->next;
+      node->next       = cache->head;
+      cache->head      = node;
+    }
+    cache->size = kThreadCacheBatch;
+  }
+  LinkedList* ret = cache->head;
+  cache->head     = ret->next;
+  --cache->size;
+  return static_cast<void*>(ret);
+}
+
+template <typename T>
+void ObjectPool<T>::Free(void* ptr) {
+  ThreadCache* cache = dmlc::ThreadLocalStore<ThreadCache>::Get();
+  auto node          = static_cast<LinkedList*>(ptr);
+  node->next         = cache->head;
+  cache->head        = node;
+  if (++cache->size < 2 * kThreadCacheBatch) {
+    return;
+  }
+  // give a batch back, for the threads that allocate what this one frees
+  LinkedList* last = node;
+  for (std::size_t i = 1; i < kThreadCacheBatch; ++i) {
+    last = last->next;
   }
+  cache->head = last->next;
+  cache->size -= kThreadCacheBatch;
+  Release(node, last);
+}
+
+template <typename T>
+void ObjectPool<T>::Release(LinkedList* first, LinkedList* last) {
+  std::lock_guard<std::mutex> lock{m_};
+  last->next = head_;
+  head_      = first;
+}
+
+template <typename T>
+ObjectPool<T>::ThreadCache::~ThreadCache() {
+  if (head == nullptr) {
+    return;
+  }
+  LinkedList* last = head;
+  while (last->next != nullptr) {
+    last = last->next;
+  }
+  ObjectPool<T>::Get()->Release(head, last);
+  // objects freed by static destructors after this one are left to the pool
+  head = nullptr;
+  size = 0;
+}
+
+template <typename T>
+std::size_t ObjectPool<T>::num_pages() {
+  std::lock_guard<std::mutex> lock{m_};
+  return allocated_.size();
 }
 
 template <typename T>
@@ -174,8 +305,9 @@ ObjectPool<T>* ObjectPool<T>::Get() {
 
 template <typename T>
 std::shared_ptr<ObjectPool<T> > ObjectPool<T>::_GetSharedRef() {
-  static std::shared_ptr<ObjectPool<T> > inst_ptr(new ObjectPool<T>());
-  return inst_ptr;
+  // never destroyed, objects may be freed by static destructors and exiting threads
+  static auto* inst_ptr = new std::shared_ptr<ObjectPool<T> >(new ObjectPool<T>());
+  return *inst_ptr;
 }
 
 template <typename T>
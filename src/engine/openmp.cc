@@ -19,8 +19,11 @@
 #include <dmlc/omp.h>
 #include <dmlc/base.h>
 #include <dmlc/parameter.h>
+#include <algorithm>
 #include <climits>
+#include <thread>
 #include "./openmp.h"
+#include "./thread_team.h"
 
 namespace mxnet {
 namespace engine {
@@ -56,8 +59,18 @@ OpenMP::OpenMP() : omp_num_threads_set_in_environment_(is_env_set("OMP_NUM_THREA
     }
   }
 #else
-  enabled_        = false;
-  omp_thread_max_ = 1;
+  // without OpenMP the parallel loops run on engine::ThreadTeam, sized the same way
+  const int max = dmlc::GetEnv("MXNET_OMP_MAX_THREADS", INT_MIN);
+  if (max != INT_MIN) {
+    omp_thread_max_ = max;
+  } else if (omp_num_threads_set_in_environment_) {
+    omp_thread_max_ = dmlc::GetEnv("OMP_NUM_THREADS", 1);
+  } else {
+    omp_thread_max_ = std::max<int>(std::thread::hardware_concurrency(), 1);
+#ifdef ARCH_IS_INTEL_X86
+    omp_thread_max_ = std::max(omp_thread_max_ >> 1, 1);
+#endif
+  }
 #endif
 }
 
@@ -72,6 +85,8 @@ void OpenMP::on_start_worker_thread(bool use_omp) {
   if (!omp_num_threads_set_in_environment_) {
     omp_set_num_threads(use_omp ? GetRecommendedOMPThreadCount(true) : 1);
   }
+#else
+  ThreadTeam::SetThreadLimit(use_omp ? GetRecommendedOMPThreadCount(true) : 1);
 #endif
 }
 
@@ -111,7 +126,14 @@ int OpenMP::GetRecommendedOMPThreadCount(bool exclude_reserved) const {
     return 1;
   }
 #else
-  return 1;
+  if (!enabled_) {
+    return 1;
+  }
+  int thread_count = omp_thread_max_;
+  if (exclude_reserved) {
+    thread_count -= reserve_cores_;
+  }
+  return std::max(thread_count, 1);
 #endif
 }
 
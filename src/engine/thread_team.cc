@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file thread_team.cc
+ * \brief Persistent team of threads running the parallel loops of builds without OpenMP
+ */
+#include "./thread_team.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mxnet {
+namespace engine {
+
+namespace {
+
+/*! \brief iterations a thread spins on a flag before blocking */
+constexpr int kSpinCount = 1 << 15;
+/*! \brief the spinning thread yields its core every kYieldPeriod iterations, for when the
+ *         threads outnumber the cores */
+constexpr int kYieldPeriod = 64;
+
+thread_local int thread_limit = 0;
+thread_local bool in_parallel = false;
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/*! \brief Spin until pred() holds, giving up after kSpinCount iterations */
+template <typename Pred>
+inline bool SpinUntil(Pred pred) {
+  for (int i = 0; i < kSpinCount; ++i) {
+    if (pred()) {
+      return true;
+    }
+    if (i % kYieldPeriod == kYieldPeriod - 1) {
+      std::this_thread::yield();
+    } else {
+      CpuRelax();
+    }
+  }
+  return pred();
+}
+
+}  // namespace
+
+ThreadTeam* ThreadTeam::Get() {
+  // never destroyed: the workers block forever once the process stops starting regions
+  static ThreadTeam* team = new ThreadTeam();
+  return team;
+}
+
+void ThreadTeam::SetThreadLimit(int nthreads) {
+  thread_limit = std::max(nthreads, 0);
+}
+
+bool ThreadTeam::InParallel() {
+  return in_parallel;
+}
+
+void ThreadTeam::RunTask(int nthreads, TaskFn fn, void* ctx) {
+  if (thread_limit > 0) {
+    nthreads = std::min(nthreads, thread_limit);
+  }
+  if (nthreads < 2 || in_parallel || !busy_.try_lock()) {
+    const bool outer = in_parallel;
+    in_parallel      = true;
+    fn(ctx, 0, 1);
+    in_parallel = outer;
+    return;
+  }
+  std::unique_lock<std::mutex> region(busy_, std::adopt_lock);
+  EnsureWorkers(nthreads - 1);
+  task_fn_      = fn;
+  task_ctx_     = ctx;
+  task_threads_ = nthreads;
+  pending_.store(nthreads - 1);
+  ++region_;
+  for (int tid = 1; tid < nthreads; ++tid) {
+    workers_[tid - 1]->region.store(region_);
+  }
+  if (sleeping_.load() > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_all();
+  }
+
+  in_parallel = true;
+  fn(ctx, 0, nthreads);
+  in_parallel = false;
+
+  if (!SpinUntil([this]() { return pending_.load() == 0; })) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++sleeping_;
+    done_.wait(lock, [this]() { return pending_.load() == 0; });
+    --sleeping_;
+  }
+}
+
+void ThreadTeam::EnsureWorkers(int nworkers) {
+  while (static_cast<int>(workers_.size()) < nworkers) {
+    workers_.emplace_back(new Worker());
+    Worker* worker = workers_.back().get();
+    worker->region.store(region_);
+    worker->thread =
+        std::thread(&ThreadTeam::WorkerLoop, this, worker, workers_.size(), region_);
+    worker->thread.detach();
+  }
+}
+
+void ThreadTeam::WorkerLoop(Worker* worker, int tid, uint64_t seen) {
+  // a worker never forks a region of its own
+  in_parallel = true;
+  while (true) {
+    auto ready = [worker, seen]() { return worker->region.load() != seen; };
+    if (!SpinUntil(ready)) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++sleeping_;
+      wake_.wait(lock, ready);
+      --sleeping_;
+    }
+    seen = worker->region.load();
+    task_fn_(task_ctx_, tid, task_threads_);
+    if (pending_.fetch_sub(1) == 1 && sleeping_.load() > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_all();
+    }
+  }
+}
+
+}  // namespace engine
+}  // namespace mxnet
@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file thread_team.h
+ * \brief Persistent team of threads running the parallel loops of builds without OpenMP
+ */
+#ifndef MXNET_ENGINE_THREAD_TEAM_H_
+#define MXNET_ENGINE_THREAD_TEAM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mxnet {
+namespace engine {
+
+/*!
+ * \brief Shared team of worker threads forked and joined by parallel regions.
+ *
+ *        The workers are started on first use and kept alive. They spin for a short while
+ *        after a region before blocking, so back-to-back regions cost a few atomic operations
+ *        rather than a thread wake-up each.
+ *
+ *        One region runs at a time. A region started while the team is busy (by another
+ *        engine worker) or from inside a region (nested parallelism) runs serially on the
+ *        calling thread instead of oversubscribing the cores.
+ *
+ *        The task of a region must not throw.
+ */
+class ThreadTeam {
+ public:
+  static ThreadTeam* Get();
+
+  /*!
+   * \brief Cap the number of threads of the regions started by the calling thread,
+   *        the counterpart of omp_set_num_threads()
+   * \param nthreads Maximum number of threads, 0 for no cap
+   */
+  static void SetThreadLimit(int nthreads);
+  /*! \brief Whether the calling thread runs the task of a region */
+  static bool InParallel();
+
+  /*!
+   * \brief Run f(tid, nthreads) on nthreads threads, tid in [0, nthreads), the calling thread
+   *        being thread 0. Fewer threads than requested may run, down to the calling thread
+   *        alone, and the second argument of f tells how many do.
+   */
+  template <typename F>
+  void Run(int nthreads, F&& f) {
+    using Fn = typename std::remove_reference<F>::type;
+    RunTask(nthreads,
+            [](void* ctx, int tid, int n) { (*static_cast<Fn*>(ctx))(tid, n); },
+            const_cast<void*>(static_cast<const void*>(&f)));
+  }
+
+  /*! \brief Run f(begin, end) over [0, n) split into one contiguous range per thread */
+  template <typename F>
+  void ParallelFor(size_t n, int nthreads, F&& f) {
+    if (n == 0) {
+      return;
+    }
+    Run(static_cast<int>(std::min<size_t>(n, std::max(nthreads, 1))), [&](int tid, int nt) {
+      const size_t chunk = (n + nt - 1) / nt;
+      const size_t begin = chunk * tid;
+      if (begin < n) {
+        f(begin, std::min(n, begin + chunk));
+      }
+    });
+  }
+
+  /*! \brief Run f(begin, end) over [0, n) split into ranges of grain handed out on demand */
+  template <typename F>
+  void ParallelForDynamic(size_t n, int nthreads, size_t grain, F&& f) {
+    if (n == 0) {
+      return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    std::atomic<size_t> next(0);
+    const size_t nchunks = (n + grain - 1) / grain;
+    Run(static_cast<int>(std::min<size_t>(nchunks, std::max(nthreads, 1))), [&](int, int) {
+      for (size_t begin = next.fetch_add(grain); begin < n; begin = next.fetch_add(grain)) {
+        f(begin, std::min(n, begin + grain));
+      }
+    });
+  }
+
+ private:
+  using TaskFn = void (*)(void* ctx, int tid, int nthreads);
+  /*! \brief Worker slot, on its own cache line */
+  struct alignas(64) Worker {
+    /*! \brief number of the last region the worker is asked to join */
+    std::atomic<uint64_t> region{0};
+    std::thread thread;
+  };
+
+  ThreadTeam() = default;
+  void RunTask(int nthreads, TaskFn fn, void* ctx);
+  /*! \brief Start workers until there are at least nworkers of them */
+  void EnsureWorkers(int nworkers);
+  /*! \brief Run the regions after region number seen that the worker is asked to join */
+  void WorkerLoop(Worker* worker, int tid, uint64_t seen);
+
+  /*! \brief held by the thread running a region */
+  std::mutex busy_;
+  std::vector<std::unique_ptr<Worker> > workers_;
+  /*! \brief task of the current region, published by Worker::region */
+  TaskFn task_fn_   = nullptr;
+  void* task_ctx_   = nullptr;
+  int task_threads_ = 0;
+  uint64_t region_  = 0;
+  /*! \brief number of workers that did not finish the current region */
+  std::atomic<int> pending_{0};
+  /*! \brief number of threads blocked on wake_ or done_ */
+  std::atomic<int> sleeping_{0};
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+};
+
+}  // namespace engine
+}  // namespace mxnet
+
+#endif  // MXNET_ENGINE_THREAD_TEAM_H_
@@ -300,6 +300,7 @@ void ThreadedEngine::Push(OprHandle op, Context exec_ctx, int priority, bool pro
   opr_block->ctx       = exec_ctx;
   opr_block->priority  = priority;
   opr_block->profiling = profiling;
+  opr_block->lane      = execution_lane_;
   ++pending_;
   // Add read dependencies.
   for (auto&& i : threaded_opr->const_vars) {
@@ -534,5 +535,7 @@ void ThreadedEngine::OnCompleteStatic(Engine* engine, void* opr_block_, const dm
   OprBlock::Delete(opr_block);
 }
 
+MX_THREAD_LOCAL int ThreadedEngine::execution_lane_ = 0;
+
 }  // namespace engine
 }  // namespace mxnet
@@ -87,6 +87,10 @@ struct OprBlock : public common::ObjectPoolAllocatable<OprBlock> {
   bool profiling{false};
   /*! \brief operator execution statistics */
   std::unique_ptr<profiler::ProfileOperator> opr_profile;
+  /*! \brief execution lane of the pushing thread */
+  int lane{0};
+  /*! \brief time the operator was queued on its lane, when profiling */
+  uint64_t lane_enqueue_time{0};
   // define possible debug information
   DEFINE_ENGINE_DEBUG_INFO(OprBlock);
   /*!
@@ -430,6 +434,17 @@ class ThreadedEngine : public Engine {
     return bulk_size;
   }
 
+  int execution_lane() const override {
+    return execution_lane_;
+  }
+
+  int set_execution_lane(int lane) override {
+    // operators already bulked are pushed on the lane they were issued in
+    BulkFlush();
+    std::swap(execution_lane_, lane);
+    return lane;
+  }
+
  private:
   /*! \brief structure for holding bulk execution status */
   struct BulkStatus {
@@ -448,6 +463,8 @@ class ThreadedEngine : public Engine {
   };
   /*! thread local store for bulk */
   typedef dmlc::ThreadLocalStore<BulkStatus> BulkStatusStore;
+  /*! \brief execution lane of the operators pushed by this thread */
+  static MX_THREAD_LOCAL int execution_lane_;
 
   /*!
    * \brief check if thee is duplication in const_vars and mutable_vars.
@@ -29,7 +29,12 @@
 #include <dmlc/concurrency.h>
 #include <dmlc/thread_group.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include "../initialize.h"
 #include "./threaded_engine.h"
 #include "./thread_pool.h"
@@ -45,6 +50,8 @@ namespace engine {
  *  - Use fixed amount of threads for each device.
  *  - Use special threads for copy operations.
  *  - Each stream is allocated and bound to each of the thread.
+ *  - CPU operators pushed from a thread that selected an execution lane run on the
+ *    workers of that lane.
  */
 class ThreadedEnginePerDevice : public ThreadedEngine {
  public:
@@ -54,7 +61,19 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
   static auto constexpr kPriorityQueue = kPriority;
   static auto constexpr kWorkerQueue   = kFIFO;
 
+  /*! \brief maximum number of execution lanes, the shared lane 0 included */
+  static constexpr int kMaxExecutionLanes = 64;
+
   ThreadedEnginePerDevice() noexcept(false) {
+    // MXNET_CPU_EXECUTION_LANES, as name:num_threads,...
+    std::istringstream lanes(dmlc::GetEnv("MXNET_CPU_EXECUTION_LANES", std::string()));
+    std::string lane;
+    while (std::getline(lanes, lane, ',')) {
+      const size_t colon = lane.rfind(':');
+      CHECK(colon != std::string::npos && colon > 0)
+          << "MXNET_CPU_EXECUTION_LANES expects name:num_threads, got " << lane;
+      CreateExecutionLane(lane.substr(0, colon), std::stoi(lane.substr(colon + 1)));
+    }
     this->Start();
   }
   ~ThreadedEnginePerDevice() noexcept(false) override {
@@ -68,6 +87,9 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     gpu_copy_workers_.Clear();
     cpu_normal_workers_.Clear();
     cpu_priority_worker_.reset(nullptr);
+    for (int i = 1; i < num_lanes_.load(); ++i) {
+      lanes_[i]->workers.Clear();
+    }
   }
 
   void Stop() override {
@@ -96,6 +118,32 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     // GPU tasks will be created lazily
   }
 
+  int CreateExecutionLane(const std::string& name, int num_threads) override {
+    CHECK(!name.empty()) << "An execution lane needs a name";
+    CHECK_GT(num_threads, 0) << "Execution lane " << name << " needs at least one thread";
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    const int existing = FindExecutionLane(name);
+    if (existing >= 0)
+      return existing;
+    const int id = num_lanes_.load();
+    CHECK_LT(id, kMaxExecutionLanes)
+        << "At most " << kMaxExecutionLanes - 1 << " execution lanes can be created";
+    lanes_[id] = std::make_unique<ExecutionLane>(name, num_threads, &lane_domain_);
+    // the lane is complete before its id is visible
+    num_lanes_.store(id + 1);
+    return id;
+  }
+
+  int GetExecutionLane(const std::string& name) override {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    return FindExecutionLane(name);
+  }
+
+  int set_execution_lane(int lane) override {
+    CHECK(lane >= 0 && lane < num_lanes_.load()) << "Unknown execution lane " << lane;
+    return ThreadedEngine::set_execution_lane(lane);
+  }
+
  protected:
   void PushToExecute(OprBlock* opr_block, bool pusher_thread) override {
     const Context& ctx = opr_block->ctx;
@@ -113,6 +161,8 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
         // CPU execution.
         if (opr_block->opr->prop == FnProperty::kCPUPrioritized) {
           cpu_priority_worker_->task_queue.Push(opr_block, opr_block->priority);
+        } else if (opr_block->lane > 0 && opr_block->lane < num_lanes_.load()) {
+          PushToLane(lanes_[opr_block->lane].get(), opr_block);
         } else {
           int dev_id  = ctx.dev_id;
           int nthread = cpu_worker_nthreads_;
@@ -220,6 +270,31 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     ~ThreadWorkerBlock() = default;
   };
 
+  /*! \brief a named set of CPU workers per device, with their own queues */
+  struct ExecutionLane {
+    ExecutionLane(const std::string& name, size_t nthreads, profiler::ProfileDomain* domain)
+        : name(name),
+          nthreads(nthreads),
+          queue_depth(("Lane " + name + ": queue depth").c_str(), domain),
+          queue_time(("Lane " + name + ": queue time (us)").c_str(), domain) {}
+    /*! \brief called by a worker of the lane when it starts an operator */
+    void OnStart(const OprBlock* opr_block) {
+      const int64_t queued = --depth;
+      if (opr_block->lane_enqueue_time != 0) {
+        queue_depth = queued;
+        queue_time  = profiler::ProfileStat::NowInMicrosec() - opr_block->lane_enqueue_time;
+      }
+    }
+    std::string name;
+    size_t nthreads;
+    common::LazyAllocArray<ThreadWorkerBlock<kWorkerQueue>> workers;
+    // operators queued on the lane and not started yet
+    std::atomic<int64_t> depth{0};
+    // depth, and the time the last started operator was queued, recorded while profiling
+    profiler::ProfileCounter queue_depth;
+    profiler::ProfileCounter queue_time;
+  };
+
   /*! \brief whether this is a worker thread. */
   static MX_THREAD_LOCAL bool is_worker_;
   /*! \brief number of concurrent thread cpu worker uses */
@@ -238,6 +313,12 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
   common::LazyAllocArray<ThreadWorkerBlock<kCopyQueue>> gpu_copy_workers_;
   // gpu priority workers
   common::LazyAllocArray<ThreadWorkerBlock<kPriorityQueue>> gpu_priority_workers_;
+  // profiler domain of the lane counters
+  profiler::ProfileDomain lane_domain_{"Execution Lanes"};
+  // execution lanes, lane 0 is the cpu normal workers
+  std::array<std::unique_ptr<ExecutionLane>, kMaxExecutionLanes> lanes_;
+  std::atomic<int> num_lanes_{1};
+  std::mutex lanes_mutex_;
   /*!
    * \brief GPU worker that performs operations on a certain device.
    * \param dev_id The device id of the worker.
@@ -284,11 +365,13 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
   /*!
    * \brief CPU worker that performs operations on CPU.
    * \param block The task block of the worker.
+   * \param lane The execution lane of the worker, if any.
    */
   template <dmlc::ConcurrentQueueType type>
   inline void CPUWorker(Context ctx,
                         ThreadWorkerBlock<type>* block,
-                        const std::shared_ptr<dmlc::ManualEvent>& ready_event) {
+                        const std::shared_ptr<dmlc::ManualEvent>& ready_event,
+                        ExecutionLane* lane = nullptr) {
     this->is_worker_ = true;
     auto* task_queue = &(block->task_queue);
     RunContext run_ctx{ctx, nullptr, nullptr, false};
@@ -301,10 +384,52 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     OpenMP::Get()->on_start_worker_thread(true);
 
     while (task_queue->Pop(&opr_block)) {
+      if (lane != nullptr)
+        lane->OnStart(opr_block);
       this->ExecuteOprBlock(run_ctx, opr_block);
     }
   }
 
+  /*! \brief queue a CPU operator on the workers of its execution lane */
+  void PushToLane(ExecutionLane* lane, OprBlock* opr_block) {
+    const Context ctx    = opr_block->ctx;
+    const size_t nthread = lane->nthreads;
+    auto ptr             = lane->workers.Get(ctx.dev_id, [this, ctx, lane, nthread]() {
+      auto blk  = new ThreadWorkerBlock<kWorkerQueue>();
+      blk->pool = std::make_unique<ThreadPool>(
+          nthread,
+          [this, ctx, lane, blk](std::shared_ptr<dmlc::ManualEvent> ready_event) {
+            this->CPUWorker(ctx, blk, ready_event, lane);
+          },
+          true);
+      return blk;
+    });
+    if (ptr) {
+      const bool profiling =
+          profiler::Profiler::Get()->GetState() == profiler::Profiler::kRunning;
+      opr_block->lane_enqueue_time = profiling ? profiler::ProfileStat::NowInMicrosec() : 0;
+      const int64_t queued         = ++lane->depth;
+      if (profiling)
+        lane->queue_depth = queued;
+      if (opr_block->opr->prop == FnProperty::kDeleteVar) {
+        ptr->task_queue.PushFront(opr_block, opr_block->priority);
+      } else {
+        ptr->task_queue.Push(opr_block, opr_block->priority);
+      }
+    }
+  }
+
+  /*! \brief id of the lane named name, -1 if there is none. Requires lanes_mutex_ */
+  int FindExecutionLane(const std::string& name) const {
+    if (name.empty())
+      return 0;
+    for (int i = 1; i < num_lanes_.load(); ++i) {
+      if (lanes_[i]->name == name)
+        return i;
+    }
+    return -1;
+  }
+
   /*!
    * \brief Get number of cores this engine should reserve for its own use
    * \param using_gpu Whether there is GPU usage
@@ -338,6 +463,9 @@ class ThreadedEnginePerDevice : public ThreadedEngine {
     SignalQueueForKill(&gpu_normal_workers_);
     SignalQueueForKill(&gpu_copy_workers_);
     SignalQueueForKill(&cpu_normal_workers_);
+    for (int i = 1; i < num_lanes_.load(); ++i) {
+      SignalQueueForKill(&lanes_[i]->workers);
+    }
     if (cpu_priority_worker_) {
       cpu_priority_worker_->task_queue.SignalForKill();
     }
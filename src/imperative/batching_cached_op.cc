@@ -0,0 +1,215 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <algorithm>
+#include <exception>
+#include "./batching_cached_op.h"
+
+namespace mxnet {
+
+DMLC_REGISTER_PARAMETER(BatchingCachedOpConfig);
+
+BatchingCachedOp::BatchingCachedOp(const CachedOpPtr& op,
+                                   const std::vector<NDArray>& params,
+                                   const Context& ctx,
+                                   const std::vector<std::pair<std::string, std::string>>& flags)
+    : op_(op), ctx_(ctx) {
+  config_.Init(flags);
+  CHECK_GT(config_.data_indices.ndim(), 0) << "BatchingCachedOp requires at least one data input";
+  CHECK_EQ(config_.data_indices.ndim() + params.size(), op_->num_inputs())
+      << "BatchingCachedOp expects " << op_->num_inputs() - config_.data_indices.ndim()
+      << " parameters, but " << params.size() << " were given";
+  inputs_.resize(op_->num_inputs());
+  std::vector<bool> is_data(inputs_.size(), false);
+  for (const uint32_t i : config_.data_indices) {
+    CHECK_LT(i, inputs_.size()) << "data index " << i << " is out of range";
+    is_data[i] = true;
+  }
+  auto param = params.begin();
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (!is_data[i])
+      inputs_[i] = *param++;
+  }
+
+  if (config_.batch_buckets.ndim() > 0) {
+    buckets_.assign(config_.batch_buckets.begin(), config_.batch_buckets.end());
+    CHECK(std::is_sorted(buckets_.begin(), buckets_.end()))
+        << "batch_buckets must be increasing";
+  } else {
+    for (uint32_t size = 1; size < config_.max_batch_size; size *= 2) {
+      buckets_.push_back(size);
+    }
+    buckets_.push_back(config_.max_batch_size);
+  }
+  dispatcher_ = std::thread([this]() { DispatchLoop(); });
+}
+
+BatchingCachedOp::~BatchingCachedOp() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  dispatcher_.join();
+}
+
+std::future<BatchingCachedOp::Outputs> BatchingCachedOp::Submit(
+    const std::vector<NDArray>& data) {
+  CHECK_EQ(data.size(), config_.data_indices.ndim())
+      << "BatchingCachedOp expects " << config_.data_indices.ndim() << " inputs per request";
+  Request request;
+  request.batch_size = data[0].shape().ndim() > 0 ? data[0].shape()[0] : 0;
+  for (const NDArray& input : data) {
+    CHECK_EQ(input.storage_type(), kDefaultStorage) << "requests must be dense";
+    CHECK(input.shape().ndim() > 0 && input.shape()[0] == request.batch_size)
+        << "all the inputs of a request must have the same first dimension";
+  }
+  CHECK_GT(request.batch_size, 0) << "a request must have at least one sample";
+  CHECK_LE(request.batch_size, config_.max_batch_size)
+      << "a request must have at most max_batch_size samples";
+  request.data    = data;
+  request.arrival = std::chrono::steady_clock::now();
+  std::future<Outputs> ret = request.promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(!stop_) << "BatchingCachedOp is being destroyed";
+    queued_samples_ += request.batch_size;
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return ret;
+}
+
+void BatchingCachedOp::DispatchLoop() {
+  const auto max_delay = std::chrono::microseconds(config_.max_delay_us);
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty())
+      return;
+    // wait for a full batch, at most until the oldest request has waited max_delay_us
+    const auto deadline = queue_.front().arrival + max_delay;
+    cv_.wait_until(lock, deadline, [this]() {
+      return stop_ || queued_samples_ >= static_cast<index_t>(config_.max_batch_size);
+    });
+    std::vector<Request> batch = TakeBatch();
+    lock.unlock();
+    RunBatch(&batch);
+    lock.lock();
+  }
+}
+
+/*! \brief whether two requests can be concatenated along the first axis */
+static bool Batchable(const std::vector<NDArray>& a, const std::vector<NDArray>& b) {
+  for (size_t i = 0; i < a.size(); ++i) {
+    const mxnet::TShape& sa = a[i].shape();
+    const mxnet::TShape& sb = b[i].shape();
+    if (a[i].dtype() != b[i].dtype() || sa.ndim() != sb.ndim())
+      return false;
+    for (int j = 1; j < sa.ndim(); ++j) {
+      if (sa[j] != sb[j])
+        return false;
+    }
+  }
+  return true;
+}
+
+std::vector<BatchingCachedOp::Request> BatchingCachedOp::TakeBatch() {
+  std::vector<Request> batch;
+  index_t batch_size = 0;
+  for (auto it = queue_.begin(); it != queue_.end();) {
+    if (batch_size + it->batch_size <= config_.max_batch_size &&
+        (batch.empty() || Batchable(batch[0].data, it->data))) {
+      batch_size += it->batch_size;
+      batch.push_back(std::move(*it));
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+    if (batch_size == config_.max_batch_size)
+      break;
+  }
+  queued_samples_ -= batch_size;
+  return batch;
+}
+
+index_t BatchingCachedOp::PaddedSize(index_t batch_size) const {
+  auto bucket = std::lower_bound(buckets_.begin(), buckets_.end(), batch_size);
+  return bucket == buckets_.end() ? batch_size : *bucket;
+}
+
+void BatchingCachedOp::RunBatch(std::vector<Request>* batch) {
+  index_t batch_size = 0;
+  for (const Request& request : *batch) {
+    batch_size += request.batch_size;
+  }
+  const index_t padded = PaddedSize(batch_size);
+  try {
+    std::vector<NDArray> inputs = inputs_;
+    for (size_t j = 0; j < config_.data_indices.ndim(); ++j) {
+      const NDArray& first = (*batch)[0].data[j];
+      mxnet::TShape shape  = first.shape();
+      shape[0]             = padded;
+      NDArray batched(shape, ctx_, false, first.dtype());
+      index_t offset = 0;
+      for (const Request& request : *batch) {
+        CopyFromTo(request.data[j], batched.Slice(offset, offset + request.batch_size));
+        offset += request.batch_size;
+      }
+      if (padded > batch_size) {
+        NDArray padding = batched.Slice(batch_size, padded);
+        padding         = 0;
+      }
+      inputs[config_.data_indices[j]] = batched;
+    }
+    std::vector<NDArray> outputs(op_->num_outputs());
+    std::vector<NDArray*> input_ptrs, output_ptrs;
+    for (auto& input : inputs) {
+      input_ptrs.push_back(&input);
+    }
+    for (auto& output : outputs) {
+      output_ptrs.push_back(&output);
+    }
+    op_->Forward(op_, input_ptrs, output_ptrs, ctx_);
+    for (const NDArray& output : outputs) {
+      CHECK(output.shape().ndim() > 0 && output.shape()[0] == padded)
+          << "BatchingCachedOp requires every output to be batched along the first axis";
+    }
+    // the outputs are still being computed, the requests wait on their slices
+    index_t offset = 0;
+    for (Request& request : *batch) {
+      Outputs slices;
+      for (const NDArray& output : outputs) {
+        slices.push_back(output.Slice(offset, offset + request.batch_size));
+      }
+      offset += request.batch_size;
+      request.promise.set_value(std::move(slices));
+    }
+  } catch (...) {
+    for (Request& request : *batch) {
+      try {
+        request.promise.set_exception(std::current_exception());
+      } catch (const std::future_error&) {
+        // the request already has its outputs
+      }
+    }
+  }
+}
+
+}  // namespace mxnet
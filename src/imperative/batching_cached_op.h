@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Dynamic batching of concurrent inference requests on top of a CachedOp
+#ifndef MXNET_IMPERATIVE_BATCHING_CACHED_OP_H_
+#define MXNET_IMPERATIVE_BATCHING_CACHED_OP_H_
+
+#include <mxnet/ndarray.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "./cached_op.h"
+
+namespace mxnet {
+/*! \brief BatchingCachedOp Parameters */
+struct BatchingCachedOpConfig : public dmlc::Parameter<BatchingCachedOpConfig> {
+  // positions of the inputs that every request supplies, batched along the first axis
+  mxnet::Tuple<uint32_t> data_indices;
+  uint32_t max_batch_size;
+  uint32_t max_delay_us;
+  // batch sizes the batches are padded to
+  mxnet::Tuple<uint32_t> batch_buckets;
+  DMLC_DECLARE_PARAMETER(BatchingCachedOpConfig) {
+    DMLC_DECLARE_FIELD(data_indices)
+        .set_default(mxnet::Tuple<uint32_t>({0}))
+        .describe("Position of the inputs supplied by each request.");
+    DMLC_DECLARE_FIELD(max_batch_size)
+        .set_default(32)
+        .set_lower_bound(1)
+        .describe("Maximum number of samples run in one forward.");
+    DMLC_DECLARE_FIELD(max_delay_us)
+        .set_default(1000)
+        .describe(
+            "Longest time in microseconds a request waits for others to fill its batch "
+            "before the batch runs anyway.");
+    DMLC_DECLARE_FIELD(batch_buckets)
+        .set_default(mxnet::Tuple<uint32_t>())
+        .describe(
+            "Increasing batch sizes a batch is padded to, so that the op sees few distinct "
+            "shapes. Empty uses the powers of 2 up to max_batch_size, and max_batch_size.");
+  }
+};
+
+/*!
+ * \brief Queues the requests of concurrent callers and runs them in batches: a dispatcher
+ *        thread concatenates compatible requests along the first axis until max_batch_size
+ *        samples are queued or the oldest request has waited max_delay_us, pads the batch to a
+ *        bucket, runs one forward of the CachedOp, and hands every request the slices of the
+ *        outputs that belong to it.
+ */
+class BatchingCachedOp {
+ public:
+  using Outputs = std::vector<NDArray>;
+
+  /*!
+   * \param op the model. It is only run from the dispatcher thread
+   * \param params the values of the inputs not in data_indices, in the order of the inputs
+   * \param ctx the context the batches are run on
+   * \param flags the BatchingCachedOpConfig
+   */
+  BatchingCachedOp(const CachedOpPtr& op,
+                   const std::vector<NDArray>& params,
+                   const Context& ctx,
+                   const std::vector<std::pair<std::string, std::string>>& flags);
+  /*! \brief runs the queued requests, then stops the dispatcher */
+  ~BatchingCachedOp();
+  /*!
+   * \brief queues a request
+   * \param data the inputs in data_indices, with the same first dimension, the number of
+   *        samples of the request. They are read when the batch runs, so they must not be
+   *        written until the outputs are ready
+   * \return the outputs of the request, which are views of the outputs of its batch
+   */
+  std::future<Outputs> Submit(const std::vector<NDArray>& data);
+
+ private:
+  struct Request {
+    std::vector<NDArray> data;
+    index_t batch_size;
+    std::promise<Outputs> promise;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  void DispatchLoop();
+  /*! \brief moves the oldest request and the queued requests it can be batched with */
+  std::vector<Request> TakeBatch();
+  void RunBatch(std::vector<Request>* batch);
+  index_t PaddedSize(index_t batch_size) const;
+
+  BatchingCachedOpConfig config_;
+  CachedOpPtr op_;
+  Context ctx_;
+  // the inputs of the op, with the data inputs left empty
+  std::vector<NDArray> inputs_;
+  std::vector<uint32_t> buckets_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  // samples in queue_
+  index_t queued_samples_ = 0;
+  bool stop_              = false;
+  std::thread dispatcher_;
+};
+
+}  // namespace mxnet
+#endif  // MXNET_IMPERATIVE_BATCHING_CACHED_OP_H_
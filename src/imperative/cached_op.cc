@@ -16,7 +16,9 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <unordered_set>
 #include <iostream>
 #include "./imperative_utils.h"
@@ -48,6 +50,18 @@ CachedOp::CachedOp(const nnvm::Symbol& sym,
   if (config_.static_shape) {
     CHECK(config_.static_alloc) << "static_alloc must be True when static_shape is True";
   }
+  if (config_.shape_cache_size > 0 || config_.bucket_axis >= 0) {
+    CHECK(config_.static_alloc)
+        << "static_alloc must be True when shape_cache_size or bucket_axis is set";
+  }
+  for (const int bucket : config_.shape_buckets) {
+    CHECK(buckets_.empty() || bucket > buckets_.back()) << "shape_buckets must be increasing";
+    buckets_.push_back(bucket);
+  }
+  if (!config_.execution_lane.empty()) {
+    execution_lane_ = Engine::Get()->GetExecutionLane(config_.execution_lane);
+    CHECK_GE(execution_lane_, 0) << "Unknown execution lane " << config_.execution_lane;
+  }
 
   auto grad_graph = nnvm::Graph();
   std::unordered_map<uint32_t, uint32_t> fwd_input_to_grad_output;
@@ -65,6 +79,12 @@ CachedOp::CachedOp(const nnvm::Symbol& sym,
                 (idx.num_nodes() - idx.input_nodes().size()) <= config_.inline_limit;
   }
 
+  if (config_.exit_output >= 0) {
+    CHECK(config_.static_alloc) << "static_alloc must be True when exit_output is set";
+    CHECK_LT(static_cast<uint32_t>(config_.exit_output), num_outputs())
+        << "exit_output must be an output";
+  }
+
   SetInputIndices(fwd_graph_, config_.param_indices, &config_.data_indices);
 
   // Set the backward dependency vectors
@@ -381,6 +401,78 @@ OpStatePtr CachedOp::GetCachedOpState(const Context& ctx) {
   return state_ptr;
 }
 
+OpStatePtr CachedOp::GetShapeCachedState(const Context& ctx,
+                                         const std::vector<NDArray*>& inputs) {
+  mxnet::ShapeVector shapes(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    shapes[i] = inputs[i]->shape();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& states = cached_op_states_[ctx];
+  // a state in use by another forward is skipped
+  auto hit = std::find_if(states.begin(), states.end(), [&shapes](const OpStatePtr& state) {
+    return state.unique() && state.get_state<CachedOpState>().cached_shapes == shapes;
+  });
+  if (hit != states.end()) {
+    ++shape_cache_hits_;
+    ++hit->get_state<CachedOpState>().cache_hits;
+    std::rotate(states.begin(), hit, hit + 1);
+    return states.front();
+  }
+  ++shape_cache_misses_;
+  OpStatePtr state_ptr;
+  auto lru = std::find_if(
+      states.rbegin(), states.rend(), [](const OpStatePtr& state) { return state.unique(); });
+  if (states.size() >= config_.shape_cache_size && lru != states.rend()) {
+    // evict: the state is planned again for the new shapes, reusing its memory
+    state_ptr = *lru;
+    states.erase(std::next(lru).base());
+  } else {
+    state_ptr = OpStatePtr::Create<CachedOpState>(ctx, fwd_graph_, full_graph_, inlining_);
+  }
+  auto& state         = state_ptr.get_state<CachedOpState>();
+  state.cached_shapes = std::move(shapes);
+  state.cache_hits    = 0;
+  states.insert(states.begin(), state_ptr);
+  // states created while the others were in use are dropped once free
+  auto it = states.end();
+  while (states.size() > config_.shape_cache_size && --it != states.begin()) {
+    if (it->unique())
+      it = states.erase(it);
+  }
+  return state_ptr;
+}
+
+std::string CachedOp::ShapeCacheStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  os << "{\"hits\": " << shape_cache_hits_ << ", \"misses\": " << shape_cache_misses_
+     << ", \"buckets\": [";
+  bool first = true;
+  for (const auto& ctx_states : cached_op_states_) {
+    for (const OpStatePtr& state_ptr : ctx_states.second) {
+      auto& state = state_ptr.get_state<CachedOpState>();
+      std::lock_guard<std::mutex> state_lock(state.mutex);
+      if (!state.fwd_alloc)
+        continue;
+      size_t bytes = 0;
+      for (const auto& chunk : state.fwd_reuse_pool) {
+        bytes += chunk.first;
+      }
+      os << (first ? "" : ", ") << "{\"context\": \"" << ctx_states.first
+         << "\", \"shapes\": [";
+      for (size_t i = 0; i < state.cached_shapes.size(); ++i) {
+        // TShape prints as a JSON array
+        os << (i ? ", " : "") << state.cached_shapes[i];
+      }
+      os << "], \"hits\": " << state.cache_hits << ", \"bytes\": " << bytes << "}";
+      first = false;
+    }
+  }
+  os << "]}";
+  return os.str();
+}
+
 void CachedOp::StaticAllocMemory(const OpStatePtr& state_ptr, bool recording, bool keep_fwd) {
   using namespace nnvm;
   using namespace imperative;
@@ -515,14 +607,26 @@ void CachedOp::StaticInitExec(const OpStatePtr& state_ptr, bool recording, bool
         bulk_size = 0;
     }
 
+    // the operators after the exit output are segments of their own, which the forward skips
+    const size_t exit_nid = keep_fwd ? end_nid : ExitNodeEnd(idx, recording);
     CreateEngineOpSeg(idx,
                       default_ctx,
                       start_nid,
-                      end_nid,
+                      exit_nid,
                       bulk_size,
                       state.execs,
                       skip_plus_node,
                       &state.opr_segs);
+    if (exit_nid < end_nid) {
+      CreateEngineOpSeg(idx,
+                        default_ctx,
+                        exit_nid,
+                        end_nid,
+                        bulk_size,
+                        state.execs,
+                        skip_plus_node,
+                        &state.opr_segs);
+    }
   }
 
   if (keep_fwd) {
@@ -662,14 +766,35 @@ static void PrepareOutputs(const nnvm::Graph& g,
   }
 }
 
+/*! \brief whether the exit output of the forward is non-zero, once it is computed */
+static bool ExitTaken(const NDArray& exit_output) {
+  CHECK_EQ(exit_output.shape().Size(), 1U) << "The exit output must have one element";
+  NDArray value = exit_output;
+  if (value.ctx().dev_mask() != cpu::kDevMask)
+    value = value.Copy(Context::CPU());
+  value.WaitToRead();
+  bool taken = false;
+  MSHADOW_TYPE_SWITCH_WITH_BOOL(
+      value.dtype(), DType, { taken = value.data().dptr<DType>()[0] != DType(0); });
+  return taken;
+}
+
 OpStatePtr CachedOp::StaticForward(const Context& default_ctx,
                                    const std::vector<NDArray*>& inputs,
                                    const std::vector<NDArray*>& outputs) {
+  OpStatePtr state_ptr = config_.shape_cache_size > 0 ? GetShapeCachedState(default_ctx, inputs)
+                                                      : GetCachedOpState(default_ctx);
+  return StaticForward(state_ptr, default_ctx, inputs, outputs);
+}
+
+OpStatePtr CachedOp::StaticForward(const OpStatePtr& state_ptr,
+                                   const Context& default_ctx,
+                                   const std::vector<NDArray*>& inputs,
+                                   const std::vector<NDArray*>& outputs) {
   using namespace nnvm;
   using namespace imperative;
 
   bool recording = Imperative::Get()->is_recording();
-  auto state_ptr = GetCachedOpState(default_ctx);
   auto& state    = state_ptr.get_state<CachedOpState>();
 
   // Need to lock the mutex on the state, this allows
@@ -720,11 +845,124 @@ OpStatePtr CachedOp::StaticForward(const Context& default_ctx,
   }
 
   PrepareOutputs(g, default_ctx, outputs, &arrays, true);
-  StaticRunOps(default_ctx, g, state_ptr, arrays, 0, idx.num_nodes());
+  const size_t exit_nid = ExitNodeEnd(idx, recording);
+  StaticRunOps(default_ctx, g, state_ptr, arrays, 0, exit_nid);
+  if (exit_nid < idx.num_nodes() && !ExitTaken(*outputs[config_.exit_output])) {
+    StaticRunOps(default_ctx, g, state_ptr, arrays, exit_nid, idx.num_nodes());
+  }
 
   return recording ? state_ptr : OpStatePtr();
 }
 
+size_t CachedOp::ExitNodeEnd(const nnvm::IndexedGraph& idx, bool recording) const {
+  if (config_.exit_output < 0 || recording)
+    return idx.num_nodes();
+  // the nodes are in topological order, so the ones the exit output depends on come first
+  return idx.outputs()[config_.exit_output].node_id + 1;
+}
+
+/*! \brief runs an operator on the inputs, without recording, and returns its output */
+static NDArray InvokeOp(const Context& ctx,
+                       const std::string& name,
+                       const std::unordered_map<std::string, std::string>& params,
+                       std::vector<NDArray> inputs) {
+  nnvm::NodeAttrs attrs;
+  attrs.op   = nnvm::Op::Get(name);
+  attrs.dict = params;
+  if (attrs.op->attr_parser) {
+    attrs.op->attr_parser(&attrs);
+  }
+  NDArray output;
+  std::vector<NDArray*> ndinputs, ndoutputs{&output};
+  for (NDArray& input : inputs) {
+    ndinputs.push_back(&input);
+  }
+  Imperative::Get()->Invoke(ctx, attrs, ndinputs, ndoutputs);
+  return output;
+}
+
+dim_t CachedOp::BucketLength(dim_t length) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto bucket = std::lower_bound(buckets_.begin(), buckets_.end(), length);
+  if (config_.shape_buckets.ndim() > 0) {
+    return bucket == buckets_.end() ? length : *bucket;
+  }
+  if (bucket != buckets_.end() && *bucket * 4 <= length * 5) {
+    return *bucket;
+  }
+  // learn a bucket: the length rounded up to a quarter of its octave
+  dim_t step = 1;
+  while (step * 8 <= length) {
+    step *= 2;
+  }
+  const dim_t learned = (length + step - 1) / step * step;
+  buckets_.insert(bucket, learned);
+  return learned;
+}
+
+OpStatePtr CachedOp::BucketedForward(const Context& default_ctx,
+                                     const std::vector<NDArray*>& inputs,
+                                     const std::vector<NDArray*>& outputs) {
+  const int axis = config_.bucket_axis;
+  // the length of the first data input with the axis decides the bucket
+  dim_t length = 0;
+  for (const uint32_t i : config_.data_indices) {
+    if (inputs[i]->shape().ndim() > axis) {
+      length = inputs[i]->shape()[axis];
+      break;
+    }
+  }
+  const dim_t padded = length > 0 ? BucketLength(length) : length;
+  if (padded == length) {
+    return StaticForward(default_ctx, inputs, outputs);
+  }
+
+  std::vector<NDArray> padded_inputs;
+  padded_inputs.reserve(config_.data_indices.ndim());
+  std::vector<NDArray*> bucketed_inputs(inputs);
+  for (const uint32_t i : config_.data_indices) {
+    const NDArray& input = *inputs[i];
+    if (input.storage_type() != kDefaultStorage || input.shape().ndim() <= axis ||
+        input.shape()[axis] != length) {
+      continue;
+    }
+    mxnet::TShape shape = input.shape();
+    shape[axis]         = padded - length;
+    NDArray zeros(shape, default_ctx, false, input.dtype());
+    zeros = 0;
+    padded_inputs.push_back(InvokeOp(default_ctx,
+                                     "Concat",
+                                     {{"num_args", "2"}, {"dim", std::to_string(axis)}},
+                                     {input, zeros}));
+    bucketed_inputs[i] = &padded_inputs.back();
+  }
+
+  std::vector<NDArray> padded_outputs(outputs.size());
+  std::vector<NDArray*> bucketed_outputs;
+  for (NDArray& output : padded_outputs) {
+    bucketed_outputs.push_back(&output);
+  }
+  OpStatePtr op_state = StaticForward(default_ctx, bucketed_inputs, bucketed_outputs);
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    NDArray output = padded_outputs[i];
+    if (output.storage_type() == kDefaultStorage && output.shape().ndim() > axis &&
+        output.shape()[axis] == padded) {
+      output = InvokeOp(default_ctx,
+                        "slice_axis",
+                        {{"axis", std::to_string(axis)},
+                         {"begin", "0"},
+                         {"end", std::to_string(length)}},
+                        {output});
+    }
+    if (outputs[i]->is_none()) {
+      *outputs[i] = output;
+    } else {
+      CopyFromTo(output, *outputs[i]);
+    }
+  }
+  return op_state;
+}
+
 OpStatePtr CachedOp::DynamicForward(const Context& default_ctx,
                                     const std::vector<NDArray*>& inputs,
                                     const std::vector<NDArray*>& outputs,
@@ -853,6 +1091,8 @@ OpStatePtr CachedOp::Forward(const std::shared_ptr<CachedOp>& op_ptr,
   }
 
   int prev_bulk_size = Engine::Get()->set_bulk_size(config_.forward_bulk_size);
+  int prev_lane =
+      execution_lane_ >= 0 ? Engine::Get()->set_execution_lane(execution_lane_) : -1;
 
   OpStatePtr op_state;
   try {
@@ -860,6 +1100,9 @@ OpStatePtr CachedOp::Forward(const std::shared_ptr<CachedOp>& op_ptr,
       config_.is_dynamic   = true;
       config_.static_alloc = false;
       op_state             = DynamicForward(default_ctx, inputs, outputs, true);
+    } else if (config_.static_alloc && config_.bucket_axis >= 0 &&
+               !Imperative::Get()->is_recording()) {
+      op_state = BucketedForward(default_ctx, inputs, outputs);
     } else if (config_.static_alloc) {
       op_state = StaticForward(default_ctx, inputs, outputs);
     } else {
@@ -867,10 +1110,14 @@ OpStatePtr CachedOp::Forward(const std::shared_ptr<CachedOp>& op_ptr,
     }
   } catch (const dmlc::Error& e) {
     Engine::Get()->set_bulk_size(prev_bulk_size);
+    if (prev_lane >= 0)
+      Engine::Get()->set_execution_lane(prev_lane);
     throw e;
   }
 
   Engine::Get()->set_bulk_size(prev_bulk_size);
+  if (prev_lane >= 0)
+    Engine::Get()->set_execution_lane(prev_lane);
 
   if (Imperative::Get()->is_recording() && !inlining_) {
     nnvm::NodeAttrs attrs;
@@ -883,6 +1130,79 @@ OpStatePtr CachedOp::Forward(const std::shared_ptr<CachedOp>& op_ptr,
   return op_state;
 }
 
+CachedOp::PartialOp CachedOp::GetPartialOp(const std::vector<uint32_t>& requested) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = partial_ops_.find(requested);
+  if (it != partial_ops_.end())
+    return it->second;
+
+  // the symbol of the requested outputs only has the nodes they depend on
+  nnvm::Symbol sym;
+  int exit_output = -1;
+  for (size_t k = 0; k < requested.size(); ++k) {
+    sym.outputs.push_back(sym_.outputs[requested[k]]);
+    if (static_cast<int>(requested[k]) == config_.exit_output)
+      exit_output = k;
+  }
+  std::unordered_map<const nnvm::Node*, uint32_t> input_pos;
+  const std::vector<nnvm::ObjectPtr> all_inputs = sym_.ListInputs(nnvm::Symbol::kAll);
+  for (uint32_t i = 0; i < all_inputs.size(); ++i) {
+    input_pos[all_inputs[i].get()] = i;
+  }
+  const std::unordered_set<uint32_t> params(config_.param_indices.begin(),
+                                            config_.param_indices.end());
+  PartialOp partial;
+  std::vector<uint32_t> data_indices, param_indices;
+  for (const nnvm::ObjectPtr& input : sym.ListInputs(nnvm::Symbol::kAll)) {
+    const uint32_t i = input_pos.at(input.get());
+    (params.count(i) ? param_indices : data_indices).push_back(partial.input_indices.size());
+    partial.input_indices.push_back(i);
+  }
+
+  std::vector<std::pair<std::string, std::string>> flags;
+  for (const auto& flag : flags_) {
+    if (flag.first != "data_indices" && flag.first != "param_indices" &&
+        flag.first != "exit_output") {
+      flags.push_back(flag);
+    }
+  }
+  std::ostringstream data_os, param_os;
+  data_os << mxnet::Tuple<uint32_t>(data_indices.begin(), data_indices.end());
+  param_os << mxnet::Tuple<uint32_t>(param_indices.begin(), param_indices.end());
+  flags.emplace_back("data_indices", data_os.str());
+  flags.emplace_back("param_indices", param_os.str());
+  flags.emplace_back("exit_output", std::to_string(exit_output));
+  partial.op                    = std::make_shared<CachedOp>(sym, flags);
+  partial.op->monitor_callback_ = monitor_callback_;
+  partial.op->monitor_all_      = monitor_all_;
+  return partial_ops_.emplace(requested, partial).first->second;
+}
+
+OpStatePtr CachedOp::PartialForward(const std::shared_ptr<CachedOp>& op_ptr,
+                                    const std::vector<uint32_t>& requested,
+                                    const std::vector<NDArray*>& inputs,
+                                    const std::vector<NDArray*>& outputs,
+                                    const Context& default_ctx) {
+  CHECK_EQ(inputs.size(), num_inputs());
+  CHECK_EQ(outputs.size(), requested.size());
+  CHECK(!requested.empty()) << "No output of CachedOp is requested";
+  for (size_t k = 0; k < requested.size(); ++k) {
+    CHECK_LT(requested[k], num_outputs()) << "CachedOp has no output " << requested[k];
+    CHECK(k == 0 || requested[k] > requested[k - 1]) << "The requested outputs must increase";
+  }
+  if (requested.size() == num_outputs()) {
+    return Forward(op_ptr, inputs, outputs, default_ctx);
+  }
+
+  const PartialOp partial = GetPartialOp(requested);
+  std::vector<NDArray*> partial_inputs;
+  partial_inputs.reserve(partial.input_indices.size());
+  for (const uint32_t i : partial.input_indices) {
+    partial_inputs.push_back(inputs[i]);
+  }
+  return partial.op->Forward(partial.op, partial_inputs, outputs, default_ctx);
+}
+
 void CachedOp::DynamicBackward(const bool retain_graph,
                                const OpStatePtr& op_state,
                                const std::vector<NDArray*>& inputs,
@@ -1271,6 +1591,10 @@ void CachedOp::RegisterOpHook(const CachedOp::CachedOpMonCallback& callback, boo
   CHECK(callback) << "invalid callback";
   monitor_callback_ = callback;
   monitor_all_      = monitor_all;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& partial : partial_ops_) {
+    partial.second.op->RegisterOpHook(callback, monitor_all);
+  }
 }
 
 OpStatePtr CreateCachedOpState(const NodeAttrs& attrs,
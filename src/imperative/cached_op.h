@@ -419,6 +419,11 @@ struct CachedOpConfig : public dmlc::Parameter<CachedOpConfig> {
   mxnet::Tuple<uint32_t> data_indices;
   mxnet::Tuple<uint32_t> param_indices;
   std::string subgraph;
+  uint32_t shape_cache_size;
+  int bucket_axis;
+  mxnet::Tuple<int> shape_buckets;
+  std::string execution_lane;
+  int exit_output;
   DMLC_DECLARE_PARAMETER(CachedOpConfig) {
     DMLC_DECLARE_FIELD(static_alloc)
         .set_default(false)
@@ -452,6 +457,35 @@ struct CachedOpConfig : public dmlc::Parameter<CachedOpConfig> {
     DMLC_DECLARE_FIELD(is_dynamic)
         .set_default(false)
         .describe("Whether the graph contains dynamic shape operators.");
+    DMLC_DECLARE_FIELD(shape_cache_size)
+        .set_default(0)
+        .describe(
+            "Number of input shapes per context whose static memory plan and operator "
+            "executors are kept, least recently used first out. 0 keeps only the last one. "
+            "Requires static_alloc.");
+    DMLC_DECLARE_FIELD(bucket_axis)
+        .set_default(-1)
+        .describe(
+            "Axis of the data inputs padded with zeros to a bucket length in inference, so that "
+            "the shape cache sees few distinct shapes. The outputs are sliced back to the "
+            "length of the inputs. -1 disables padding.");
+    DMLC_DECLARE_FIELD(shape_buckets)
+        .set_default(mxnet::Tuple<int>())
+        .describe(
+            "Increasing bucket lengths along bucket_axis. Empty learns the buckets from the "
+            "lengths seen, each within a quarter octave above its lengths.");
+    DMLC_DECLARE_FIELD(execution_lane)
+        .set_default(std::string(""))
+        .describe(
+            "Name of the engine execution lane the forward runs its CPU operators on. "
+            "Empty uses the lane of the calling thread.");
+    DMLC_DECLARE_FIELD(exit_output)
+        .set_default(-1)
+        .describe(
+            "Index of a one element output checked in inference once the operators it depends "
+            "on have run: when it is non-zero, the forward skips the remaining operators and "
+            "the outputs they compute are left unspecified. Requires static_alloc. -1 disables "
+            "the check.");
   }
 };
 
@@ -494,6 +528,18 @@ class CachedOp {
                              const std::vector<NDArray*>& inputs,
                              const std::vector<NDArray*>& outputs,
                              const Context& default_context);
+  /*!
+   * \brief runs the forward of the requested outputs only, on the part of the graph they depend
+   *        on, planned once per set of requested outputs
+   * \param requested the indices of the requested outputs, increasing
+   * \param inputs all the inputs of the op
+   * \param outputs the requested outputs
+   */
+  OpStatePtr PartialForward(const std::shared_ptr<CachedOp>& op_ptr,
+                            const std::vector<uint32_t>& requested,
+                            const std::vector<NDArray*>& inputs,
+                            const std::vector<NDArray*>& outputs,
+                            const Context& default_context);
   virtual void Backward(const bool retain_graph,
                         const OpStatePtr& state,
                         const std::vector<NDArray*>& inputs,
@@ -519,6 +565,32 @@ class CachedOp {
     return sym;
   }
   void RegisterOpHook(const CachedOp::CachedOpMonCallback& callback, bool monitor_all = false);
+  /*!
+   * \brief the hits and misses of the shape cache, and the input shapes and forward memory of
+   *        its states, as a JSON object
+   */
+  std::string ShapeCacheStats();
+  /*!
+   * \brief saves the compiled model of the op: its graph and flags, the shapes, types, storage
+   *        types and static memory plan of its forward for the specs of the inputs, and the
+   *        values of its parameters, aligned so that they can be mapped from the file
+   * \param fname the file
+   * \param ctx the CPU context the forward is planned on
+   * \param inputs example data inputs, and the parameters at the positions of param_indices
+   */
+  void SaveCompiled(const std::string& fname,
+                    const Context& ctx,
+                    const std::vector<NDArray*>& inputs);
+  /*!
+   * \brief loads a compiled model, with its forward planned, allocated and run once on ctx
+   * \param fname the file, mapped into memory when it is local
+   * \param ctx the CPU context
+   * \param inputs the parameters, backed by the file, at their positions, and empty arrays at
+   *        the positions of the data inputs
+   */
+  static std::shared_ptr<CachedOp> LoadCompiled(const std::string& fname,
+                                                const Context& ctx,
+                                                std::vector<NDArray>* inputs);
 
  protected:
   struct GraphInfo {
@@ -593,9 +665,15 @@ class CachedOp {
     std::vector<bool> dynamic_entries;
     std::multimap<size_t, NDArray> fwd_reuse_pool;
     std::multimap<size_t, NDArray> bwd_reuse_pool;
+
+    // the input shapes the state is planned for, and its hits, in the shape cache
+    mxnet::ShapeVector cached_shapes;
+    uint64_t cache_hits = 0;
   };
 
   OpStatePtr GetCachedOpState(const Context& ctx);
+  /*! \brief the state planned for the shapes of the inputs, from the shape cache of ctx */
+  OpStatePtr GetShapeCachedState(const Context& ctx, const std::vector<NDArray*>& inputs);
   bool SetForwardGraph(const Context& default_ctx,
                        GraphInfo* info,
                        const bool recording,
@@ -618,8 +696,15 @@ class CachedOp {
   OpStatePtr StaticForward(const Context& default_ctx,
                            const std::vector<NDArray*>& inputs,
                            const std::vector<NDArray*>& outputs);
+  OpStatePtr StaticForward(const OpStatePtr& state_ptr,
+                           const Context& default_ctx,
+                           const std::vector<NDArray*>& inputs,
+                           const std::vector<NDArray*>& outputs);
   struct DynamicRuntime;
 
+  // engine execution lane of the forward, -1 for the lane of the calling thread
+  int execution_lane_ = -1;
+
  private:
   OpStatePtr DynamicForward(const Context& default_ctx,
                             const std::vector<NDArray*>& inputs,
@@ -636,6 +721,27 @@ class CachedOp {
                       const std::vector<OpReqType>& reqs,
                       const std::vector<NDArray*>& outputs);
   size_t BwdOriginalInput(const std::vector<size_t>& input_map, size_t new_i);
+  /*! \brief the bucket length is padded to along bucket_axis, learning a bucket if needed */
+  dim_t BucketLength(dim_t length);
+  /*!
+   * \brief pads the data inputs to a bucket along bucket_axis, runs the forward, and slices
+   *        the outputs back
+   */
+  OpStatePtr BucketedForward(const Context& default_ctx,
+                             const std::vector<NDArray*>& inputs,
+                             const std::vector<NDArray*>& outputs);
+  /*! \brief an op computing some of the outputs, and the positions of its inputs in this op */
+  struct PartialOp {
+    std::shared_ptr<CachedOp> op;
+    std::vector<uint32_t> input_indices;
+  };
+  /*! \brief the op computing the requested outputs, created on first use */
+  PartialOp GetPartialOp(const std::vector<uint32_t>& requested);
+  /*!
+   * \brief the end of the operators the exit output depends on, which run before it is checked,
+   *        or the end of the graph without a check
+   */
+  size_t ExitNodeEnd(const nnvm::IndexedGraph& idx, bool recording) const;
 
   CachedOpConfig config_;
   nnvm::Graph fwd_graph_;
@@ -651,7 +757,13 @@ class CachedOp {
   bool monitor_all_{false};
 
   std::mutex mutex_;
+  // with a shape cache, the states of a context are ordered from most to least recently used
   std::unordered_map<Context, std::vector<OpStatePtr>> cached_op_states_;
+  std::vector<dim_t> buckets_;
+  uint64_t shape_cache_hits_   = 0;
+  uint64_t shape_cache_misses_ = 0;
+  // the ops computing subsets of the outputs, by the indices of the outputs
+  std::map<std::vector<uint32_t>, PartialOp> partial_ops_;
 
   friend class ::mxnet::io::LazyTransformDataset;
   nnvm::Symbol sym_;
@@ -0,0 +1,352 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cached_op_compiled.cc
+ * \brief Compiled models: a CachedOp saved with the plan of its forward and its parameters,
+ *        loaded ready to run
+ */
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include <dmlc/memory_io.h>
+#include <nnvm/pass_functions.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "./cached_op.h"
+#include "./exec_pass.h"
+
+namespace mxnet {
+
+namespace {
+
+/*! \brief magic number of a compiled model file */
+const uint64_t kCompiledModelMagic = 0x4d4f434d584e544dULL;
+/*! \brief version of the compiled model format */
+const uint64_t kCompiledModelVersion = 1;
+/*! \brief alignment of the parameters in the file */
+const size_t kCompiledModelAlign = 64;
+/*! \brief the graph attributes of the forward plan */
+const char* const kPlanAttrs[] = {"shape",
+                                  "shape_inputs",
+                                  "dtype",
+                                  "dtype_inputs",
+                                  "storage_type",
+                                  "storage_type_inputs",
+                                  "dispatch_mode",
+                                  "dev_mask"};
+
+size_t AlignUp(size_t offset) {
+  return (offset + kCompiledModelAlign - 1) / kCompiledModelAlign * kCompiledModelAlign;
+}
+
+void SaveShapes(dmlc::Stream* strm, const mxnet::ShapeVector& shapes) {
+  strm->Write(static_cast<uint64_t>(shapes.size()));
+  for (const mxnet::TShape& shape : shapes) {
+    shape.Save(strm);
+  }
+}
+
+bool LoadShapes(dmlc::Stream* strm, mxnet::ShapeVector* shapes) {
+  uint64_t size = 0;
+  if (!strm->Read(&size))
+    return false;
+  shapes->resize(size);
+  for (mxnet::TShape& shape : *shapes) {
+    if (!shape.Load(strm))
+      return false;
+  }
+  return true;
+}
+
+/*! \brief the bytes of a file, mapped into memory when it is local */
+std::shared_ptr<char> MapFile(const std::string& fname, size_t* size) {
+#ifndef _WIN32
+  const int fd = open(fname.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    CHECK_EQ(fstat(fd, &st), 0) << "Failed to stat " << fname << ": " << strerror(errno);
+    *size = st.st_size;
+    CHECK_GT(*size, 0) << fname << " is empty";
+    // private pages, so that writes to the parameters do not reach the file
+    void* ptr = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    CHECK(ptr != MAP_FAILED) << "Failed to map " << fname << ": " << strerror(errno);
+    const size_t length = *size;
+    return std::shared_ptr<char>(static_cast<char*>(ptr),
+                                 [length](char* p) { munmap(p, length); });
+  }
+#endif  // _WIN32
+  std::unique_ptr<dmlc::Stream> fi(dmlc::Stream::Create(fname.c_str(), "r"));
+  auto buffer = std::make_shared<std::string>();
+  char chunk[1 << 16];
+  size_t nread;
+  while ((nread = fi->Read(chunk, sizeof(chunk))) > 0) {
+    buffer->append(chunk, nread);
+  }
+  *size = buffer->size();
+  return std::shared_ptr<char>(buffer, &(*buffer)[0]);
+}
+
+}  // namespace
+
+void CachedOp::SaveCompiled(const std::string& fname,
+                            const Context& ctx,
+                            const std::vector<NDArray*>& inputs) {
+  using namespace imperative;
+  CHECK(config_.static_alloc) << "A compiled model requires static_alloc";
+  CHECK_LT(config_.bucket_axis, 0) << "A compiled model is planned for one shape of the inputs";
+  CHECK_EQ(ctx.dev_mask(), Context::kCPU) << "Compiled models are planned for CPU";
+  CHECK(!Imperative::Get()->is_recording()) << "A compiled model cannot be saved while recording";
+  CHECK_EQ(inputs.size(), num_inputs());
+
+  // plans the forward for the specs of the inputs
+  std::vector<NDArray> outputs(num_outputs());
+  std::vector<NDArray*> output_ptrs;
+  for (NDArray& output : outputs) {
+    output_ptrs.push_back(&output);
+  }
+  Forward(nullptr, inputs, output_ptrs, ctx);
+  CHECK(!config_.is_dynamic) << "A compiled model cannot have dynamic shape operators";
+  OpStatePtr state_ptr;
+  {
+    // a state planned by the forward
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const OpStatePtr& state : cached_op_states_[ctx]) {
+      if (state.get_state<CachedOpState>().fwd_alloc) {
+        state_ptr = state;
+        break;
+      }
+    }
+  }
+  CHECK(state_ptr) << "The forward of the op was not statically planned";
+
+  std::string header;
+  dmlc::MemoryStringStream strm(&header);
+  {
+    nnvm::Graph sym_graph;
+    sym_graph.outputs = sym_.outputs;
+    strm.Write(nnvm::pass::SaveJSON(sym_graph));
+  }
+  std::vector<std::string> flag_keys, flag_vals;
+  for (const auto& flag : flags_) {
+    flag_keys.push_back(flag.first);
+    flag_vals.push_back(flag.second);
+  }
+  strm.Write(flag_keys);
+  strm.Write(flag_vals);
+
+  auto& state = state_ptr.get_state<CachedOpState>();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    const nnvm::Graph& g = state.info.fwd_graph;
+    for (const char* attr : kPlanAttrs) {
+      CHECK(g.attrs.count(attr)) << "The forward plan has no " << attr;
+    }
+    SaveShapes(&strm, g.GetAttr<mxnet::ShapeVector>("shape"));
+    SaveShapes(&strm, g.GetAttr<mxnet::ShapeVector>("shape_inputs"));
+    strm.Write(g.GetAttr<nnvm::DTypeVector>("dtype"));
+    strm.Write(g.GetAttr<nnvm::DTypeVector>("dtype_inputs"));
+    strm.Write(g.GetAttr<StorageTypeVector>("storage_type"));
+    strm.Write(g.GetAttr<StorageTypeVector>("storage_type_inputs"));
+    const auto& dispatch_modes = g.GetAttr<DispatchModeVector>("dispatch_mode");
+    strm.Write(std::vector<int>(dispatch_modes.begin(), dispatch_modes.end()));
+    strm.Write(g.GetAttr<exec::DevMaskVector>("dev_mask"));
+    strm.Write(g.GetAttr<std::vector<int>>(AddPrefix(FORWARD, STORAGE_PLAN)));
+    std::vector<int> storage_ids, inplace;
+    std::vector<uint32_t> roots;
+    std::vector<uint64_t> sizes;
+    const auto& mem_plan = g.GetAttr<MemoryPlanVector>(AddPrefix(FORWARD, MEM_PLAN));
+    for (const MemoryPlanInfo& info : mem_plan) {
+      storage_ids.push_back(info.storage_id);
+      roots.push_back(info.root);
+      sizes.push_back(info.size);
+      inplace.push_back(info.inplace);
+    }
+    strm.Write(storage_ids);
+    strm.Write(roots);
+    strm.Write(sizes);
+    strm.Write(inplace);
+  }
+
+  // the parameters, copied to the CPU in the default layout
+  std::vector<uint32_t> param_indices(config_.param_indices.begin(), config_.param_indices.end());
+  std::vector<NDArray> params;
+  mxnet::ShapeVector param_shapes;
+  std::vector<int> param_dtypes;
+  std::vector<uint64_t> param_offsets;
+  size_t offset = 0;
+  for (const uint32_t i : param_indices) {
+    CHECK_LT(i, inputs.size()) << "param index " << i << " is out of range";
+    const NDArray& param = *inputs[i];
+    CHECK_EQ(param.storage_type(), kDefaultStorage) << "Compiled models require dense parameters";
+    NDArray value(param.shape(), Context::CPU(), false, param.dtype());
+    CopyFromTo(param, &value);
+    value.WaitToRead();
+    param_shapes.push_back(value.shape());
+    param_dtypes.push_back(value.dtype());
+    param_offsets.push_back(offset);
+    offset = AlignUp(offset + value.shape().Size() * mshadow::mshadow_sizeof(value.dtype()));
+    params.push_back(value);
+  }
+  strm.Write(param_indices);
+  SaveShapes(&strm, param_shapes);
+  strm.Write(param_dtypes);
+  strm.Write(param_offsets);
+
+  std::unique_ptr<dmlc::Stream> fo(dmlc::Stream::Create(fname.c_str(), "w"));
+  const uint64_t prefix[] = {kCompiledModelMagic, kCompiledModelVersion, header.size()};
+  fo->Write(prefix, sizeof(prefix));
+  fo->Write(header.data(), header.size());
+  const std::string padding(kCompiledModelAlign, '\0');
+  size_t written = sizeof(prefix) + header.size();
+  fo->Write(padding.data(), AlignUp(written) - written);
+  written = 0;
+  for (size_t k = 0; k < params.size(); ++k) {
+    fo->Write(padding.data(), param_offsets[k] - written);
+    const size_t bytes = params[k].shape().Size() * mshadow::mshadow_sizeof(params[k].dtype());
+    fo->Write(params[k].data().dptr_, bytes);
+    written = param_offsets[k] + bytes;
+  }
+}
+
+std::shared_ptr<CachedOp> CachedOp::LoadCompiled(const std::string& fname,
+                                                 const Context& ctx,
+                                                 std::vector<NDArray>* inputs) {
+  using namespace imperative;
+  CHECK_EQ(ctx.dev_mask(), Context::kCPU) << "Compiled models are planned for CPU";
+  size_t size                = 0;
+  std::shared_ptr<char> file = MapFile(fname, &size);
+  uint64_t prefix[3];
+  CHECK_GE(size, sizeof(prefix)) << fname << " is not a compiled model";
+  std::memcpy(prefix, file.get(), sizeof(prefix));
+  CHECK_EQ(prefix[0], kCompiledModelMagic) << fname << " is not a compiled model";
+  CHECK_EQ(prefix[1], kCompiledModelVersion) << "Unsupported compiled model version " << prefix[1];
+  CHECK_LE(sizeof(prefix) + prefix[2], size) << fname << " is truncated";
+  dmlc::MemoryFixedSizeStream strm(file.get() + sizeof(prefix), prefix[2]);
+  const size_t data_begin = AlignUp(sizeof(prefix) + prefix[2]);
+
+  std::string json;
+  std::vector<std::string> flag_keys, flag_vals;
+  mxnet::ShapeVector shapes, shape_inputs, param_shapes;
+  nnvm::DTypeVector dtypes, dtype_inputs;
+  StorageTypeVector stypes, stype_inputs;
+  std::vector<int> dispatch_modes, dev_mask, storage_plan, storage_ids, inplace, param_dtypes;
+  std::vector<uint32_t> roots, param_indices;
+  std::vector<uint64_t> sizes, param_offsets;
+  CHECK(strm.Read(&json) && strm.Read(&flag_keys) && strm.Read(&flag_vals) &&
+        LoadShapes(&strm, &shapes) && LoadShapes(&strm, &shape_inputs) && strm.Read(&dtypes) &&
+        strm.Read(&dtype_inputs) && strm.Read(&stypes) && strm.Read(&stype_inputs) &&
+        strm.Read(&dispatch_modes) && strm.Read(&dev_mask) && strm.Read(&storage_plan) &&
+        strm.Read(&storage_ids) && strm.Read(&roots) && strm.Read(&sizes) &&
+        strm.Read(&inplace) && strm.Read(&param_indices) && LoadShapes(&strm, &param_shapes) &&
+        strm.Read(&param_dtypes) && strm.Read(&param_offsets))
+      << "Invalid compiled model " << fname;
+  CHECK_EQ(flag_keys.size(), flag_vals.size()) << "Invalid compiled model " << fname;
+
+  nnvm::Symbol sym;
+  sym.outputs = nnvm::pass::LoadJSON(json).outputs;
+  std::vector<std::pair<std::string, std::string>> flags;
+  for (size_t i = 0; i < flag_keys.size(); ++i) {
+    flags.emplace_back(flag_keys[i], flag_vals[i]);
+  }
+  auto op = std::make_shared<CachedOp>(sym, flags);
+
+  // the parameters share the memory of the file, which they keep alive
+  inputs->assign(op->num_inputs(), NDArray());
+  for (size_t k = 0; k < param_indices.size(); ++k) {
+    const size_t bytes = param_shapes[k].Size() * mshadow::mshadow_sizeof(param_dtypes[k]);
+    CHECK_LT(param_indices[k], inputs->size()) << "Invalid compiled model " << fname;
+    CHECK_LE(data_begin + param_offsets[k] + bytes, size) << fname << " is truncated";
+    TBlob blob(file.get() + data_begin + param_offsets[k],
+               param_shapes[k],
+               cpu::kDevMask,
+               param_dtypes[k],
+               ctx.dev_id);
+    (*inputs)[param_indices[k]] = NDArray(blob, ctx.dev_id, [file]() {});
+  }
+
+  // restores the forward plan, so that the forward skips the inference and planning passes
+  CHECK_EQ(shape_inputs.size(), op->num_inputs()) << "Invalid compiled model " << fname;
+  CHECK_EQ(dtype_inputs.size(), op->num_inputs()) << "Invalid compiled model " << fname;
+  std::vector<NDArray> warmup_inputs = *inputs;
+  OpStatePtr state_ptr               = op->GetCachedOpState(ctx);
+  auto& state                        = state_ptr.get_state<CachedOpState>();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    nnvm::Graph& g = state.info.fwd_graph;
+    CHECK_EQ(g.indexed_graph().num_node_entries(), shapes.size())
+        << "The forward plan of " << fname << " does not match its graph";
+    // zeros of the planned specs stand for the data inputs in the warm-up forward
+    state.cached_shapes.resize(shape_inputs.size());
+    for (size_t i = 0; i < shape_inputs.size(); ++i) {
+      const uint32_t j       = state.info.input_map[i];
+      state.cached_shapes[j] = shape_inputs[i];
+      if (warmup_inputs[j].is_none()) {
+        warmup_inputs[j] = NDArray(shape_inputs[i], ctx, false, dtype_inputs[i]);
+        warmup_inputs[j] = 0;
+      }
+    }
+    MemoryPlanVector mem_plan(storage_ids.size());
+    for (size_t i = 0; i < mem_plan.size(); ++i) {
+      mem_plan[i] = {storage_ids[i], roots[i], sizes[i], inplace[i] != 0};
+    }
+    g.attrs["shape"]               = std::make_shared<dmlc::any>(std::move(shapes));
+    g.attrs["shape_inputs"]        = std::make_shared<dmlc::any>(std::move(shape_inputs));
+    g.attrs["dtype"]               = std::make_shared<dmlc::any>(std::move(dtypes));
+    g.attrs["dtype_inputs"]        = std::make_shared<dmlc::any>(std::move(dtype_inputs));
+    g.attrs["storage_type"]        = std::make_shared<dmlc::any>(std::move(stypes));
+    g.attrs["storage_type_inputs"] = std::make_shared<dmlc::any>(std::move(stype_inputs));
+    g.attrs["dispatch_mode"]       = std::make_shared<dmlc::any>(
+        DispatchModeVector(dispatch_modes.begin(), dispatch_modes.end()));
+    g.attrs["dev_mask"] = std::make_shared<dmlc::any>(exec::DevMaskVector(std::move(dev_mask)));
+    g.attrs[AddPrefix(FORWARD, STORAGE_PLAN)] =
+        std::make_shared<dmlc::any>(std::move(storage_plan));
+    g.attrs[AddPrefix(FORWARD, MEM_PLAN)] = std::make_shared<dmlc::any>(std::move(mem_plan));
+    op->StaticAllocMemory(state_ptr, false, false);
+  }
+  op->dynamic_shape_checked_ = true;
+  // the state must be free for the forward to pick it
+  state_ptr = OpStatePtr();
+
+  // the warm-up forward creates the operator executors and their resources
+  std::vector<NDArray*> input_ptrs;
+  for (NDArray& input : warmup_inputs) {
+    input_ptrs.push_back(&input);
+  }
+  std::vector<NDArray> outputs(op->num_outputs());
+  std::vector<NDArray*> output_ptrs;
+  for (NDArray& output : outputs) {
+    output_ptrs.push_back(&output);
+  }
+  op->Forward(op, input_ptrs, output_ptrs, ctx);
+  for (NDArray& output : outputs) {
+    output.WaitToRead();
+  }
+  return op;
+}
+
+}  // namespace mxnet
@@ -17,8 +17,11 @@
  * under the License.
  */
 
+#include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <iostream>
+#include <thread>
 #include "./imperative_utils.h"
 #include "./exec_pass.h"
 #include "./cached_op_threadsafe.h"
@@ -39,24 +42,82 @@ struct CachedOpThreadSafe::DynamicRuntime {
   std::vector<OpStatePtr> op_states;
 };
 
-OpStatePtr CachedOpThreadSafe::GetCachedOpState(const Context& ctx) {
-  for (const auto& i : cached_op_states_[ctx]) {
-    // only create one state per device when not using static memory
-    if (!config_.static_alloc || i.unique()) {
-      return i;
+/*!
+ * \brief Forward states of one context. A calling thread leases a slot for the whole forward,
+ *        so no two threads share the graph or the static memory of a state, and the states
+ *        are created on first lease. Pools form a list that only grows.
+ */
+struct CachedOpThreadSafe::StatePool {
+  StatePool(const Context& ctx, size_t size) : context(ctx), states(size), leased(size) {}
+
+  Context context;
+  std::vector<OpStatePtr> states;
+  std::vector<std::atomic<bool>> leased;
+  StatePool* next = nullptr;
+};
+
+CachedOpThreadSafe::StatePool* CachedOpThreadSafe::GetStatePool(
+    const Context& ctx,
+    const std::vector<NDArray*>& inputs) {
+  StatePool* head = state_pools_.load(std::memory_order_acquire);
+  for (StatePool* pool = head; pool != nullptr; pool = pool->next) {
+    if (pool->context == ctx)
+      return pool;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // another thread may have added the pool in the meantime
+  head = state_pools_.load(std::memory_order_acquire);
+  for (StatePool* pool = head; pool != nullptr; pool = pool->next) {
+    if (pool->context == ctx)
+      return pool;
+  }
+  // the check runs inference passes on a graph of its own, once
+  if (CheckDynamicShapeExists(ctx, inputs, true)) {
+    LOG(FATAL) << "Dynamic shapes aren't supported with thread-safe cached op";
+  }
+  size_t size = config_.num_states;
+  if (size == 0) {
+    size = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  auto pool  = new StatePool(ctx, size);
+  pool->next = head;
+  state_pools_.store(pool, std::memory_order_release);
+  return pool;
+}
+
+size_t CachedOpThreadSafe::LeaseState(StatePool* pool) {
+  // a thread starts from the slot it had last, which is usually free again
+  static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const size_t size               = pool->leased.size();
+  for (;;) {
+    for (size_t k = 0; k < size; ++k) {
+      const size_t i = (hint + k) % size;
+      if (!pool->leased[i].load(std::memory_order_relaxed) &&
+          !pool->leased[i].exchange(true, std::memory_order_acquire)) {
+        hint = i;
+        return i;
+      }
     }
+    // more concurrent callers than states
+    std::this_thread::yield();
   }
-  nnvm::Graph full_graph;
-  auto state_ptr = OpStatePtr::Create<CachedOpState>(ctx, fwd_graph_, full_graph, false);
+}
 
-  cached_op_states_[ctx].push_back(state_ptr);
-  return state_ptr;
+/*! \brief the flags of the base CachedOp, which does not know about the state pool */
+static std::vector<std::pair<std::string, std::string>> CachedOpFlags(
+    const std::vector<std::pair<std::string, std::string>>& flags) {
+  std::vector<std::pair<std::string, std::string>> ret;
+  for (const auto& flag : flags) {
+    if (flag.first != "num_states")
+      ret.push_back(flag);
+  }
+  return ret;
 }
 
 CachedOpThreadSafe::CachedOpThreadSafe(
     const nnvm::Symbol& sym,
     const std::vector<std::pair<std::string, std::string>>& flags)
-    : CachedOp(sym, flags) {
+    : CachedOp(sym, CachedOpFlags(flags)) {
   using namespace nnvm;
   using namespace imperative;
   static const std::vector<const Op*> zero_ops{Op::Get("zeros_like"), Op::Get("_zeros")};
@@ -77,22 +138,18 @@ CachedOpThreadSafe::CachedOpThreadSafe(
  * \brief Thread safe version of DynamicForward, with thread local buffer
  * used to store intermediate nodes in the graph
  */
-OpStatePtr CachedOpThreadSafe::DynamicForward(const Context& default_ctx,
+OpStatePtr CachedOpThreadSafe::DynamicForward(const OpStatePtr& state_ptr,
+                                              const Context& default_ctx,
                                               const std::vector<NDArray*>& inputs,
                                               const std::vector<NDArray*>& outputs) {
   using namespace nnvm;
   using namespace imperative;
 
-  auto state_ptr = GetCachedOpState(default_ctx);
-  auto op_state  = OpStatePtr::Create<DynamicRuntime>();
-  auto& runtime  = op_state.get_state<DynamicRuntime>();
+  auto op_state = OpStatePtr::Create<DynamicRuntime>();
+  auto& runtime = op_state.get_state<DynamicRuntime>();
   {
+    // the state is leased to this thread, so its graph is not shared
     auto& state = state_ptr.get_state<CachedOpState>();
-    // Need to lock the mutex on the state, this allows
-    // for multi context push of ops to dependency engine.
-    // SetForwardGraph runs infer passes on graphs as well
-    // as the planmemory pass.
-    std::lock_guard<std::mutex> lock(state.mutex);
     // the below call runs the NNVM graph passes: type inference,
     // shape inference, storage type inference and if the graph
     // doesn't have dynamic shapes it also plans and allocates memory
@@ -153,17 +210,8 @@ OpStatePtr CachedOpThreadSafe::Forward(const std::shared_ptr<CachedOp>& op_ptr,
                                        const std::vector<NDArray*>& inputs,
                                        const std::vector<NDArray*>& outputs,
                                        const Context& default_ctx) {
-  // Acquiring lock on the mutex in forward
-  // Without this there are issues with static_forward,
-  // specifically with static_shape=True and dynamic_forward.
-  // Adding the lock here for safety,
-  // The perf hit would be acceptable because this involves just pushing
-  // ops to engine and not actual execution
-  // We are putting this lock here because without this there is a hang
-  // in the accept4 call in CUDA lib.
-  // TODO(anirudh2290): Investigate this issue more as it also prevents parallel
-  // push of ops for different contexts
-  std::lock_guard<std::mutex> lock(mutex_);
+  // Each thread runs on a state leased from the pool of the context, so forwards on
+  // different states are pushed to the engine in parallel without a lock
   CHECK_EQ(inputs.size(), num_inputs());
   const auto& idx = fwd_graph_.indexed_graph();
   for (size_t i = 0; i < inputs.size(); ++i) {
@@ -173,23 +221,34 @@ OpStatePtr CachedOpThreadSafe::Forward(const std::shared_ptr<CachedOp>& op_ptr,
         << idx[idx.input_nodes()[i]].source->attrs.name << " is on " << inputs[i]->ctx();
   }
 
-  int prev_bulk_size = Engine::Get()->set_bulk_size(config_.forward_bulk_size);
-  OpStatePtr op_state;
-  try {
-    if (CheckDynamicShapeExists(default_ctx, inputs, true)) {
-      LOG(FATAL) << "Dynamic shapes aren't supported with thread-safe cached op";
-    }
-    if (config_.static_alloc) {
-      op_state = StaticForward(default_ctx, inputs, outputs);
-    } else {
-      op_state = DynamicForward(default_ctx, inputs, outputs);
+  // releases the lease and restores the engine settings however the forward ends
+  struct ForwardScope {
+    std::atomic<bool>* leased;
+    int prev_bulk_size;
+    int prev_lane;
+    ~ForwardScope() {
+      Engine::Get()->set_bulk_size(prev_bulk_size);
+      if (prev_lane >= 0)
+        Engine::Get()->set_execution_lane(prev_lane);
+      leased->store(false, std::memory_order_release);
     }
-  } catch (const dmlc::Error& e) {
-    Engine::Get()->set_bulk_size(prev_bulk_size);
-    throw e;
+  };
+  StatePool* pool   = GetStatePool(default_ctx, inputs);
+  const size_t slot = LeaseState(pool);
+  ForwardScope scope{
+      &pool->leased[slot],
+      Engine::Get()->set_bulk_size(config_.forward_bulk_size),
+      execution_lane_ >= 0 ? Engine::Get()->set_execution_lane(execution_lane_) : -1};
+
+  OpStatePtr& state_ptr = pool->states[slot];
+  if (!state_ptr) {
+    nnvm::Graph full_graph;
+    state_ptr = OpStatePtr::Create<CachedOpState>(default_ctx, fwd_graph_, full_graph, false);
   }
-  Engine::Get()->set_bulk_size(prev_bulk_size);
-  return op_state;
+  if (config_.static_alloc) {
+    return StaticForward(state_ptr, default_ctx, inputs, outputs);
+  }
+  return DynamicForward(state_ptr, default_ctx, inputs, outputs);
 }
 
 struct CachedOpThreadSafeActualState {
@@ -252,7 +311,14 @@ void CachedOpThreadSafeParamParser(nnvm::NodeAttrs* attrs) {
     throw dmlc::ParamError(os.str());
   }
 }
-CachedOpThreadSafe::~CachedOpThreadSafe() = default;
+CachedOpThreadSafe::~CachedOpThreadSafe() {
+  StatePool* pool = state_pools_.load();
+  while (pool != nullptr) {
+    StatePool* next = pool->next;
+    delete pool;
+    pool = next;
+  }
+}
 
 NNVM_REGISTER_OP(_CachedOpThreadSafe)
     .set_num_inputs([](const NodeAttrs& attrs) {
@@ -25,6 +25,7 @@
 #include <mxnet/imperative.h>
 #include <vector>
 #include <atomic>
+#include <memory>
 #include <utility>
 #include <string>
 #include <unordered_map>
@@ -42,6 +43,9 @@ struct CachedOpThreadSafeConfig : public dmlc::Parameter<CachedOpThreadSafeConfi
   mxnet::Tuple<uint32_t> param_indices;
   // decides the bulk size for dynamic forward
   uint32_t forward_bulk_size;
+  // number of forward states, each with its own graph and static memory, per context
+  uint32_t num_states;
+  std::string execution_lane;
   bool static_alloc;
   bool static_shape;
   DMLC_DECLARE_PARAMETER(CachedOpThreadSafeConfig) {
@@ -59,6 +63,17 @@ struct CachedOpThreadSafeConfig : public dmlc::Parameter<CachedOpThreadSafeConfi
     DMLC_DECLARE_FIELD(forward_bulk_size)
         .set_default(Imperative::BulkExecMaxNodeTrainFwd())
         .describe("Segment size of bulk execution during dynamic forward");
+    DMLC_DECLARE_FIELD(num_states)
+        .set_default(0)
+        .describe(
+            "Maximum number of forwards that run concurrently on a context. "
+            "Each keeps its own state, and its own memory with static_alloc. "
+            "0 uses the number of hardware threads.");
+    DMLC_DECLARE_FIELD(execution_lane)
+        .set_default(std::string(""))
+        .describe(
+            "Name of the engine execution lane the forward runs its CPU operators on. "
+            "Empty uses the lane of the calling thread.");
     DMLC_DECLARE_FIELD(data_indices)
         .set_default(mxnet::Tuple<uint32_t>())
         .describe("Position of argument variables.");
@@ -112,17 +127,21 @@ class CachedOpThreadSafe : public CachedOp {
 
  private:
   struct DynamicRuntime;
+  struct StatePool;
 
-  OpStatePtr GetCachedOpState(const Context& ctx);
+  StatePool* GetStatePool(const Context& ctx, const std::vector<NDArray*>& inputs);
+  size_t LeaseState(StatePool* pool);
 
-  OpStatePtr DynamicForward(const Context& default_ctx,
+  OpStatePtr DynamicForward(const OpStatePtr& state_ptr,
+                            const Context& default_ctx,
                             const std::vector<NDArray*>& inputs,
                             const std::vector<NDArray*>& outputs);
 
   CachedOpThreadSafeConfig config_;
   nnvm::Graph fwd_graph_;
+  // guards the creation of state pools, which are never removed, so lookups do not lock
   std::mutex mutex_;
-  std::unordered_map<Context, std::vector<OpStatePtr>> cached_op_states_;
+  std::atomic<StatePool*> state_pools_{nullptr};
 };
 
 using CachedOpThreadSafePtr = std::shared_ptr<CachedOpThreadSafe>;
@@ -23,6 +23,8 @@
 
 #include "./imperative_utils.h"
 #include "./cached_op.h"
+#include "./invoke_cache.h"
+#include "../common/object_pool.h"
 
 namespace nnvm {
 ObjectPtr CreateVariableNode(const std::string& name);
@@ -102,13 +104,40 @@ OpStatePtr Imperative::InvokeOp(const Context& ctx,
   return state;
 }
 
+void* Imperative::AGInfo::operator new(std::size_t size) {
+  if (size != sizeof(AGInfo)) {
+    return ::operator new(size);
+  }
+  return common::ObjectPool<AGInfo>::Get()->Allocate();
+}
+
+void Imperative::AGInfo::operator delete(void* ptr, std::size_t size) {
+  if (size != sizeof(AGInfo)) {
+    ::operator delete(ptr);
+  } else if (ptr != nullptr) {
+    common::ObjectPool<AGInfo>::Get()->Free(ptr);
+  }
+}
+
 OpStatePtr Imperative::Invoke(const Context& default_ctx,
                               const nnvm::NodeAttrs& attrs,
                               const std::vector<NDArray*>& inputs,
                               const std::vector<NDArray*>& outputs) {
+  return Invoke(default_ctx, attrs, inputs, outputs, std::string());
+}
+
+OpStatePtr Imperative::Invoke(const Context& default_ctx,
+                              const nnvm::NodeAttrs& attrs,
+                              const std::vector<NDArray*>& inputs,
+                              const std::vector<NDArray*>& outputs,
+                              const std::string& attrs_key) {
   using namespace imperative;
   static auto& ndfunc = nnvm::Op::GetAttr<FNDArrayFunction>("FNDArrayFunction");
 
+  for (const NDArray* output : outputs) {
+    CHECK(!output->IsReadOnly()) << "Operator " << attrs.op->name
+                                 << " cannot write to a read-only array";
+  }
   if (ndfunc.count(attrs.op)) {
     std::vector<NDArray> p_inputs, p_outputs;
     DerefInputOutput(inputs, outputs, &p_inputs, &p_outputs);
@@ -121,7 +150,11 @@ OpStatePtr Imperative::Invoke(const Context& default_ctx,
   // TODO(piiswrong): infer ctx
   DispatchMode dispatch_mode = DispatchMode::kUndefined;
   Context ctx                = GetContext(attrs, inputs, outputs, default_ctx);
-  SetShapeType(ctx, attrs, inputs, outputs, &dispatch_mode);
+  if (attrs_key.empty()) {
+    SetShapeType(ctx, attrs, inputs, outputs, &dispatch_mode);
+  } else {
+    InvokeCache::Get()->SetShapeType(attrs_key, ctx, attrs, inputs, outputs, &dispatch_mode);
+  }
   std::vector<OpReqType> req;
   SetWriteInplaceReq(inputs, outputs, &req);
   OpStatePtr ret = InvokeOp(ctx, attrs, inputs, outputs, req, dispatch_mode);
@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <dmlc/parameter.h>
+#include <dmlc/thread_local.h>
+#include "./invoke_cache.h"
+#include "./imperative_utils.h"
+#include "../profiler/profiler.h"
+
+namespace mxnet {
+namespace imperative {
+
+InvokeCache* InvokeCache::Get() {
+  return dmlc::ThreadLocalStore<InvokeCache>::Get();
+}
+
+InvokeCache::InvokeCache()
+    : capacity_(dmlc::GetEnv("MXNET_IMPERATIVE_INVOKE_CACHE_SIZE", size_t(4096))) {}
+
+/*! \brief appends the bytes of a value to a key */
+template <typename T>
+static void AppendKey(std::string* key, const T& value) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+nnvm::NodeAttrs InvokeCache::ParseAttrs(const nnvm::Op* op,
+                                        int num_inputs,
+                                        int num_params,
+                                        const char** param_keys,
+                                        const char** param_vals,
+                                        std::string* attrs_key) {
+  // the parser of a stateful operator may create a new state for each invocation
+  static auto& fcreate_op_state = nnvm::Op::GetAttr<FCreateOpState>("FCreateOpState");
+  const std::string scope       = profiler::ProfilerScope::Get()->GetCurrentProfilerScope();
+  attrs_key->clear();
+  const bool cacheable = capacity_ > 0 && !fcreate_op_state.count(op);
+  if (cacheable) {
+    attrs_key->append(op->name).push_back('\0');
+    AppendKey(attrs_key, num_inputs);
+    attrs_key->append(scope).push_back('\0');
+    for (int i = 0; i < num_params; ++i) {
+      attrs_key->append(param_keys[i]).push_back('\0');
+      attrs_key->append(param_vals[i]).push_back('\0');
+    }
+    auto it = attrs_.find(*attrs_key);
+    if (it != attrs_.end()) {
+      return it->second;
+    }
+  }
+
+  nnvm::NodeAttrs attrs =
+      imperative::ParseAttrs(op, num_inputs, num_params, param_keys, param_vals);
+  attrs.dict["__profiler_scope__"] = scope;
+  if (attrs.op) {
+    attrs.name = attrs.op->name;
+  }
+  if (cacheable) {
+    if (attrs_.size() >= capacity_) {
+      attrs_.clear();
+    }
+    attrs_.emplace(*attrs_key, attrs);
+  }
+  return attrs;
+}
+
+void InvokeCache::SetShapeType(const std::string& attrs_key,
+                               const Context& ctx,
+                               const nnvm::NodeAttrs& attrs,
+                               const std::vector<NDArray*>& inputs,
+                               const std::vector<NDArray*>& outputs,
+                               DispatchMode* dispatch_mode) {
+  static auto& infershape = nnvm::Op::GetAttr<mxnet::FInferShape>("FInferShape");
+  bool cacheable          = capacity_ > 0 && !attrs_key.empty() && infershape.count(attrs.op);
+  for (const NDArray* output : outputs) {
+    cacheable = cacheable && output->is_none();
+  }
+  key_.assign(attrs_key);
+  AppendKey(&key_, ctx.dev_type);
+  AppendKey(&key_, ctx.dev_id);
+  AppendKey(&key_, Imperative::Get()->is_np_shape());
+  // the default dtype of numpy semantics sets the output type of some operators
+  AppendKey(&key_, Imperative::Get()->is_np_default_dtype());
+  for (const NDArray* input : inputs) {
+    const mxnet::TShape& shape = input->shape();
+    cacheable                  = cacheable && shape_is_known(shape);
+    AppendKey(&key_, shape.ndim());
+    for (int i = 0; i < shape.ndim(); ++i) {
+      AppendKey(&key_, shape[i]);
+    }
+    AppendKey(&key_, input->dtype());
+    AppendKey(&key_, input->storage_type());
+  }
+  if (!cacheable) {
+    imperative::SetShapeType(ctx, attrs, inputs, outputs, dispatch_mode);
+    return;
+  }
+
+  auto it = inferred_.find(key_);
+  if (it != inferred_.end()) {
+    const InferredAttrs& inferred = it->second;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      outputs[i]->ReInit(static_cast<NDArrayStorageType>(inferred.stypes[i]),
+                         inferred.shapes[i],
+                         ctx,
+                         inferred.dtypes[i]);
+      outputs[i]->AssignStorageInfo(common::NodeAttrsGetProfilerScope(attrs), attrs.name);
+    }
+    *dispatch_mode = inferred.dispatch_mode;
+    return;
+  }
+
+  imperative::SetShapeType(ctx, attrs, inputs, outputs, dispatch_mode);
+  InferredAttrs inferred;
+  inferred.dispatch_mode = *dispatch_mode;
+  for (const NDArray* output : outputs) {
+    if (!shape_is_known(output->shape())) {
+      return;
+    }
+    inferred.shapes.push_back(output->shape());
+    inferred.dtypes.push_back(output->dtype());
+    inferred.stypes.push_back(output->storage_type());
+  }
+  if (inferred_.size() >= capacity_) {
+    inferred_.clear();
+  }
+  inferred_.emplace(key_, std::move(inferred));
+}
+
+}  // namespace imperative
+}  // namespace mxnet
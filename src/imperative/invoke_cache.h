@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Caches the frontend work of imperative invocations
+#ifndef MXNET_IMPERATIVE_INVOKE_CACHE_H_
+#define MXNET_IMPERATIVE_INVOKE_CACHE_H_
+
+#include <mxnet/imperative.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mxnet {
+namespace imperative {
+
+/*!
+ * \brief Per-thread cache of the attributes parsed from the string parameters of an operator,
+ *        and of the output shapes, dtypes, storage types and dispatch mode inferred for the
+ *        attributes and the shapes, dtypes and storage types of the inputs. Eager loops invoke
+ *        the same few operators on the same shapes over and over, so both are mostly hits.
+ *
+ * The number of entries of each cache is bounded by MXNET_IMPERATIVE_INVOKE_CACHE_SIZE,
+ * 0 disables the cache. A full cache is cleared.
+ */
+class InvokeCache {
+ public:
+  static InvokeCache* Get();
+
+  InvokeCache();
+  /*!
+   * \brief the attributes of the operator with the parameters, in the current profiler scope
+   * \param attrs_key set to a key that identifies the attributes, empty when they are not
+   *        cached
+   */
+  nnvm::NodeAttrs ParseAttrs(const nnvm::Op* op,
+                             int num_inputs,
+                             int num_params,
+                             const char** param_keys,
+                             const char** param_vals,
+                             std::string* attrs_key);
+  /*!
+   * \brief imperative::SetShapeType, with the result cached under attrs_key and the inputs
+   *        when all the outputs are to be allocated
+   */
+  void SetShapeType(const std::string& attrs_key,
+                    const Context& ctx,
+                    const nnvm::NodeAttrs& attrs,
+                    const std::vector<NDArray*>& inputs,
+                    const std::vector<NDArray*>& outputs,
+                    DispatchMode* dispatch_mode);
+
+ private:
+  struct InferredAttrs {
+    mxnet::ShapeVector shapes;
+    std::vector<int> dtypes;
+    std::vector<int> stypes;
+    DispatchMode dispatch_mode;
+  };
+
+  size_t capacity_;
+  std::unordered_map<std::string, nnvm::NodeAttrs> attrs_;
+  std::unordered_map<std::string, InferredAttrs> inferred_;
+  // reused to build the keys
+  std::string key_;
+};
+
+}  // namespace imperative
+}  // namespace mxnet
+#endif  // MXNET_IMPERATIVE_INVOKE_CACHE_H_
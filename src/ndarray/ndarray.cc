@@ -35,8 +35,10 @@
 
 #include "./ndarray_function.h"
 
+#include "../common/object_pool.h"
 #include "../common/utils.h"
 #include "../operator/nn/mkldnn/mkldnn_base-inl.h"
+#include "../operator/nn/mkldnn/mkldnn_weight_cache-inl.h"
 #include "../operator/tensor/init_op.h"
 #include "../operator/tensor/matrix_op-inl.h"
 #include "../profiler/storage_profiler.h"
@@ -87,7 +89,7 @@ void NDArray::ReInit(const NDArrayStorageType stype,
     ptr_ = std::make_shared<Chunk>(
         stype, storage_shape, ctx, delay_alloc, dtype, aux_types, aux_shapes);
   } else {
-    ptr_ = std::make_shared<Chunk>(shape, ctx, delay_alloc, dtype);
+    ptr_ = NewChunk(shape, ctx, delay_alloc, dtype);
   }
 }
 
@@ -124,6 +126,29 @@ struct ChunkMem {
 #endif
 };
 
+void* NDArray::operator new(std::size_t size) {
+  if (size != sizeof(NDArray)) {
+    return ::operator new(size);
+  }
+  return common::ObjectPool<NDArray>::Get()->Allocate();
+}
+
+void NDArray::operator delete(void* ptr, std::size_t size) {
+  if (size != sizeof(NDArray)) {
+    ::operator delete(ptr);
+  } else if (ptr != nullptr) {
+    common::ObjectPool<NDArray>::Get()->Free(ptr);
+  }
+}
+
+std::shared_ptr<NDArray::Chunk> NDArray::NewChunk(const mxnet::TShape& shape,
+                                                  Context ctx,
+                                                  bool delay_alloc,
+                                                  int dtype) {
+  return std::allocate_shared<Chunk>(
+      common::ObjectPoolAllocator<Chunk>(), shape, ctx, delay_alloc, dtype);
+}
+
 NDArray::Chunk::~Chunk() {
   bool skip_free = static_data || delay_alloc;
   ChunkMem mem;
@@ -203,7 +228,7 @@ NDArray::NDArray(const mkldnn::memory::desc& md)
     : storage_type_(kDefaultStorage), autograd_entry_(nullptr) {
   shape_ = mxnet::TShape(md.data.dims, md.data.dims + md.data.ndims);
   dtype_ = get_mxnet_type(md.data.data_type);
-  ptr_   = std::make_shared<Chunk>(shape_, Context::CPU(), true, dtype_);
+  ptr_   = NewChunk(shape_, Context::CPU(), true, dtype_);
   ptr_->CheckAndAlloc(md.get_size());
   ptr_->mkl_mem_ = std::make_shared<MKLDNNMemory>(md, ptr_->shandle.dptr);
 }
@@ -213,7 +238,7 @@ NDArray::NDArray(const std::shared_ptr<mkldnn::memory>& mkldnn_mem)
   auto mem_desc      = mkldnn_mem->get_desc();
   shape_             = mxnet::TShape(mem_desc.data.dims, mem_desc.data.dims + mem_desc.data.ndims);
   dtype_             = get_mxnet_type(mem_desc.data.data_type);
-  ptr_               = std::make_shared<Chunk>(shape_, Context::CPU(), true, dtype_);
+  ptr_               = NewChunk(shape_, Context::CPU(), true, dtype_);
   ptr_->shandle.dptr = mkldnn_mem->get_data_handle();
   ptr_->shandle.size = mem_desc.get_size();
   ptr_->delay_alloc  = false;
@@ -526,6 +551,12 @@ void NDArray::Chunk::Reorder2Default() {
   if (IsDefault())
     return;
 
+  // the packed copy of read-only data is kept aside, and the data itself is still default
+  if (read_only) {
+    mkl_mem_ = nullptr;
+    return;
+  }
+
   mkldnn_format_tag_t format    = mkl_mem_->GetDefaultFormat();
   mkldnn::memory::desc def_desc = mkl_mem_->GetDesc(format);
   mkldnn_mem_ptr def_mem(new mkldnn::memory(def_desc, CpuEngine::Get()->get_engine()));
@@ -565,13 +596,43 @@ void NDArray::Chunk::MKLDNNDataReorder(const mkldnn::memory::desc& md) {
   }
   CHECK(old_mem->get_desc().data.ndims == md.data.ndims);
 
-  // This may be called in MKLDNN operators. We can't use MKLDNNStream here.
-  mkldnn::reorder(*old_mem, *new_mem).execute(s, *old_mem, *new_mem);
+  // weights packed before, by another operator or another process, are copied instead
+  const int cache_level = MKLDNNWeightCache::Level();
+  std::string key;
+  const mkldnn::memory* packed_mem = nullptr;
+  NDArray packed;
+  if (cache_level > 0) {
+    key    = MKLDNNWeightCache::Key(*old_mem, md, {});
+    packed = MKLDNNWeightCache::Get()->Find(key);
+    if (!packed.is_none())
+      packed_mem = packed.GetMKLDNNData();
+  }
+  if (packed_mem == nullptr) {
+    // This may be called in MKLDNN operators. We can't use MKLDNNStream here.
+    mkldnn::reorder(*old_mem, *new_mem).execute(s, *old_mem, *new_mem);
+    s.wait();
+    packed_mem = new_mem.get();
+    if (read_only) {
+      packed = NDArray(new_mem);
+      // the arrays with the same data share the packed copy while they hold it
+      if (cache_level > 0)
+        packed = MKLDNNWeightCache::Get()->Insert(key, packed);
+    } else if (cache_level > 1) {
+      MKLDNNWeightCache::Get()->Insert(key, NDArray(new_mem), true);
+    }
+  }
+
+  if (read_only) {
+    // the data is never written: the chunk holds the packed copy instead
+    const std::shared_ptr<mkldnn::memory> mem = packed.ptr_->mkl_mem_->GetMem();
+    mkl_mem_.reset(new MKLDNNMemory(std::shared_ptr<mkldnn::memory>(packed.ptr_, mem.get())));
+    return;
+  }
 
   CHECK(shandle.size >= md.get_size());
   CheckAndAlloc(md.get_size());
   // TODO(zhengda) We need to avoid memory copy here.
-  memcpy(shandle.dptr, new_mem->get_data_handle(), md.get_size());
+  memcpy(shandle.dptr, packed_mem->get_data_handle(), md.get_size());
   mkl_mem_.reset(new MKLDNNMemory(md, shandle.dptr));
 }
 
@@ -1413,6 +1474,7 @@ void CopyFromTo(const NDArray& from, const NDArray& to, int priority, bool is_op
     // skip to copy to itself
     return;
   }
+  CHECK(!to.IsReadOnly()) << "Cannot copy to a read-only array";
   CHECK(from.shape() == to.shape())
       << "operands shape mismatch "
       << "from.shape = " << from.shape() << " to.shape=" << to.shape();
@@ -2165,6 +2227,7 @@ NDArray NDArray::Copy(Context ctx) const {
 }
 
 void NDArray::SyncCopyFromCPU(const void* data, size_t size) const {
+  CHECK(!IsReadOnly()) << "Cannot copy to a read-only array";
   mxnet::TShape dshape = this->shape();
   if (!features::is_enabled(features::INT64_TENSOR_SIZE)) {
     CHECK_LT(size, (int64_t{1} << 31) - 1)
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shared_params.cc
+ * \brief Parameters published in named shared memory segments
+ */
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include <dmlc/memory_io.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include "./shared_params.h"
+
+namespace mxnet {
+
+namespace {
+
+/*! \brief magic number of a segment of parameters */
+const uint64_t kSharedParamsMagic = 0x534d5241504e584dULL;
+/*! \brief version of the segment format */
+const uint64_t kSharedParamsVersion = 1;
+/*! \brief alignment of the arrays in the segment */
+const size_t kSharedParamsAlign = 64;
+
+/*! \brief the start of a segment, followed by the index of the arrays and their data */
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t index_size;
+  uint64_t data_offset;
+  uint64_t size;
+  /*! \brief set by the publisher once the segment is written */
+  std::atomic<uint64_t> ready;
+};
+
+size_t AlignUp(size_t offset, size_t align) {
+  return (offset + align - 1) / align * align;
+}
+
+/*! \brief the name of the shared memory object of the segment name */
+std::string ObjectName(const std::string& name) {
+  CHECK(!name.empty() && name.find('/') == std::string::npos)
+      << "Invalid name of shared parameters: '" << name << "'";
+  return "/mxnet_params_" + name;
+}
+
+}  // namespace
+
+SharedParams* SharedParams::Get() {
+  static SharedParams inst;
+  return &inst;
+}
+
+#ifndef _WIN32
+std::shared_ptr<SharedParams::Segment> SharedParams::Publish(const std::string& name,
+                                                              const std::vector<std::string>& names,
+                                                              const std::vector<NDArray>& arrays) {
+  CHECK_EQ(names.size(), arrays.size());
+  // dense copies on CPU, in the default layout
+  std::vector<NDArray> sources;
+  for (size_t i = 0; i < arrays.size(); ++i) {
+    CHECK_EQ(arrays[i].storage_type(), kDefaultStorage)
+        << "Shared parameter " << names[i] << " must be dense";
+    NDArray src = arrays[i];
+    if (src.ctx().dev_mask() != cpu::kDevMask)
+      src = src.Copy(Context::CPU());
+    src.WaitToRead();
+#if MXNET_USE_ONEDNN == 1
+    if (src.IsMKLDNNData())
+      src = src.Reorder2Default();
+#endif
+    sources.push_back(src);
+  }
+
+  std::string index;
+  size_t data_size = 0;
+  {
+    dmlc::MemoryStringStream strm(&index);
+    strm.Write(static_cast<uint64_t>(sources.size()));
+    for (size_t i = 0; i < sources.size(); ++i) {
+      strm.Write(names[i]);
+      sources[i].shape().Save(&strm);
+      strm.Write(static_cast<int32_t>(sources[i].dtype()));
+      strm.Write(static_cast<uint64_t>(data_size));
+      data_size = AlignUp(data_size + sources[i].data().Size() *
+                                          mshadow::mshadow_sizeof(sources[i].dtype()),
+                          kSharedParamsAlign);
+    }
+  }
+  // the arrays start on a page, so that the pages of the header are the only ones written
+  const size_t page_size   = sysconf(_SC_PAGESIZE);
+  const size_t data_offset = AlignUp(sizeof(SegmentHeader) + index.size(), page_size);
+  const size_t size        = data_offset + data_size;
+
+  const std::string object = ObjectName(name);
+  const int fd             = shm_open(object.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  CHECK_GE(fd, 0) << "Failed to create shared parameters " << name << ": " << strerror(errno);
+  if (ftruncate(fd, size) != 0) {
+    const int err = errno;
+    close(fd);
+    shm_unlink(object.c_str());
+    LOG(FATAL) << "Failed to allocate " << size << " bytes for shared parameters " << name << ": "
+               << strerror(err);
+  }
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    const int err = errno;
+    shm_unlink(object.c_str());
+    LOG(FATAL) << "Failed to map shared parameters " << name << ": " << strerror(err);
+  }
+  char* base            = static_cast<char*>(ptr);
+  SegmentHeader* header = new (base) SegmentHeader();
+  header->magic         = kSharedParamsMagic;
+  header->version       = kSharedParamsVersion;
+  header->index_size    = index.size();
+  header->data_offset   = data_offset;
+  header->size          = size;
+  std::memcpy(base + sizeof(SegmentHeader), index.data(), index.size());
+  size_t offset = data_offset;
+  for (const NDArray& src : sources) {
+    const TBlob blob   = src.data();
+    const size_t bytes = blob.Size() * mshadow::mshadow_sizeof(blob.type_flag_);
+    std::memcpy(base + offset, blob.dptr_, bytes);
+    offset = AlignUp(offset + bytes, kSharedParamsAlign);
+  }
+  header->ready.store(1, std::memory_order_release);
+  munmap(ptr, size);
+  return Attach(name);
+}
+
+std::shared_ptr<SharedParams::Segment> SharedParams::Attach(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = segments_.find(name);
+  if (it != segments_.end())
+    return it->second;
+
+  const std::string object = ObjectName(name);
+  const int fd             = shm_open(object.c_str(), O_RDONLY, 0);
+  CHECK_GE(fd, 0) << "Failed to open shared parameters " << name << ": " << strerror(errno);
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Failed to stat shared parameters " << name << ": "
+                              << strerror(errno);
+  const size_t size = st.st_size;
+  CHECK_GE(size, sizeof(SegmentHeader)) << "Shared parameters " << name << " are not ready";
+  // read-only pages, which no process copies
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  CHECK(ptr != MAP_FAILED) << "Failed to map shared parameters " << name << ": "
+                           << strerror(errno);
+  std::shared_ptr<char> mapping(static_cast<char*>(ptr), [size](char* p) { munmap(p, size); });
+
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(mapping.get());
+  CHECK(header->ready.load(std::memory_order_acquire))
+      << "Shared parameters " << name << " are not ready";
+  CHECK_EQ(header->magic, kSharedParamsMagic) << name << " is not a segment of parameters";
+  CHECK_EQ(header->version, kSharedParamsVersion)
+      << "Shared parameters " << name << " have unsupported version " << header->version;
+  CHECK_EQ(header->size, size) << "Shared parameters " << name << " are corrupted";
+
+  auto segment = std::make_shared<Segment>();
+  dmlc::MemoryFixedSizeStream strm(mapping.get() + sizeof(SegmentHeader), header->index_size);
+  uint64_t num_arrays = 0;
+  CHECK(strm.Read(&num_arrays)) << "Invalid index of shared parameters " << name;
+  for (uint64_t i = 0; i < num_arrays; ++i) {
+    std::string array_name;
+    mxnet::TShape shape;
+    int32_t dtype   = 0;
+    uint64_t offset = 0;
+    CHECK(strm.Read(&array_name) && shape.Load(&strm) && strm.Read(&dtype) && strm.Read(&offset))
+        << "Invalid index of shared parameters " << name;
+    const size_t bytes = shape.Size() * mshadow::mshadow_sizeof(dtype);
+    CHECK_LE(header->data_offset + offset + bytes, size)
+        << "Shared parameter " << array_name << " is out of the segment " << name;
+    TBlob blob(mapping.get() + header->data_offset + offset, shape, cpu::kDevMask, dtype, 0);
+    // every array holds the mapping
+    segment->names.push_back(array_name);
+    segment->arrays.emplace_back(blob, 0, [mapping]() {});
+    segment->arrays.back().ptr_->read_only = true;
+  }
+  segments_[name] = segment;
+  return segment;
+}
+
+void SharedParams::Remove(const std::string& name) {
+  Detach(name);
+  CHECK_EQ(shm_unlink(ObjectName(name).c_str()), 0)
+      << "Failed to remove shared parameters " << name << ": " << strerror(errno);
+}
+#else
+std::shared_ptr<SharedParams::Segment> SharedParams::Publish(const std::string& name,
+                                                              const std::vector<std::string>& names,
+                                                              const std::vector<NDArray>& arrays) {
+  LOG(FATAL) << "Shared parameters are not supported on Windows";
+  return nullptr;
+}
+
+std::shared_ptr<SharedParams::Segment> SharedParams::Attach(const std::string& name) {
+  LOG(FATAL) << "Shared parameters are not supported on Windows";
+  return nullptr;
+}
+
+void SharedParams::Remove(const std::string& name) {
+  LOG(FATAL) << "Shared parameters are not supported on Windows";
+}
+#endif  // _WIN32
+
+void SharedParams::Detach(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  segments_.erase(name);
+}
+
+}  // namespace mxnet
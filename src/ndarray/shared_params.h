@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file shared_params.h
+ * \brief Parameters published in named shared memory segments, which the processes serving
+ *        the same model attach to instead of loading their own copy
+ */
+#ifndef MXNET_NDARRAY_SHARED_PARAMS_H_
+#define MXNET_NDARRAY_SHARED_PARAMS_H_
+
+#include <mxnet/ndarray.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mxnet {
+
+/*!
+ * \brief The segments of parameters attached by the process.
+ *
+ *        A segment holds dense CPU arrays, written once by the process that publishes it. The
+ *        arrays of an attached segment are read-only views of its pages, which all the processes
+ *        share: the oneDNN operators keep the weights they pack aside instead of packing them in
+ *        place. All the CachedOps of a process that attach to a segment get the same arrays, and
+ *        the segment stays mapped as long as any of them is referenced.
+ */
+class SharedParams {
+ public:
+  /*! \brief the arrays of a segment and their names */
+  struct Segment {
+    std::vector<std::string> names;
+    std::vector<NDArray> arrays;
+  };
+
+  /*! \brief the segments of the process */
+  static SharedParams* Get();
+
+  /*!
+   * \brief creates the segment name holding a copy of arrays, and attaches to it.
+   *        Fails when the segment exists
+   */
+  std::shared_ptr<Segment> Publish(const std::string& name,
+                                   const std::vector<std::string>& names,
+                                   const std::vector<NDArray>& arrays);
+  /*! \brief the segment name, mapped by the first call of the process */
+  std::shared_ptr<Segment> Attach(const std::string& name);
+  /*!
+   * \brief drops the reference of the process to the segment name, which is unmapped once its
+   *        arrays are released
+   */
+  void Detach(const std::string& name);
+  /*!
+   * \brief detaches from the segment name and removes it, so that no other process can attach.
+   *        The processes attached keep their arrays
+   */
+  void Remove(const std::string& name);
+
+ private:
+  SharedParams() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Segment>> segments_;
+};
+
+}  // namespace mxnet
+#endif  // MXNET_NDARRAY_SHARED_PARAMS_H_
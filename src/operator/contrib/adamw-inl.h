@@ -29,6 +29,7 @@
 #include <vector>
 #include "../mshadow_op.h"
 #include "../elemwise_op_common.h"
+#include "./multi_tensor_chunk-inl.h"
 
 namespace mxnet {
 namespace op {
@@ -435,24 +436,104 @@ void FillMultiAdamKernelParam(const nnvm::NodeAttrs& attrs,
 }
 
 template <typename xpu, template <typename> class MPTypeChooser, int input_stride>
-static inline void MultiAdamWUpdate(const nnvm::NodeAttrs& attrs,
-                                    const OpContext& ctx,
-                                    const std::vector<TBlob>& inputs,
-                                    const std::vector<OpReqType>& req,
-                                    const std::vector<TBlob>& outputs,
-                                    const float rescale_grad) {
-  using namespace mxnet_op;
-  Stream<xpu>* s = ctx.get_stream<xpu>();
-  MSHADOW_REAL_TYPE_SWITCH(outputs[0].type_flag_, DType, {
-    using MPDType = typename MPTypeChooser<DType>::type;
-    MultiAdamKernelParam<DType, MPDType> param;
-    FillMultiAdamKernelParam<xpu, DType, MPDType, MultiAdamWParam, input_stride>(
-        attrs, ctx, inputs, outputs, &param);
-
-    Kernel<MultiMPAdamWKernel<MPDType, !std::is_same<DType, MPDType>::value>, xpu>::Launch(
-        s, param.max_size, param, req[0], rescale_grad);
-  });
-}
+struct MultiAdamWUpdate {
+  static inline void Forward(const nnvm::NodeAttrs& attrs,
+                             const OpContext& ctx,
+                             const std::vector<TBlob>& inputs,
+                             const std::vector<OpReqType>& req,
+                             const std::vector<TBlob>& outputs,
+                             const float rescale_grad) {
+    using namespace mxnet_op;
+    Stream<xpu>* s = ctx.get_stream<xpu>();
+    MSHADOW_REAL_TYPE_SWITCH(outputs[0].type_flag_, DType, {
+      using MPDType = typename MPTypeChooser<DType>::type;
+      MultiAdamKernelParam<DType, MPDType> param;
+      const int max_weights = MultiAdamKernelParam<DType, MPDType>::N;
+      CHECK_LE(nnvm::get<MultiAdamWParam>(attrs.parsed).num_weights, max_weights)
+          << "Invalid number of weights, the maximum value is " << max_weights;
+      FillMultiAdamKernelParam<xpu, DType, MPDType, MultiAdamWParam, input_stride>(
+          attrs, ctx, inputs, outputs, &param);
+
+      Kernel<MultiMPAdamWKernel<MPDType, !std::is_same<DType, MPDType>::value>, xpu>::Launch(
+          s, param.max_size, param, req[0], rescale_grad);
+    });
+  }
+};
+
+/*!
+ * \brief On CPU all the weights are flattened into one list of balanced chunks updated in a
+ *        single OpenMP pass, so there is no limit on the number of weights, and every chunk
+ *        streams through contiguous memory of one weight. With the multi-precision variant,
+ *        bfloat16 weights are updated through their float32 master copies as well.
+ */
+template <template <typename> class MPTypeChooser, int input_stride>
+struct MultiAdamWUpdate<cpu, MPTypeChooser, input_stride> {
+  template <typename DType, typename MPDType>
+  static inline void Run(const MultiAdamWParam& p,
+                         const std::vector<TBlob>& inputs,
+                         const std::vector<OpReqType>& req,
+                         const std::vector<TBlob>& outputs,
+                         const MPDType rescale_grad) {
+    constexpr bool has_mixed_precision = !std::is_same<DType, MPDType>::value;
+    const MPDType clip_gradient        = p.clip_gradient;
+    const MPDType beta1                = p.beta1;
+    const MPDType beta2                = p.beta2;
+    const MPDType epsilon              = p.epsilon;
+    std::vector<size_t> sizes(p.num_weights);
+    for (int i = 0; i < p.num_weights; ++i) {
+      sizes[i] = req[i] == kNullOp ? 0 : inputs[i * input_stride].Size();
+    }
+    MultiTensorChunkedFor(sizes, [&](const int t, const size_t begin, const size_t end) {
+      const size_t idx     = t * input_stride;
+      const DType* weight  = inputs[idx].dptr<DType>();
+      const DType* grad    = inputs[idx + 1].dptr<DType>();
+      MPDType* mean        = inputs[idx + 2].dptr<MPDType>();
+      MPDType* var         = inputs[idx + 3].dptr<MPDType>();
+      DType* out           = outputs[t].dptr<DType>();
+      const MPDType eta    = p.etas[t];
+      const MPDType lr     = p.lrs[t];
+      const MPDType wd     = p.wds[t];
+      const OpReqType treq = req[t];
+      // if mixed precision, then the last input in a set is the float32 master copy
+      MPDType* weight32 =
+          has_mixed_precision ? inputs[idx + input_stride - 1].dptr<MPDType>() : nullptr;
+      for (size_t i = begin; i < end; ++i) {
+        MPDType w           = has_mixed_precision ? weight32[i] : MPDType(weight[i]);
+        MPDType scaled_grad = rescale_grad * static_cast<MPDType>(grad[i]);
+        if (clip_gradient >= 0.0f)
+          scaled_grad = mshadow_op::clip::Map(scaled_grad, clip_gradient);
+        const MPDType adj = mshadow_op::square::Map(scaled_grad);
+        mean[i]           = beta1 * (mean[i] - scaled_grad) + scaled_grad;
+        var[i]            = beta2 * (var[i] - adj) + adj;
+        w -= eta * (lr * mean[i] / (mshadow_op::square_root::Map(var[i]) + epsilon) + wd * w);
+        if (has_mixed_precision)
+          weight32[i] = w;
+        KERNEL_ASSIGN(out[i], treq, static_cast<DType>(w));
+      }
+    });
+  }
+
+  static inline void Forward(const nnvm::NodeAttrs& attrs,
+                             const OpContext& ctx,
+                             const std::vector<TBlob>& inputs,
+                             const std::vector<OpReqType>& req,
+                             const std::vector<TBlob>& outputs,
+                             const float rescale_grad) {
+    const MultiAdamWParam& p = nnvm::get<MultiAdamWParam>(attrs.parsed);
+    const int dtype          = outputs[0].type_flag_;
+    if (dtype == mshadow::kBfloat16) {
+      using MPDType = typename MPTypeChooser<mshadow::bfloat::bf16_t>::type;
+      CHECK((std::is_same<MPDType, float>::value))
+          << "bfloat16 weights are only supported by the multi-precision AdamW update";
+      Run<mshadow::bfloat::bf16_t, float>(p, inputs, req, outputs, rescale_grad);
+      return;
+    }
+    MSHADOW_REAL_TYPE_SWITCH(dtype, DType, {
+      using MPDType = typename MPTypeChooser<DType>::type;
+      Run<DType, MPDType>(p, inputs, req, outputs, rescale_grad);
+    });
+  }
+};
 
 template <typename xpu>
 static void GetScaleFloat(mshadow::Stream<xpu>* s, const TBlob& scale_blob, float* pScalef);
@@ -500,9 +581,10 @@ inline void multiMPUpdate(const nnvm::NodeAttrs& attrs,
     return;
 
   if (!MP)
-    MultiAdamWUpdate<xpu, Adam_type_identity, 4>(attrs, ctx, inputs_wo_scale, req, outputs, scalef);
+    MultiAdamWUpdate<xpu, Adam_type_identity, 4>::Forward(
+        attrs, ctx, inputs_wo_scale, req, outputs, scalef);
   else
-    MultiAdamWUpdate<xpu, Adam_single_precision, 5>(
+    MultiAdamWUpdate<xpu, Adam_single_precision, 5>::Forward(
         attrs, ctx, inputs_wo_scale, req, outputs, scalef);
 }
 
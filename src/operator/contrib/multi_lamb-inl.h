@@ -40,6 +40,7 @@
 #include "../tensor/init_op.h"
 #include "../tensor/util/tensor_util-inl.h"
 #include "multi_sum_sq-inl.h"
+#include "multi_tensor_chunk-inl.h"
 
 namespace mxnet {
 namespace op {
@@ -256,83 +257,100 @@ void CallKernel2(Stream<cpu>* s);
 template <typename MPDType, typename DType>
 void CallKernel2(Stream<gpu>* s);
 
+template <typename xpu, typename DType, typename MPDType, int input_stride>
+inline void MultiLAMBImpl(const nnvm::NodeAttrs& attrs,
+                          const OpContext& ctx,
+                          const std::vector<TBlob>& inputs,
+                          const std::vector<OpReqType>& req,
+                          const std::vector<TBlob>& outputs) {
+  auto param     = nnvm::get<MultiLAMBParam>(attrs.parsed);
+  Stream<xpu>* s = ctx.get_stream<xpu>();
+  MultiLAMBKernelParam<DType, MPDType> kernel_params;
+  FillMultiLAMBKernelParam<xpu, DType, MPDType, MultiLAMBParam, input_stride>(
+      attrs, ctx, inputs, outputs, &kernel_params);
+
+  // create vector of TBlob with all the weights contiguous to compute the norm
+  // if mixed precision, use fp32 copy
+  std::vector<TBlob> weights_for_norm;
+  int position_weights = 0;
+  if (!std::is_same<DType, MPDType>::value)
+    position_weights = input_stride - 1;
+  for (size_t index = 0; index < kernel_params.ntensors; ++index) {
+    weights_for_norm.emplace_back(inputs[index * input_stride + position_weights]);
+  }
+
+  // Calculate amount of temporary storage (temp_g, r1, r2, block_to_tensor, block_to_chunk)
+  size_t workspace_size = kernel_params.total_size * sizeof(float) +
+                          2 * kernel_params.ntensors * sizeof(float) +
+                          2 * kernel_params.nchunks * sizeof(int);
+  // take into account the required storage required within MultiSumSqRun
+  size_t required_storage_multi_sum_sq = 0;
+  required_storage_multi_sum_sq        = GetRequiredStorageMultiSumSq<xpu>(inputs);
+  workspace_size += required_storage_multi_sum_sq;
+
+  // Request temporary storage
+  Tensor<xpu, 1, char> workspace =
+      ctx.requested[multilamb::kTempSpace].get_space_typed<xpu, 1, char>(Shape1(workspace_size),
+                                                                         s);
+
+  // Create tensors
+  size_t pos_wspace = required_storage_multi_sum_sq;
+  Tensor<xpu, 1, float> temp_g(
+      reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.total_size), s);
+  // create vector of TBlob with all the temp_g contiguous
+  std::vector<TBlob> temp_g_tblobs;
+  for (size_t index = 0; index < kernel_params.ntensors; ++index) {
+    Tensor<xpu, 1, float> aux(
+        reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.sizes[index]), s);
+    TBlob newtblob(aux);
+    temp_g_tblobs.emplace_back(newtblob);
+    pos_wspace += kernel_params.sizes[index] * sizeof(float);
+  }
+  Tensor<xpu, 1, float> r1(
+      reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.ntensors), s);
+  pos_wspace += kernel_params.ntensors * sizeof(float);
+  Tensor<xpu, 1, float> r2(
+      reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.ntensors), s);
+  pos_wspace += kernel_params.ntensors * sizeof(float);
+  Tensor<xpu, 1, int> block_to_tensor(
+      reinterpret_cast<int*>(&workspace[pos_wspace]), Shape1(kernel_params.nchunks), s);
+  pos_wspace += kernel_params.nchunks * sizeof(int);
+  Tensor<xpu, 1, int> block_to_chunk(
+      reinterpret_cast<int*>(&workspace[pos_wspace]), Shape1(kernel_params.nchunks), s);
+
+  MultiSumSqRun<xpu>(weights_for_norm, kernel_params.ntensors, r1.dptr_, ctx);
+  CallKernel1<MPDType, DType>(
+      s, kernel_params, param, temp_g.dptr_, block_to_tensor.dptr_, block_to_chunk.dptr_);
+  MultiSumSqRun<xpu>(temp_g_tblobs, kernel_params.ntensors, r2.dptr_, ctx);
+  CallKernel2<MPDType, DType>(s,
+                              kernel_params,
+                              param,
+                              r1.dptr_,
+                              r2.dptr_,
+                              temp_g.dptr_,
+                              block_to_tensor.dptr_,
+                              block_to_chunk.dptr_,
+                              req[0]);
+}
+
 template <typename xpu, template <typename> class MPTypeChooser, int input_stride>
 inline void MultiLAMB(const nnvm::NodeAttrs& attrs,
                       const OpContext& ctx,
                       const std::vector<TBlob>& inputs,
                       const std::vector<OpReqType>& req,
                       const std::vector<TBlob>& outputs) {
-  auto param     = nnvm::get<MultiLAMBParam>(attrs.parsed);
-  Stream<xpu>* s = ctx.get_stream<xpu>();
-
-  MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
-    using MPDType = typename MPTypeChooser<DType>::type;
-    MultiLAMBKernelParam<DType, MPDType> kernel_params;
-    FillMultiLAMBKernelParam<xpu, DType, MPDType, MultiLAMBParam, input_stride>(
-        attrs, ctx, inputs, outputs, &kernel_params);
-
-    // create vector of TBlob with all the weights contiguous to compute the norm
-    // if mixed precision, use fp32 copy
-    std::vector<TBlob> weights_for_norm;
-    int position_weights = 0;
-    if (!std::is_same<DType, MPDType>::value)
-      position_weights = input_stride - 1;
-    for (size_t index = 0; index < kernel_params.ntensors; ++index) {
-      weights_for_norm.emplace_back(inputs[index * input_stride + position_weights]);
+  // bfloat16 weights are updated through their float32 master copies on CPU
+  if constexpr (std::is_same<xpu, cpu>::value &&
+                std::is_same<typename MPTypeChooser<mshadow::bfloat::bf16_t>::type, float>::value) {
+    if (inputs[0].type_flag_ == mshadow::kBfloat16) {
+      MultiLAMBImpl<xpu, mshadow::bfloat::bf16_t, float, input_stride>(
+          attrs, ctx, inputs, req, outputs);
+      return;
     }
-
-    // Calculate amount of temporary storage (temp_g, r1, r2, block_to_tensor, block_to_chunk)
-    size_t workspace_size = kernel_params.total_size * sizeof(float) +
-                            2 * kernel_params.ntensors * sizeof(float) +
-                            2 * kernel_params.nchunks * sizeof(int);
-    // take into account the required storage required within MultiSumSqRun
-    size_t required_storage_multi_sum_sq = 0;
-    required_storage_multi_sum_sq        = GetRequiredStorageMultiSumSq<xpu>(inputs);
-    workspace_size += required_storage_multi_sum_sq;
-
-    // Request temporary storage
-    Tensor<xpu, 1, char> workspace =
-        ctx.requested[multilamb::kTempSpace].get_space_typed<xpu, 1, char>(Shape1(workspace_size),
-                                                                           s);
-
-    // Create tensors
-    size_t pos_wspace = required_storage_multi_sum_sq;
-    Tensor<xpu, 1, float> temp_g(
-        reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.total_size), s);
-    // create vector of TBlob with all the temp_g contiguous
-    std::vector<TBlob> temp_g_tblobs;
-    for (size_t index = 0; index < kernel_params.ntensors; ++index) {
-      Tensor<xpu, 1, float> aux(
-          reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.sizes[index]), s);
-      TBlob newtblob(aux);
-      temp_g_tblobs.emplace_back(newtblob);
-      pos_wspace += kernel_params.sizes[index] * sizeof(float);
-    }
-    Tensor<xpu, 1, float> r1(
-        reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.ntensors), s);
-    pos_wspace += kernel_params.ntensors * sizeof(float);
-    Tensor<xpu, 1, float> r2(
-        reinterpret_cast<float*>(&workspace[pos_wspace]), Shape1(kernel_params.ntensors), s);
-    pos_wspace += kernel_params.ntensors * sizeof(float);
-    Tensor<xpu, 1, int> block_to_tensor(
-        reinterpret_cast<int*>(&workspace[pos_wspace]), Shape1(kernel_params.nchunks), s);
-    pos_wspace += kernel_params.nchunks * sizeof(int);
-    Tensor<xpu, 1, int> block_to_chunk(
-        reinterpret_cast<int*>(&workspace[pos_wspace]), Shape1(kernel_params.nchunks), s);
-
-    MultiSumSqRun<xpu>(weights_for_norm, kernel_params.ntensors, r1.dptr_, ctx);
-    CallKernel1<MPDType, DType>(
-        s, kernel_params, param, temp_g.dptr_, block_to_tensor.dptr_, block_to_chunk.dptr_);
-    MultiSumSqRun<xpu>(temp_g_tblobs, kernel_params.ntensors, r2.dptr_, ctx);
-    CallKernel2<MPDType, DType>(s,
-                                kernel_params,
-                                param,
-                                r1.dptr_,
-                                r2.dptr_,
-                                temp_g.dptr_,
-                                block_to_tensor.dptr_,
-                                block_to_chunk.dptr_,
-                                req[0]);
+  }
+  MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, DType, {
+    MultiLAMBImpl<xpu, DType, typename MPTypeChooser<DType>::type, input_stride>(
+        attrs, ctx, inputs, req, outputs);
   });
 }
 
@@ -24,102 +24,15 @@
  * \author Moises Hernandez
  */
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
 #include "./multi_lamb-inl.h"
 #include "../elemwise_op_common.h"
 
 namespace mxnet {
 namespace op {
 
-template <typename MPDType, bool has_mixed_precision>
-struct MultiLAMBKernelStep1 {
-  template <typename DType>
-  MSHADOW_XINLINE static void Map(int i,
-                                  const MultiLAMBKernelParam<DType, MPDType>& kernel_params,
-                                  const float beta1,
-                                  const float beta2,
-                                  const float epsilon,
-                                  const float clip_gradient,
-                                  const bool bias_correction,
-                                  const float rescale_grad,
-                                  float* temp_g) {
-    using namespace mshadow_op;
-    for (size_t index = 0; index < kernel_params.ntensors; ++index) {
-      if ((size_t)i < kernel_params.sizes[index]) {
-        MPDType w           = has_mixed_precision ? kernel_params.weights32[index][i]
-                                                  : MPDType(kernel_params.weights[index][i]);
-        MPDType scaled_grad = static_cast<MPDType>(kernel_params.grads[index][i]) * rescale_grad;
-        if (clip_gradient >= 0.0f)
-          scaled_grad = mshadow_op::clip::Map(scaled_grad, static_cast<MPDType>(clip_gradient));
-        MPDType mean = static_cast<MPDType>(beta1) * kernel_params.mean[index][i] +
-                       (static_cast<MPDType>(1.0f) - static_cast<MPDType>(beta1)) * scaled_grad;
-        MPDType var =
-            static_cast<MPDType>(beta2) * kernel_params.var[index][i] +
-            (static_cast<MPDType>(1.0f) - static_cast<MPDType>(beta2)) * scaled_grad * scaled_grad;
-        kernel_params.mean[index][i] = mean;
-        kernel_params.var[index][i]  = var;
-
-        MPDType g;
-        if (bias_correction) {
-          MPDType mean_hat =
-              mean / (static_cast<MPDType>(1.0f) -
-                      power::Map(static_cast<MPDType>(beta1),
-                                 static_cast<MPDType>(kernel_params.step_count[index])));
-          MPDType var_hat =
-              var / (static_cast<MPDType>(1.0f) -
-                     power::Map(static_cast<MPDType>(beta2),
-                                static_cast<MPDType>(kernel_params.step_count[index])));
-          g = mean_hat / (sqrt(var_hat) + static_cast<MPDType>(epsilon)) +
-              kernel_params.wds[index] * w;
-        } else {
-          g = mean / (sqrt(var) + static_cast<MPDType>(epsilon)) + kernel_params.wds[index] * w;
-        }
-        temp_g[kernel_params.tensor2temp_g[index] + i] = g;
-      }
-    }
-  }
-};
-
-template <typename MPDType, bool has_mixed_precision>
-struct MultiLAMBKernelStep2 {
-  template <typename DType>
-  MSHADOW_XINLINE static void Map(int i,
-                                  const MultiLAMBKernelParam<DType, MPDType>& kernel_params,
-                                  const float* sum_sq_weigths,
-                                  const float* sum_sq_temp_g,
-                                  const float* temp_g,
-                                  const float lower_bound,
-                                  const float upper_bound,
-                                  const OpReqType req) {
-    for (size_t index = 0; index < kernel_params.ntensors; ++index) {
-      if ((size_t)i < kernel_params.sizes[index]) {
-        MPDType w = has_mixed_precision ? kernel_params.weights32[index][i]
-                                        : MPDType(kernel_params.weights[index][i]);
-        float r1  = sqrt(sum_sq_weigths[index]);
-        float r2  = sqrt(sum_sq_temp_g[index]);
-        if (lower_bound >= 0)
-          r1 = std::max(r1, lower_bound);
-        if (upper_bound >= 0)
-          r1 = std::min(r1, upper_bound);
-
-        // calculate lamb_trust_ratio
-        MPDType r;
-        if (r1 == 0.0f || r2 == 0.0f)
-          r = 1.0f;
-        else
-          r = r1 / r2;
-
-        MPDType lr_adjusted = kernel_params.learning_rates[index] * r;
-        w -= lr_adjusted * temp_g[kernel_params.tensor2temp_g[index] + i];
-
-        // update weights
-        if (has_mixed_precision)
-          kernel_params.weights32[index][i] = w;
-        KERNEL_ASSIGN(kernel_params.out_data[index][i], req, w);
-      }
-    }
-  }
-};
-
 template <typename MPDType, typename DType>
 void CallKernel1(Stream<cpu>* s,
                  const MultiLAMBKernelParam<DType, MPDType>& kernel_params,
@@ -127,17 +40,43 @@ void CallKernel1(Stream<cpu>* s,
                  float* temp_g,
                  int* block_to_tensor,
                  int* block_to_chunk) {
-  Kernel<MultiLAMBKernelStep1<MPDType, !std::is_same<DType, MPDType>::value>, cpu>::Launch(
-      s,
-      kernel_params.max_size,
-      kernel_params,
-      param.beta1,
-      param.beta2,
-      param.epsilon,
-      param.clip_gradient,
-      param.bias_correction,
-      param.rescale_grad,
-      temp_g);
+  using namespace mshadow_op;
+  constexpr bool has_mixed_precision = !std::is_same<DType, MPDType>::value;
+  const MPDType beta1                = param.beta1;
+  const MPDType beta2                = param.beta2;
+  const MPDType epsilon              = param.epsilon;
+  const MPDType clip_gradient        = param.clip_gradient;
+  const MPDType rescale_grad         = param.rescale_grad;
+  const std::vector<size_t> sizes(kernel_params.sizes,
+                                  kernel_params.sizes + kernel_params.ntensors);
+  MultiTensorChunkedFor(sizes, [&](const int index, const size_t begin, const size_t end) {
+    const DType* weights = kernel_params.weights[index];
+    const DType* grads   = kernel_params.grads[index];
+    MPDType* mean_data   = kernel_params.mean[index];
+    MPDType* var_data    = kernel_params.var[index];
+    float* g             = temp_g + kernel_params.tensor2temp_g[index];
+    const MPDType wd     = kernel_params.wds[index];
+    const MPDType* weights32 = has_mixed_precision ? kernel_params.weights32[index] : nullptr;
+    // the bias corrections only depend on the step count of the tensor
+    MPDType mean_scale = 1.0f;
+    MPDType var_scale  = 1.0f;
+    if (param.bias_correction) {
+      const MPDType step = static_cast<MPDType>(kernel_params.step_count[index]);
+      mean_scale         = MPDType(1.0f) / (MPDType(1.0f) - power::Map(beta1, step));
+      var_scale          = MPDType(1.0f) / (MPDType(1.0f) - power::Map(beta2, step));
+    }
+    for (size_t i = begin; i < end; ++i) {
+      const MPDType w     = has_mixed_precision ? weights32[i] : MPDType(weights[i]);
+      MPDType scaled_grad = static_cast<MPDType>(grads[i]) * rescale_grad;
+      if (clip_gradient >= 0.0f)
+        scaled_grad = clip::Map(scaled_grad, clip_gradient);
+      const MPDType mean  = beta1 * mean_data[i] + (MPDType(1.0f) - beta1) * scaled_grad;
+      const MPDType var = beta2 * var_data[i] + (MPDType(1.0f) - beta2) * scaled_grad * scaled_grad;
+      mean_data[i]      = mean;
+      var_data[i]       = var;
+      g[i] = mean * mean_scale / (square_root::Map(var * var_scale) + epsilon) + wd * w;
+    }
+  });
 }
 
 template <typename MPDType, typename DType>
@@ -150,16 +89,35 @@ void CallKernel2(Stream<cpu>* s,
                  int* block_to_tensor,
                  int* block_to_chunk,
                  const OpReqType req) {
-  Kernel<MultiLAMBKernelStep2<MPDType, !std::is_same<DType, MPDType>::value>, cpu>::Launch(
-      s,
-      kernel_params.max_size,
-      kernel_params,
-      r1,
-      r2,
-      temp_g,
-      param.lower_bound,
-      param.upper_bound,
-      req);
+  constexpr bool has_mixed_precision = !std::is_same<DType, MPDType>::value;
+  // lamb trust ratio of every tensor
+  std::vector<MPDType> lrs_adjusted(kernel_params.ntensors);
+  for (size_t index = 0; index < kernel_params.ntensors; ++index) {
+    float norm_w = std::sqrt(r1[index]);
+    float norm_g = std::sqrt(r2[index]);
+    if (param.lower_bound >= 0)
+      norm_w = std::max(norm_w, param.lower_bound);
+    if (param.upper_bound >= 0)
+      norm_w = std::min(norm_w, param.upper_bound);
+    const MPDType r = (norm_w == 0.0f || norm_g == 0.0f) ? 1.0f : norm_w / norm_g;
+    lrs_adjusted[index] = kernel_params.learning_rates[index] * r;
+  }
+  const std::vector<size_t> sizes(kernel_params.sizes,
+                                  kernel_params.sizes + kernel_params.ntensors);
+  MultiTensorChunkedFor(sizes, [&](const int index, const size_t begin, const size_t end) {
+    const DType* weights      = kernel_params.weights[index];
+    DType* out_data           = kernel_params.out_data[index];
+    const float* g            = temp_g + kernel_params.tensor2temp_g[index];
+    const MPDType lr_adjusted = lrs_adjusted[index];
+    MPDType* weights32        = has_mixed_precision ? kernel_params.weights32[index] : nullptr;
+    for (size_t i = begin; i < end; ++i) {
+      MPDType w = has_mixed_precision ? weights32[i] : MPDType(weights[i]);
+      w -= lr_adjusted * g[i];
+      if (has_mixed_precision)
+        weights32[i] = w;
+      KERNEL_ASSIGN(out_data[i], req, static_cast<DType>(w));
+    }
+  });
 }
 
 DMLC_REGISTER_PARAMETER(MultiLAMBParam);
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file multi_tensor_chunk-inl.h
+ * \brief balanced work list for the CPU kernels of the multi-tensor optimizers
+ */
+
+#ifndef MXNET_OPERATOR_CONTRIB_MULTI_TENSOR_CHUNK_INL_H_
+#define MXNET_OPERATOR_CONTRIB_MULTI_TENSOR_CHUNK_INL_H_
+
+#include <algorithm>
+#include <vector>
+#include "../../engine/openmp.h"
+#include "../mxnet_op.h"
+
+namespace mxnet {
+namespace op {
+
+/*! \brief elements [begin, end) of the tensor `tensor` */
+struct MultiTensorChunk {
+  int tensor;
+  size_t begin;
+  size_t end;
+};
+
+/*!
+ * \brief Flatten the elements of all the tensors into one list of chunks of similar size.
+ *        A few chunks per thread keep the threads busy whatever the mix of tensor sizes,
+ *        while the minimal chunk size keeps the scheduling overhead of tiny tensors low.
+ */
+inline std::vector<MultiTensorChunk> MultiTensorChunks(const std::vector<size_t>& sizes,
+                                                       const int nthreads) {
+  const size_t kMinChunk        = 4096;
+  const size_t kChunksPerThread = 4;
+  size_t total                  = 0;
+  for (const size_t size : sizes) {
+    total += size;
+  }
+  const size_t nchunks    = std::max<size_t>(1, nthreads * kChunksPerThread);
+  const size_t chunk_size = std::max(kMinChunk, (total + nchunks - 1) / nchunks);
+  std::vector<MultiTensorChunk> chunks;
+  chunks.reserve(total / chunk_size + sizes.size());
+  for (size_t t = 0; t < sizes.size(); ++t) {
+    for (size_t begin = 0; begin < sizes[t]; begin += chunk_size) {
+      chunks.push_back({static_cast<int>(t), begin, std::min(sizes[t], begin + chunk_size)});
+    }
+  }
+  return chunks;
+}
+
+/*!
+ * \brief Run op(tensor, begin, end) over the balanced chunks of all the tensors in a single
+ *        OpenMP parallel region.
+ */
+template <typename OP>
+inline void MultiTensorChunkedFor(const std::vector<size_t>& sizes, OP op) {
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  const std::vector<MultiTensorChunk> chunks = MultiTensorChunks(sizes, omp_threads);
+  const index_t nchunks                      = chunks.size();
+#pragma omp parallel for num_threads(omp_threads) schedule(dynamic, 1) if (nchunks > 1)
+  for (index_t c = 0; c < nchunks; ++c) {
+    op(chunks[c].tensor, chunks[c].begin, chunks[c].end);
+  }
+}
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_CONTRIB_MULTI_TENSOR_CHUNK_INL_H_
@@ -234,6 +234,22 @@ void DiagMMImpl(const OpContext& ctx,
                                         transpose_lhs);
 }
 
+/*!
+ * \brief CPU version of DiagMMImpl. Instead of one thread per output element it walks
+ *        blocks of queries so that the key/value rows of the band are loaded once per
+ *        block, and computes the band with vectorized dot products (see transformer.cc).
+ */
+template <>
+void DiagMMImpl<cpu>(const OpContext& ctx,
+                     const TBlob& out,
+                     const TBlob& lhs,
+                     const TBlob& rhs,
+                     const TBlob& dilation,
+                     bool diagonal_lhs,
+                     bool transpose_lhs,
+                     int w,
+                     int w_right);
+
 template <typename xpu>
 void SldWinAttenScoreForward(const nnvm::NodeAttrs& attrs,
                              const OpContext& ctx,
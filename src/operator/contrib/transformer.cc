@@ -23,6 +23,7 @@
  * \brief CPU implementation of the operators used in Transformer
  */
 #include <mxnet/base.h>
+#include <algorithm>
 #include "./transformer-inl.h"
 #include "../tensor/elemwise_unary_op.h"
 
@@ -883,6 +884,218 @@ MXNET_OPERATOR_REGISTER_UNARY(_contrib_div_sqrt_dim)
     .set_attr<FCompute>("FCompute<cpu>", DivSqrtDimForward_<cpu>)
     .set_attr<nnvm::FGradient>("FGradient", ElemwiseGradUseNone{"_contrib_div_sqrt_dim"});
 
+namespace sldwin {
+
+// Number of consecutive queries processed by one task. Neighbouring queries attend to
+// overlapping key/value rows, so a block of queries reuses the same band from cache.
+constexpr index_t kQueryBlock = 32;
+
+/*!
+ * \brief Range [lo, hi) of window positions j for which the attended row
+ *        i + dilation * (j - offset) lies inside [0, seq_length).
+ */
+inline void ValidWindow(index_t i,
+                        index_t seq_length,
+                        index_t dilation,
+                        index_t offset,
+                        index_t w_len,
+                        index_t* lo,
+                        index_t* hi) {
+  *lo = std::max<index_t>(0, offset - i / dilation);
+  *hi = std::min<index_t>(w_len, offset + (seq_length - 1 - i) / dilation + 1);
+}
+
+/*!
+ * \brief Banded GEMM out = Q * K^T for the queries [begin, end) of one (batch, head) pair:
+ *        out[i, j] = <q_i, k_{i + dilation * (j - w)}>.
+ *        Four window positions are computed at once so that q_i is loaded once for them.
+ */
+inline void BandedQK(const float* q,
+                     const float* k,
+                     float* out,
+                     index_t row_stride,
+                     index_t out_stride,
+                     index_t begin,
+                     index_t end,
+                     index_t seq_length,
+                     index_t dilation,
+                     index_t w,
+                     index_t w_len,
+                     index_t dim) {
+  const index_t key_step = dilation * row_stride;
+  for (index_t i = begin; i < end; ++i) {
+    const float* qi = q + i * row_stride;
+    float* oi       = out + i * out_stride;
+    index_t lo, hi;
+    ValidWindow(i, seq_length, dilation, w, w_len, &lo, &hi);
+    std::fill(oi, oi + lo, 0.f);
+    std::fill(oi + hi, oi + w_len, 0.f);
+    index_t j = lo;
+    for (; j + 4 <= hi; j += 4) {
+      const float* k0 = k + (i + dilation * (j - w)) * row_stride;
+      const float* k1 = k0 + key_step;
+      const float* k2 = k1 + key_step;
+      const float* k3 = k2 + key_step;
+      float s0 = 0.f, s1 = 0.f, s2 = 0.f, s3 = 0.f;
+#pragma omp simd reduction(+ : s0, s1, s2, s3)
+      for (index_t d = 0; d < dim; ++d) {
+        s0 += qi[d] * k0[d];
+        s1 += qi[d] * k1[d];
+        s2 += qi[d] * k2[d];
+        s3 += qi[d] * k3[d];
+      }
+      oi[j]     = s0;
+      oi[j + 1] = s1;
+      oi[j + 2] = s2;
+      oi[j + 3] = s3;
+    }
+    for (; j < hi; ++j) {
+      const float* kj = k + (i + dilation * (j - w)) * row_stride;
+      float sum       = 0.f;
+#pragma omp simd reduction(+ : sum)
+      for (index_t d = 0; d < dim; ++d) {
+        sum += qi[d] * kj[d];
+      }
+      oi[j] = sum;
+    }
+  }
+}
+
+/*!
+ * \brief Banded GEMM out = P * V for the queries [begin, end) of one (batch, head) pair:
+ *        out_i = sum_j p(i, j) * v_{i + dilation * (j - offset)}, where p(i, j) is
+ *        score[i, j], or score[t, w_len - 1 - j] with t the attended row if transposed.
+ *        Four rows of V are accumulated per pass over out_i.
+ */
+template <bool transposed>
+inline void BandedPV(const float* p,
+                     const float* v,
+                     float* out,
+                     index_t p_stride,
+                     index_t row_stride,
+                     index_t begin,
+                     index_t end,
+                     index_t seq_length,
+                     index_t dilation,
+                     index_t offset,
+                     index_t w_len,
+                     index_t dim) {
+  const index_t value_step = dilation * row_stride;
+  auto weight              = [&](index_t i, index_t j) {
+    if (transposed) {
+      return p[(i + dilation * (j - offset)) * p_stride + (w_len - 1 - j)];
+    }
+    return p[i * p_stride + j];
+  };
+  for (index_t i = begin; i < end; ++i) {
+    float* oi = out + i * row_stride;
+    std::fill(oi, oi + dim, 0.f);
+    index_t lo, hi;
+    ValidWindow(i, seq_length, dilation, offset, w_len, &lo, &hi);
+    index_t j = lo;
+    for (; j + 4 <= hi; j += 4) {
+      const float* v0 = v + (i + dilation * (j - offset)) * row_stride;
+      const float* v1 = v0 + value_step;
+      const float* v2 = v1 + value_step;
+      const float* v3 = v2 + value_step;
+      const float a0 = weight(i, j), a1 = weight(i, j + 1);
+      const float a2 = weight(i, j + 2), a3 = weight(i, j + 3);
+#pragma omp simd
+      for (index_t d = 0; d < dim; ++d) {
+        oi[d] += a0 * v0[d] + a1 * v1[d] + a2 * v2[d] + a3 * v3[d];
+      }
+    }
+    for (; j < hi; ++j) {
+      const float* vj = v + (i + dilation * (j - offset)) * row_stride;
+      const float a   = weight(i, j);
+#pragma omp simd
+      for (index_t d = 0; d < dim; ++d) {
+        oi[d] += a * vj[d];
+      }
+    }
+  }
+}
+
+}  // namespace sldwin
+
+template <>
+void DiagMMImpl<cpu>(const OpContext& ctx,
+                     const TBlob& out,
+                     const TBlob& lhs,
+                     const TBlob& rhs,
+                     const TBlob& dilation,
+                     bool diagonal_lhs,
+                     bool transpose_lhs,
+                     int w,
+                     int w_right) {
+  using namespace mshadow;
+  using sldwin::kQueryBlock;
+  CHECK_EQ(out.type_flag_, kFloat32);
+  CHECK_EQ(lhs.type_flag_, kFloat32);
+  CHECK_EQ(rhs.type_flag_, kFloat32);
+  CHECK_EQ(dilation.type_flag_, kInt32);
+
+  const float* lhs_data        = lhs.dptr<float>();
+  const float* rhs_data        = rhs.dptr<float>();
+  const int32_t* dilation_data = dilation.dptr<int32_t>();
+  float* out_data              = out.dptr<float>();
+
+  const index_t batch_size   = lhs.shape_[0];
+  const index_t seq_length   = lhs.shape_[1];
+  const index_t num_heads    = lhs.shape_[2];
+  const index_t lhs_last_dim = lhs.shape_[3];
+  const index_t out_last_dim = out.shape_[3];
+  for (index_t h = 0; h < num_heads; ++h) {
+    CHECK_GT(dilation_data[h], 0) << "dilation must be positive, got " << dilation_data[h];
+  }
+
+  const index_t num_blocks = (seq_length + kQueryBlock - 1) / kQueryBlock;
+  const index_t num_tasks  = batch_size * num_heads * num_blocks;
+  const int omp_threads    = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t task = 0; task < num_tasks; ++task) {
+    const index_t b       = task / (num_heads * num_blocks);
+    const index_t h       = (task / num_blocks) % num_heads;
+    const index_t begin   = (task % num_blocks) * kQueryBlock;
+    const index_t end     = std::min(begin + kQueryBlock, seq_length);
+    const index_t dil     = dilation_data[h];
+    const index_t seq_off = b * seq_length * num_heads;
+    if (!diagonal_lhs) {
+      // lhs: query, rhs: key, out: score
+      const index_t dim   = lhs_last_dim;
+      const index_t w_len = out_last_dim;
+      sldwin::BandedQK(lhs_data + (seq_off + h) * dim,
+                       rhs_data + (seq_off + h) * dim,
+                       out_data + (seq_off + h) * w_len,
+                       num_heads * dim,
+                       num_heads * w_len,
+                       begin,
+                       end,
+                       seq_length,
+                       dil,
+                       w,
+                       w_len,
+                       dim);
+    } else {
+      // lhs: score, rhs and out: value-like tensors
+      const index_t w_len = lhs_last_dim;
+      const index_t dim   = out_last_dim;
+      const float* p      = lhs_data + (seq_off + h) * w_len;
+      const float* v      = rhs_data + (seq_off + h) * dim;
+      float* o            = out_data + (seq_off + h) * dim;
+      if (transpose_lhs) {
+        sldwin::BandedPV<true>(
+            p, v, o, num_heads * w_len, num_heads * dim, begin, end, seq_length, dil,
+            w_right, w_len, dim);
+      } else {
+        sldwin::BandedPV<false>(
+            p, v, o, num_heads * w_len, num_heads * dim, begin, end, seq_length, dil,
+            w, w_len, dim);
+      }
+    }
+  }
+}
+
 DMLC_REGISTER_PARAMETER(SldWinAttenParam);
 
 NNVM_REGISTER_OP(_contrib_sldwin_atten_mask_like)
@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file kernel_launch_tune.cc
+ * \brief Online tuning of the number of threads used by the CPU Kernel launches
+ */
+#include "./kernel_launch_tune.h"
+#include <dmlc/logging.h>
+#include <dmlc/parameter.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace mxnet {
+namespace op {
+
+namespace {
+
+inline int SizeBucket(size_t N) {
+  int bucket = 0;
+  while (N > 1 && bucket + 1 < KernelLaunchTuner::kNumBuckets) {
+    N >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace
+
+KernelLaunchTuner::Entry::Entry(KernelLaunchTuner* tuner, std::string key)
+    : tuner_(tuner), key_(std::move(key)) {}
+
+int KernelLaunchTuner::Entry::NumCandidates(int max_threads) {
+  int count = 1;
+  while ((1 << (count - 1)) < max_threads) {
+    ++count;
+  }
+  return count;
+}
+
+int KernelLaunchTuner::Entry::Candidate(int index, int max_threads) {
+  return std::min(1 << index, max_threads);
+}
+
+int KernelLaunchTuner::Entry::Threads(size_t N, int max_threads, int* trial) {
+  Bucket& bucket    = buckets_[SizeBucket(N)];
+  *trial            = -1;
+  const int threads = bucket.threads.load(std::memory_order_relaxed);
+  if (threads > 0) {
+    return std::min(threads, max_threads);
+  }
+  int bucket_max = 0;
+  if (!bucket.max_threads.compare_exchange_strong(bucket_max, max_threads)) {
+    if (max_threads < bucket_max) {
+      // fewer threads are available than when the timing started, do not time this launch
+      return max_threads;
+    }
+    max_threads = bucket_max;
+  }
+  const int ncandidates = NumCandidates(max_threads);
+  const int t           = bucket.next_trial.fetch_add(1);
+  if (t >= ncandidates * kTrialsPerCandidate) {
+    // every timed launch has been handed out, the bucket is about to settle
+    return max_threads;
+  }
+  *trial = t % ncandidates;
+  return Candidate(*trial, max_threads);
+}
+
+void KernelLaunchTuner::Entry::Record(size_t N, int trial, int64_t duration_ns) {
+  Bucket& bucket                = buckets_[SizeBucket(N)];
+  const int max_threads         = bucket.max_threads.load();
+  const int ncandidates         = NumCandidates(max_threads);
+  const double ns_per_iteration = static_cast<double>(duration_ns) / std::max<size_t>(N, 1);
+  {
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    if (bucket.best_ns.empty()) {
+      bucket.best_ns.assign(ncandidates, std::numeric_limits<double>::max());
+    }
+    bucket.best_ns[trial] = std::min(bucket.best_ns[trial], ns_per_iteration);
+    if (++bucket.recorded < ncandidates * kTrialsPerCandidate) {
+      return;
+    }
+    const int best = std::min_element(bucket.best_ns.begin(), bucket.best_ns.end()) -
+                     bucket.best_ns.begin();
+    bucket.threads.store(Candidate(best, max_threads));
+  }
+  tuner_->Save();
+}
+
+KernelLaunchTuner* KernelLaunchTuner::Get() {
+  static KernelLaunchTuner inst;
+  return &inst;
+}
+
+KernelLaunchTuner::KernelLaunchTuner() {
+  enabled_ = dmlc::GetEnv("MXNET_KERNEL_AUTOTUNE", false);
+  file_    = dmlc::GetEnv("MXNET_KERNEL_TUNING_FILE", std::string());
+  if (enabled_ && !file_.empty()) {
+    Load();
+  }
+}
+
+KernelLaunchTuner::Entry* KernelLaunchTuner::Register(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    return it->second.get();
+  }
+  Entry* entry = entries_.emplace(key, std::make_unique<Entry>(this, key)).first->second.get();
+  auto loaded  = loaded_.find(key);
+  if (loaded != loaded_.end()) {
+    for (const auto& bucket_threads : loaded->second) {
+      entry->buckets_[bucket_threads.first].threads.store(bucket_threads.second);
+    }
+  }
+  return entry;
+}
+
+void KernelLaunchTuner::Load() {
+  std::ifstream is(file_);
+  if (!is) {
+    return;
+  }
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::string key;
+    int bucket, threads;
+    if (fields >> key >> bucket >> threads && bucket >= 0 && bucket < kNumBuckets &&
+        threads > 0) {
+      loaded_[key].emplace_back(bucket, threads);
+    } else {
+      LOG(WARNING) << "Ignoring malformed line in kernel tuning file " << file_ << ": " << line;
+    }
+  }
+}
+
+void KernelLaunchTuner::Save() {
+  if (file_.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  os << "# kernel size_bucket threads\n";
+  for (const auto& key_entry : entries_) {
+    for (int b = 0; b < kNumBuckets; ++b) {
+      const int threads = key_entry.second->buckets_[b].threads.load();
+      if (threads > 0) {
+        os << key_entry.first << ' ' << b << ' ' << threads << '\n';
+      }
+    }
+  }
+  // keep the kernels of the file that were not used by this run
+  for (const auto& key_buckets : loaded_) {
+    if (entries_.count(key_buckets.first)) {
+      continue;
+    }
+    for (const auto& bucket_threads : key_buckets.second) {
+      os << key_buckets.first << ' ' << bucket_threads.first << ' ' << bucket_threads.second
+         << '\n';
+    }
+  }
+  const std::string tmp = file_ + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::trunc);
+    out << os.str();
+    if (!out) {
+      LOG(WARNING) << "Cannot write kernel tuning file " << tmp;
+      return;
+    }
+  }
+  if (std::rename(tmp.c_str(), file_.c_str()) != 0) {
+    LOG(WARNING) << "Cannot replace kernel tuning file " << file_;
+  }
+}
+
+}  // namespace op
+}  // namespace mxnet
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file kernel_launch_tune.h
+ * \brief Online tuning of the number of threads used by the CPU Kernel launches
+ */
+#ifndef MXNET_OPERATOR_KERNEL_LAUNCH_TUNE_H_
+#define MXNET_OPERATOR_KERNEL_LAUNCH_TUNE_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mxnet {
+namespace op {
+
+/*!
+ * \brief Picks the number of threads of Kernel<OP, cpu>::Launch from timings observed while
+ *        running, per kernel and per power-of-two bucket of the iteration count.
+ *
+ *        The first launches of a bucket are timed with 1, 2, 4, ... up to the recommended
+ *        number of threads, kTrialsPerCandidate times each. The fastest count per iteration
+ *        is kept from then on. The iterations are split into one contiguous chunk per
+ *        thread, so the thread count also fixes the chunk size.
+ *
+ *        Enabled by MXNET_KERNEL_AUTOTUNE=1. If MXNET_KERNEL_TUNING_FILE names a file, it
+ *        is loaded at start-up and rewritten whenever a bucket settles, so later runs skip
+ *        the timed launches.
+ */
+class KernelLaunchTuner {
+ public:
+  /*! \brief launches with N in [2^b, 2^(b+1)) iterations share bucket b */
+  static constexpr int kNumBuckets = 48;
+  /*! \brief timed launches per candidate thread count before a bucket settles */
+  static constexpr int kTrialsPerCandidate = 3;
+
+  /*! \brief Tuning state of one kernel */
+  class Entry {
+   public:
+    Entry(KernelLaunchTuner* tuner, std::string key);
+    /*!
+     * \brief Number of threads to run N iterations with
+     * \param N number of iterations
+     * \param max_threads number of threads recommended by engine::OpenMP
+     * \param trial set to the candidate index if the launch must be timed and reported
+     *        through Record(), -1 otherwise
+     */
+    int Threads(size_t N, int max_threads, int* trial);
+    /*! \brief report the duration of a timed launch of N iterations */
+    void Record(size_t N, int trial, int64_t duration_ns);
+
+   private:
+    friend class KernelLaunchTuner;
+    struct Bucket {
+      /*! \brief chosen number of threads, 0 while still timing the candidates */
+      std::atomic<int> threads{0};
+      /*! \brief number of timed launches handed out */
+      std::atomic<int> next_trial{0};
+      /*! \brief recommended number of threads when the bucket was first used */
+      std::atomic<int> max_threads{0};
+      std::mutex mutex;
+      /*! \brief number of timed launches reported */
+      int recorded = 0;
+      /*! \brief best time per iteration of each candidate */
+      std::vector<double> best_ns;
+    };
+    static int NumCandidates(int max_threads);
+    static int Candidate(int index, int max_threads);
+
+    KernelLaunchTuner* tuner_;
+    const std::string key_;
+    std::array<Bucket, kNumBuckets> buckets_;
+  };
+
+  static KernelLaunchTuner* Get();
+
+  bool enabled() const {
+    return enabled_;
+  }
+  /*! \brief Tuning state of the kernel identified by key, created on first use */
+  Entry* Register(const std::string& key);
+
+ private:
+  KernelLaunchTuner();
+  /*! \brief Load the settled buckets from the tuning file */
+  void Load();
+  /*! \brief Rewrite the tuning file with the settled buckets of all the kernels */
+  void Save();
+
+  bool enabled_;
+  std::string file_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Entry> > entries_;
+  /*! \brief (bucket, threads) pairs read from the tuning file, by kernel */
+  std::unordered_map<std::string, std::vector<std::pair<int, int> > > loaded_;
+};
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_KERNEL_LAUNCH_TUNE_H_
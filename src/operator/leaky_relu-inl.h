@@ -251,7 +251,7 @@ class LeakyReLUOp : public Operator {
       }
       case leakyrelu::kGELU: {
         MXNET_ASSIGN_REQ_SWITCH(req[leakyrelu::kOut], Req, {
-          mxnet_op::Kernel<mxnet_op::op_with_req<mshadow_op::gelu, Req>, xpu>::Launch(
+          mxnet_op::LaunchUnary<mshadow_op::gelu, Req>(
               s, out.size(0) * out.size(1) * out.size(2), out.dptr_, data.dptr_);
         });
         break;
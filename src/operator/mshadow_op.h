@@ -32,6 +32,7 @@
 #include "math_functions-inl.h"
 #include "special_functions-inl.h"
 #include "./operator_tune.h"
+#include "./vector_math-inl.h"
 #include "./contrib/erfinv-inl.h"
 
 #ifdef __CUDACC__
@@ -1892,6 +1893,28 @@ struct lcm : public mxnet_op::tunable {
 };
 #pragma GCC diagnostic pop
 
+/*!
+ * \brief vector_map<OP>::Map(float) approximates OP::Map with the branch-free functions of
+ *        vector_math-inl.h, for the ops that have one (vector_map<OP>::value is true)
+ */
+template <typename OP>
+struct vector_map : public std::false_type {};
+
+#define MXNET_VECTOR_MATH_OP(name)                  \
+  template <>                                       \
+  struct vector_map<name> : public std::true_type { \
+    static inline float Map(float a) {              \
+      return vector_math::name(a);                  \
+    }                                               \
+  }
+
+MXNET_VECTOR_MATH_OP(exp);
+MXNET_VECTOR_MATH_OP(log);
+MXNET_VECTOR_MATH_OP(tanh);
+MXNET_VECTOR_MATH_OP(erf);
+MXNET_VECTOR_MATH_OP(sigmoid);
+MXNET_VECTOR_MATH_OP(gelu);
+
 }  // namespace mshadow_op
 }  // namespace op
 }  // namespace mxnet
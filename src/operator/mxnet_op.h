@@ -32,8 +32,12 @@
 #include <mxnet/op_attr_types.h>
 #include <algorithm>
 #include <limits>
+#include <typeinfo>
 #include "./operator_tune.h"
+#include "./kernel_launch_tune.h"
+#include "./mshadow_op.h"
 #include "../engine/openmp.h"
+#include "../engine/thread_team.h"
 
 #ifdef __CUDACC__
 #include "../common/cuda/utils.h"
@@ -904,23 +908,16 @@ struct Kernel<OP, cpu> {
    */
   template <typename... Args>
   inline static bool Launch(mshadow::Stream<cpu>*, const size_t N, Args... args) {
-#ifdef _OPENMP
     const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
-    if (omp_threads < 2) {
+    if (omp_threads >= 2 && KernelLaunchTuner::Get()->enabled()) {
+      LaunchAutotuned(N, omp_threads, args...);
+    } else if (omp_threads < 2) {
       for (size_t i = 0; i < N; ++i) {
         OP::Map(i, args...);
       }
     } else {
-#pragma omp parallel for num_threads(omp_threads)
-      for (index_t i = 0; i < static_cast<index_t>(N); ++i) {
-        OP::Map(i, args...);
-      }
+      LaunchParallel(N, omp_threads, args...);
     }
-#else
-    for (size_t i = 0; i < N; ++i) {
-      OP::Map(i, args...);
-    }
-#endif
     return true;
   }
 
@@ -935,23 +932,26 @@ struct Kernel<OP, cpu> {
    */
   template <typename... Args>
   inline static bool LaunchDynamic(mshadow::Stream<cpu>*, const int64_t N, Args... args) {
-#ifdef _OPENMP
     const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount(false);
     if (omp_threads < 2) {
       for (int64_t i = 0; i < N; ++i) {
         OP::Map(i, args...);
       }
     } else {
+#ifdef _OPENMP
 #pragma omp parallel for num_threads(omp_threads) schedule(dynamic)
       for (int64_t i = 0; i < N; ++i) {
         OP::Map(i, args...);
       }
-    }
 #else
-    for (int64_t i = 0; i < N; ++i) {
-      OP::Map(i, args...);
-    }
+      engine::ThreadTeam::Get()->ParallelForDynamic(
+          N, omp_threads, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+              OP::Map(static_cast<int64_t>(i), args...);
+            }
+          });
 #endif
+    }
     return true;
   }
 
@@ -968,26 +968,72 @@ struct Kernel<OP, cpu> {
    */
   template <typename PRIMITIVE_OP, typename DType, typename... Args>
   static void LaunchTuned(mshadow::Stream<cpu>*, const size_t N, Args... args) {
-#ifdef _OPENMP
     const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
-    if (omp_threads < 2 ||
+    if (omp_threads >= 2 && KernelLaunchTuner::Get()->enabled()) {
+      LaunchAutotuned(N, omp_threads, args...);
+    } else if (omp_threads < 2 ||
         !tuned_op<PRIMITIVE_OP, DType>::UseOMP(N, static_cast<size_t>(omp_threads))) {
       for (size_t i = 0; i < N; ++i) {
         OP::Map(i, args...);
       }
     } else {
-#pragma omp parallel for num_threads(omp_threads)
-      for (index_t i = 0; i < static_cast<index_t>(N); ++i) {
-        OP::Map(i, args...);
-      }
+      LaunchParallel(N, omp_threads, args...);
     }
-#else
-    for (size_t i = 0; i < N; ++i) {
+  }
+
+  /*!
+   * \brief Run OP::Map over [0, N) on nthreads threads, with OpenMP when built with it and
+   *        on engine::ThreadTeam otherwise
+   * \tparam Args Varargs type to eventually pass to the OP::Map() function
+   * \param N Number of iterations
+   * \param nthreads Number of threads
+   * \param args Varargs to eventually pass to the OP::Map() function
+   */
+  template <typename... Args>
+  static void LaunchParallel(const size_t N, const int nthreads, Args... args) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads)
+    for (index_t i = 0; i < static_cast<index_t>(N); ++i) {
       OP::Map(i, args...);
     }
+#else
+    engine::ThreadTeam::Get()->ParallelFor(N, nthreads, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        OP::Map(i, args...);
+      }
+    });
 #endif
   }
 
+  /*!
+   * \brief Launch with the number of threads picked by KernelLaunchTuner for this kernel and
+   *        this size of N, timing the launch when the tuner asks for it
+   * \tparam Args Varargs type to eventually pass to the OP::Map() function
+   * \param N Number of iterations
+   * \param omp_threads Number of threads recommended by engine::OpenMP
+   * \param args Varargs to eventually pass to the OP::Map() function
+   */
+  template <typename... Args>
+  static void LaunchAutotuned(const size_t N, const int omp_threads, Args... args) {
+    // the signature names both the kernel and the types of its arguments
+    static KernelLaunchTuner::Entry* entry =
+        KernelLaunchTuner::Get()->Register(typeid(void (*)(OP*, Args...)).name());
+    int trial;
+    const int nthreads = entry->Threads(N, omp_threads, &trial);
+    const OperatorTuneBase::Tick start =
+        trial >= 0 ? OperatorTuneBase::Now() : OperatorTuneBase::Tick();
+    if (nthreads < 2) {
+      for (size_t i = 0; i < N; ++i) {
+        OP::Map(i, args...);
+      }
+    } else {
+      LaunchParallel(N, nthreads, args...);
+    }
+    if (trial >= 0) {
+      entry->Record(N, trial, OperatorTuneBase::GetDurationInNanoseconds(start));
+    }
+  }
+
   /*!
    * \brief Launch custom-tuned kernel where each thread is set to
    *        operate on a contiguous partition
@@ -997,20 +1043,22 @@ struct Kernel<OP, cpu> {
    */
   template <typename... Args>
   inline static void LaunchEx(mshadow::Stream<cpu>* s, const size_t N, Args... args) {
-#ifdef _OPENMP
     const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
     if (omp_threads < 2) {
       OP::Map(0, N, args...);
     } else {
+#ifdef _OPENMP
       const auto length = (N + omp_threads - 1) / omp_threads;
 #pragma omp parallel for num_threads(omp_threads)
       for (index_t i = 0; i < static_cast<index_t>(N); i += length) {
         OP::Map(i, i + length > N ? N - i : length, args...);
       }
-    }
 #else
-    OP::Map(0, N, args...);
+      engine::ThreadTeam::Get()->ParallelFor(N, omp_threads, [&](size_t begin, size_t end) {
+        OP::Map(begin, end - begin, args...);
+      });
 #endif
+    }
   }
 
   /*!
@@ -1136,6 +1184,59 @@ struct set_to_bool : public tunable {
  */
 using set_true  = set_to_bool<true>;
 using set_false = set_to_bool<false>;
+
+/*!
+ * \brief out = VOP::Map(in) on a block of kBlock elements, staged through a float buffer so
+ *        that the loop over VOP::Map vectorizes whatever the type of the data and even if out
+ *        and in alias
+ */
+template <typename VOP, int req>
+struct vector_op_with_req {
+  static constexpr index_t kBlock = 256;
+
+  template <typename DType>
+  static MSHADOW_CINLINE void Map(index_t b, DType* out, const DType* in, const index_t N) {
+    const index_t begin = b * kBlock;
+    const index_t n     = std::min(kBlock, N - begin);
+    float x[kBlock];
+    for (index_t i = 0; i < n; ++i) {
+      x[i] = static_cast<float>(in[begin + i]);
+    }
+    for (index_t i = 0; i < n; ++i) {
+      x[i] = VOP::Map(x[i]);
+    }
+    for (index_t i = 0; i < n; ++i) {
+      KERNEL_ASSIGN(out[begin + i], req, DType(x[i]));
+    }
+  }
+};
+
+/*! \brief out = OP(in) over N elements */
+template <typename OP, int req, typename xpu, typename DType>
+inline void LaunchUnary(mshadow::Stream<xpu>* s, const index_t N, DType* out, const DType* in) {
+  Kernel<op_with_req<OP, req>, xpu>::Launch(s, N, out, in);
+}
+
+/*!
+ * \brief out = OP(in) over N elements, through the vectorizable approximation of OP of
+ *        vector_math-inl.h for float32 and bfloat16 data when there is one.
+ *        MXNET_STRICT_MATH=1 keeps the functions of libm.
+ */
+template <typename OP, int req, typename DType>
+inline void LaunchUnary(mshadow::Stream<cpu>* s, const index_t N, DType* out, const DType* in) {
+  using VOP = mshadow_op::vector_map<OP>;
+  if constexpr (VOP::value && (std::is_same<DType, float>::value ||
+                               std::is_same<DType, mshadow::bfloat::bf16_t>::value)) {
+    static const bool strict = dmlc::GetEnv("MXNET_STRICT_MATH", false);
+    if (!strict) {
+      const index_t kBlock = vector_op_with_req<VOP, req>::kBlock;
+      Kernel<vector_op_with_req<VOP, req>, cpu>::Launch(s, (N + kBlock - 1) / kBlock, out, in, N);
+      return;
+    }
+  }
+  Kernel<op_with_req<OP, req>, cpu>::Launch(s, N, out, in);
+}
+
 }  // namespace mxnet_op
 
 }  // namespace op
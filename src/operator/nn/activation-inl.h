@@ -127,8 +127,7 @@ void ActivationForward(const OpContext& ctx,
   if (sz) {
     MSHADOW_REAL_TYPE_SWITCH(in_data.type_flag_, DType, {
       MXNET_ASSIGN_REQ_SWITCH(req, Req, {
-        mxnet_op::Kernel<mxnet_op::op_with_req<ForwardOp, Req>, xpu>::Launch(
-            s, sz, out_data.dptr<DType>(), in_data.dptr<DType>());
+        mxnet_op::LaunchUnary<ForwardOp, Req>(s, sz, out_data.dptr<DType>(), in_data.dptr<DType>());
       });
     });
   }
@@ -43,6 +43,7 @@
 #include "../operator_common.h"
 #include "../linalg.h"
 #include "./im2col.h"
+#include "./convolution_cpu-inl.h"
 
 namespace mxnet {
 namespace op {
@@ -246,6 +247,8 @@ class ConvolutionOp {
     CHECK_EQ(req[conv::kOut], kWriteTo);
     LayerSetUp(in_data[conv::kData].shape_, out_data[conv::kOut].shape_);
     Stream<xpu>* s = ctx.get_stream<xpu>();
+    const conv_cpu::ConvCPUAlgo algo =
+        SelectCPUAlgo(in_data[conv::kData].shape_, out_data[conv::kOut].shape_);
 
     // initialize weight and col_buffer 3D tensors for using gemm
     index_t M = conv_out_channels_ / group_;
@@ -256,8 +259,11 @@ class ConvolutionOp {
     Tensor<xpu, 4, DType> output_4d =
         out_data[conv::kOut].get_with_shape<xpu, 4, DType>(Shape4(num_, group_, M, N), s);
 
-    // no need to allocating memory and reordering in memory
-    if (is_1x1_) {
+    if (algo != conv_cpu::kIm2col) {
+      // native CPU algorithms without the column buffer
+      ForwardNative(ctx, algo, in_data, out_data);
+    } else if (is_1x1_) {
+      // no need to allocating memory and reordering in memory
       Tensor<xpu, 4, DType> input_4d =
           in_data[conv::kData].get_with_shape<xpu, 4, DType>(Shape4(num_, group_, K, N), s);
       for (index_t n = 0; n < num_; ++n) {
@@ -329,6 +335,8 @@ class ConvolutionOp {
     CHECK_EQ(in_data[conv::kWeight].CheckContiguous(), true);
     LayerSetUp(in_grad[conv::kData].shape_, out_grad[conv::kOut].shape_);
     Stream<xpu>* s = ctx.get_stream<xpu>();
+    const conv_cpu::ConvCPUAlgo algo =
+        SelectCPUAlgo(in_grad[conv::kData].shape_, out_grad[conv::kOut].shape_);
 
     // initialize weight and col_buffer 3D tensors for using gemm
     // For computing dLoss/d(in_data[kData])
@@ -343,8 +351,10 @@ class ConvolutionOp {
     Tensor<xpu, 3, DType> dweight_3d =
         in_grad[conv::kWeight].get_with_shape<xpu, 3, DType>(Shape3(group_, K, M), s);
 
-    // no need to allocating memory and reordering in memory
-    if (is_1x1_) {
+    if (algo == conv_cpu::kDepthwise) {
+      BackwardDepthwise(out_grad, in_data, req, in_grad);
+    } else if (is_1x1_) {
+      // no need to allocating memory and reordering in memory
       Tensor<xpu, 4, DType> input_4d =
           in_data[conv::kData].get_with_shape<xpu, 4, DType>(Shape4(num_, group_, M, N), s);
       Tensor<xpu, 4, DType> in_grad_4d =
@@ -423,6 +433,102 @@ class ConvolutionOp {
   }
 
  private:
+  /*!
+   * \brief The native CPU algorithm of the convolution, if it has one that is cheaper than
+   *        im2col + GEMM. Winograd convolutions run backward through im2col.
+   */
+  conv_cpu::ConvCPUAlgo SelectCPUAlgo(const mxnet::TShape& ishape, const mxnet::TShape& oshape) {
+    if constexpr (std::is_same<xpu, cpu>::value) {
+      return conv_cpu::SelectConvCPUAlgo<DType>(
+          param_.kernel, param_.stride, param_.dilate, ishape, oshape, group_, col_buffer_size_);
+    }
+    return conv_cpu::kIm2col;
+  }
+
+  conv_cpu::DepthwiseShape GetDepthwiseShape(const mxnet::TShape& ishape,
+                                             const mxnet::TShape& oshape) const {
+    return {ishape[0],
+            ishape[1],
+            oshape[1] / ishape[1],
+            ishape[2],
+            ishape[3],
+            oshape[2],
+            oshape[3],
+            param_.kernel[0],
+            param_.kernel[1],
+            param_.stride[0],
+            param_.stride[1],
+            param_.pad[0],
+            param_.pad[1],
+            param_.dilate[0],
+            param_.dilate[1]};
+  }
+
+  void ForwardNative(const OpContext& ctx,
+                     conv_cpu::ConvCPUAlgo algo,
+                     const std::vector<TBlob>& in_data,
+                     const std::vector<TBlob>& out_data) {
+    if constexpr (std::is_same<xpu, cpu>::value) {
+      using namespace conv_cpu;
+      mshadow::Stream<cpu>* s     = ctx.get_stream<cpu>();
+      const mxnet::TShape& ishape = in_data[conv::kData].shape_;
+      const mxnet::TShape& oshape = out_data[conv::kOut].shape_;
+      if (algo == kDepthwise) {
+        DepthwiseConv2dForward(GetDepthwiseShape(ishape, oshape),
+                               in_data[conv::kData].dptr<DType>(),
+                               in_data[conv::kWeight].dptr<DType>(),
+                               out_data[conv::kOut].dptr<DType>());
+        return;
+      }
+      auto winograd = [&](auto f) {
+        using F             = decltype(f);
+        const index_t tiles = WinogradTiles<F>(oshape[2], oshape[3]);
+        const index_t size =
+            WinogradWorkspaceSize<F>(channels_, conv_out_channels_, group_, tiles);
+        mshadow::Tensor<cpu, 1, DType> workspace =
+            ctx.requested[conv::kTempSpace].get_space_typed<cpu, 1, DType>(mshadow::Shape1(size),
+                                                                           s);
+        WinogradConv2dForward<F>(s,
+                                 in_data[conv::kData].dptr<DType>(),
+                                 in_data[conv::kWeight].dptr<DType>(),
+                                 out_data[conv::kOut].dptr<DType>(),
+                                 num_,
+                                 channels_,
+                                 ishape[2],
+                                 ishape[3],
+                                 conv_out_channels_,
+                                 oshape[2],
+                                 oshape[3],
+                                 group_,
+                                 param_.pad[0],
+                                 param_.pad[1],
+                                 workspace.dptr_);
+      };
+      if (algo == kWinograd4x4) {
+        winograd(WinogradF<4>());
+      } else {
+        winograd(WinogradF<2>());
+      }
+    }
+  }
+
+  void BackwardDepthwise(const std::vector<TBlob>& out_grad,
+                         const std::vector<TBlob>& in_data,
+                         const std::vector<OpReqType>& req,
+                         const std::vector<TBlob>& in_grad) {
+    if constexpr (std::is_same<xpu, cpu>::value) {
+      conv_cpu::DepthwiseConv2dBackward(
+          GetDepthwiseShape(in_grad[conv::kData].shape_, out_grad[conv::kOut].shape_),
+          out_grad[conv::kOut].dptr<DType>(),
+          in_data[conv::kData].dptr<DType>(),
+          in_data[conv::kWeight].dptr<DType>(),
+          in_grad[conv::kData].dptr<DType>(),
+          in_grad[conv::kWeight].dptr<DType>(),
+          req[conv::kData],
+          req[conv::kWeight]);
+    }
+  }
+
   void LayerSetUp(const mxnet::TShape& ishape, const mxnet::TShape& oshape) {
     channel_axis_                    = 1;  // hard code channel axis
     const index_t first_spatial_axis = channel_axis_ + 1;
@@ -0,0 +1,514 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file convolution_cpu-inl.h
+ * \brief Native CPU algorithms of 2D convolution which do not lower the input to a column
+ *        buffer: Winograd F(2x2, 3x3) and F(4x4, 3x3) for 3x3 stride 1 convolutions
+ *        (Lavin and Gray, https://arxiv.org/abs/1509.09308), and direct depthwise convolution.
+ */
+#ifndef MXNET_OPERATOR_NN_CONVOLUTION_CPU_INL_H_
+#define MXNET_OPERATOR_NN_CONVOLUTION_CPU_INL_H_
+
+#include <dmlc/parameter.h>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include "../mxnet_op.h"
+
+namespace mxnet {
+namespace op {
+namespace conv_cpu {
+
+enum ConvCPUAlgo { kIm2col, kDepthwise, kWinograd2x2, kWinograd4x4 };
+
+/*!
+ * \brief 1D transforms of Winograd F(m, 3), applied to the columns then to the rows of a tile.
+ *        Input: r = B^T d, Kernel: r = G g, Output: r = A^T t
+ */
+template <int m>
+struct WinogradF;
+
+template <>
+struct WinogradF<2> {
+  static const int kOut  = 2;
+  static const int kTile = 4;
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Input(const DType* d, int ds, DType* r, int rs) {
+    r[0]      = d[0] - d[2 * ds];
+    r[rs]     = d[ds] + d[2 * ds];
+    r[2 * rs] = d[2 * ds] - d[ds];
+    r[3 * rs] = d[ds] - d[3 * ds];
+  }
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Kernel(const DType* g, int gs, DType* r, int rs) {
+    r[0]      = g[0];
+    r[rs]     = DType(0.5f) * (g[0] + g[gs] + g[2 * gs]);
+    r[2 * rs] = DType(0.5f) * (g[0] - g[gs] + g[2 * gs]);
+    r[3 * rs] = g[2 * gs];
+  }
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Output(const DType* t, int ts, DType* r, int rs) {
+    r[0]  = t[0] + t[ts] + t[2 * ts];
+    r[rs] = t[ts] - t[2 * ts] - t[3 * ts];
+  }
+};
+
+template <>
+struct WinogradF<4> {
+  static const int kOut  = 4;
+  static const int kTile = 6;
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Input(const DType* d, int ds, DType* r, int rs) {
+    const DType d0 = d[0], d1 = d[ds], d2 = d[2 * ds], d3 = d[3 * ds], d4 = d[4 * ds];
+    r[0]      = DType(4) * d0 - DType(5) * d2 + d4;
+    r[rs]     = d3 + d4 - DType(4) * (d1 + d2);
+    r[2 * rs] = d4 - d3 + DType(4) * (d1 - d2);
+    r[3 * rs] = d4 - d2 + DType(2) * (d3 - d1);
+    r[4 * rs] = d4 - d2 + DType(2) * (d1 - d3);
+    r[5 * rs] = DType(4) * d1 - DType(5) * d3 + d[5 * ds];
+  }
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Kernel(const DType* g, int gs, DType* r, int rs) {
+    const DType g0 = g[0], g1 = g[gs], g2 = g[2 * gs];
+    r[0]      = g0 / DType(4);
+    r[rs]     = -(g0 + g1 + g2) / DType(6);
+    r[2 * rs] = -(g0 - g1 + g2) / DType(6);
+    r[3 * rs] = g0 / DType(24) + g1 / DType(12) + g2 / DType(6);
+    r[4 * rs] = g0 / DType(24) - g1 / DType(12) + g2 / DType(6);
+    r[5 * rs] = g2;
+  }
+
+  template <typename DType>
+  MSHADOW_XINLINE static void Output(const DType* t, int ts, DType* r, int rs) {
+    const DType sum13 = t[ts] + t[2 * ts], diff13 = t[ts] - t[2 * ts];
+    const DType sum24 = t[3 * ts] + t[4 * ts], diff24 = t[3 * ts] - t[4 * ts];
+    r[0]      = t[0] + sum13 + sum24;
+    r[rs]     = diff13 + DType(2) * diff24;
+    r[2 * rs] = sum13 + DType(4) * sum24;
+    r[3 * rs] = diff13 + DType(8) * diff24 + t[5 * ts];
+  }
+};
+
+/*!
+ * \brief U[xi][oc][ic] = (G w G^T)[xi] for the 3x3 weight of every (oc, ic) pair
+ * \param weight num_filter x channels_per_group x 3 x 3
+ */
+template <typename F, typename DType>
+void WinogradTransformWeight(const DType* weight, index_t num_filter, index_t channels, DType* U) {
+  const index_t filters = num_filter * channels;
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t f = 0; f < filters; ++f) {
+    const DType* g = weight + f * 9;
+    DType tmp[F::kTile * 3];
+    DType u[F::kTile * F::kTile];
+    for (int j = 0; j < 3; ++j) {
+      F::Kernel(g + j, 3, tmp + j, 3);
+    }
+    for (int i = 0; i < F::kTile; ++i) {
+      F::Kernel(tmp + i * 3, 1, u + i * F::kTile, 1);
+    }
+    for (int xi = 0; xi < F::kTile * F::kTile; ++xi) {
+      U[xi * filters + f] = u[xi];
+    }
+  }
+}
+
+/*!
+ * \brief V[xi][c][t] = (B^T d B)[xi] for the input tiles t0 <= t < t0 + T of every channel c
+ * \param data channels x height x width, zero padded by pad_h and pad_w
+ */
+template <typename F, typename DType>
+void WinogradTransformInput(const DType* data,
+                            index_t channels,
+                            index_t height,
+                            index_t width,
+                            index_t pad_h,
+                            index_t pad_w,
+                            index_t tiles_w,
+                            index_t t0,
+                            index_t T,
+                            DType* V) {
+  const index_t plane   = channels * T;
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t i = 0; i < plane; ++i) {
+    const index_t c  = i / T;
+    const index_t t  = t0 + i % T;
+    const index_t y0 = (t / tiles_w) * F::kOut - pad_h;
+    const index_t x0 = (t % tiles_w) * F::kOut - pad_w;
+    const DType* in  = data + c * height * width;
+    DType d[F::kTile * F::kTile];
+    for (int y = 0; y < F::kTile; ++y) {
+      for (int x = 0; x < F::kTile; ++x) {
+        const index_t iy    = y0 + y;
+        const index_t ix    = x0 + x;
+        const bool inside   = iy >= 0 && iy < height && ix >= 0 && ix < width;
+        d[y * F::kTile + x] = inside ? in[iy * width + ix] : DType(0);
+      }
+    }
+    DType tmp[F::kTile * F::kTile];
+    DType v[F::kTile * F::kTile];
+    for (int j = 0; j < F::kTile; ++j) {
+      F::Input(d + j, F::kTile, tmp + j, F::kTile);
+    }
+    for (int k = 0; k < F::kTile; ++k) {
+      F::Input(tmp + k * F::kTile, 1, v + k * F::kTile, 1);
+    }
+    for (int xi = 0; xi < F::kTile * F::kTile; ++xi) {
+      V[xi * plane + i] = v[xi];
+    }
+  }
+}
+
+/*!
+ * \brief Writes the output tiles t0 <= t < t0 + T of every filter, A^T M A of the products
+ *        M[xi][oc][t] of the transformed weights and inputs
+ * \param out num_filter x out_height x out_width
+ */
+template <typename F, typename DType>
+void WinogradTransformOutput(const DType* M,
+                             index_t num_filter,
+                             index_t out_height,
+                             index_t out_width,
+                             index_t tiles_w,
+                             index_t t0,
+                             index_t T,
+                             DType* out) {
+  const index_t plane   = num_filter * T;
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t i = 0; i < plane; ++i) {
+    const index_t oc = i / T;
+    const index_t t  = t0 + i % T;
+    const index_t y0 = (t / tiles_w) * F::kOut;
+    const index_t x0 = (t % tiles_w) * F::kOut;
+    DType m[F::kTile * F::kTile];
+    for (int xi = 0; xi < F::kTile * F::kTile; ++xi) {
+      m[xi] = M[xi * plane + i];
+    }
+    DType tmp[F::kOut * F::kTile];
+    DType o[F::kOut * F::kOut];
+    for (int j = 0; j < F::kTile; ++j) {
+      F::Output(m + j, F::kTile, tmp + j, F::kTile);
+    }
+    for (int k = 0; k < F::kOut; ++k) {
+      F::Output(tmp + k * F::kTile, 1, o + k * F::kOut, 1);
+    }
+    DType* to = out + oc * out_height * out_width;
+    for (int y = 0; y < F::kOut && y0 + y < out_height; ++y) {
+      for (int x = 0; x < F::kOut && x0 + x < out_width; ++x) {
+        to[(y0 + y) * out_width + x0 + x] = o[y * F::kOut + x];
+      }
+    }
+  }
+}
+
+/*! \brief Number of m x m output tiles of Winograd F(m x m, 3 x 3) */
+template <typename F>
+inline index_t WinogradTiles(index_t out_height, index_t out_width) {
+  return ((out_height + F::kOut - 1) / F::kOut) * ((out_width + F::kOut - 1) / F::kOut);
+}
+
+/*! \brief Number of input tiles transformed at once by the Winograd convolution */
+const index_t kWinogradTileBlock = 128;
+
+/*! \brief Elements of workspace of the Winograd convolution of one group of filters */
+template <typename F>
+inline index_t WinogradWorkspaceSize(index_t channels,
+                                     index_t num_filter,
+                                     index_t group,
+                                     index_t tiles) {
+  const index_t T = std::min(tiles, kWinogradTileBlock);
+  return F::kTile * F::kTile * (num_filter * channels / group + (channels + num_filter) * T);
+}
+
+/*!
+ * \brief 3x3 stride 1 convolution of a batch of images by Winograd F(m x m, 3 x 3).
+ *        The input is transformed by blocks of kWinogradTileBlock tiles, and the element-wise
+ *        products of the transforms are kTile x kTile GEMMs per group and block.
+ * \param workspace at least WinogradWorkspaceSize elements
+ */
+template <typename F, typename DType>
+void WinogradConv2dForward(mshadow::Stream<cpu>* s,
+                           const DType* data,
+                           const DType* weight,
+                           DType* out,
+                           index_t num,
+                           index_t channels,
+                           index_t height,
+                           index_t width,
+                           index_t num_filter,
+                           index_t out_height,
+                           index_t out_width,
+                           index_t group,
+                           index_t pad_h,
+                           index_t pad_w,
+                           DType* workspace) {
+  using mshadow::Shape2;
+  using mshadow::Tensor;
+  const int kTiles         = F::kTile * F::kTile;
+  const index_t ic         = channels / group;
+  const index_t oc         = num_filter / group;
+  const index_t tiles_w    = (out_width + F::kOut - 1) / F::kOut;
+  const index_t tiles      = WinogradTiles<F>(out_height, out_width);
+  const index_t tile_block = std::min(tiles, kWinogradTileBlock);
+  DType* U                 = workspace;
+  DType* V                 = U + kTiles * num_filter * ic;
+  DType* M                 = V + kTiles * channels * tile_block;
+  WinogradTransformWeight<F>(weight, num_filter, ic, U);
+  for (index_t n = 0; n < num; ++n) {
+    const DType* image = data + n * channels * height * width;
+    DType* image_out   = out + n * num_filter * out_height * out_width;
+    for (index_t t0 = 0; t0 < tiles; t0 += tile_block) {
+      const index_t T = std::min(tile_block, tiles - t0);
+      WinogradTransformInput<F>(image, channels, height, width, pad_h, pad_w, tiles_w, t0, T, V);
+      for (int xi = 0; xi < kTiles; ++xi) {
+        for (index_t g = 0; g < group; ++g) {
+          Tensor<cpu, 2, DType> u(U + (xi * num_filter + g * oc) * ic, Shape2(oc, ic), s);
+          Tensor<cpu, 2, DType> v(V + (xi * channels + g * ic) * T, Shape2(ic, T), s);
+          Tensor<cpu, 2, DType> m(M + (xi * num_filter + g * oc) * T, Shape2(oc, T), s);
+          linalg_gemm(u, v, m, false, false, s);
+        }
+      }
+      WinogradTransformOutput<F>(M, num_filter, out_height, out_width, tiles_w, t0, T, image_out);
+    }
+  }
+}
+
+/*! \brief Range [*begin, *end) of the outputs x whose input x * stride + offset is in [0, size) */
+inline void DepthwiseValidRange(index_t offset,
+                                index_t stride,
+                                index_t size,
+                                index_t out_size,
+                                index_t* begin,
+                                index_t* end) {
+  *begin = offset >= 0 ? 0 : (stride - offset - 1) / stride;
+  *end   = size - offset <= 0 ? 0 : std::min(out_size, (size - offset - 1) / stride + 1);
+}
+
+/*! \brief Geometry of a 2D depthwise convolution: one input channel per group */
+struct DepthwiseShape {
+  index_t num, channels, multiplier, height, width, out_height, out_width;
+  index_t kernel_h, kernel_w, stride_h, stride_w, pad_h, pad_w, dilate_h, dilate_w;
+};
+
+/*!
+ * \brief Direct depthwise convolution. Each output channel oc reads the input channel
+ *        oc / multiplier, and every output row is accumulated from the kernel_h x kernel_w
+ *        shifted input rows, which is a contiguous loop for stride 1.
+ */
+template <typename DType>
+void DepthwiseConv2dForward(const DepthwiseShape& p,
+                            const DType* data,
+                            const DType* weight,
+                            DType* out) {
+  const index_t num_filter = p.channels * p.multiplier;
+  const index_t planes     = p.num * num_filter;
+  const int omp_threads    = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t i = 0; i < planes; ++i) {
+    const index_t n  = i / num_filter;
+    const index_t oc = i % num_filter;
+    const DType* in  = data + (n * p.channels + oc / p.multiplier) * p.height * p.width;
+    const DType* w   = weight + oc * p.kernel_h * p.kernel_w;
+    DType* to        = out + i * p.out_height * p.out_width;
+    std::fill(to, to + p.out_height * p.out_width, DType(0));
+    for (index_t ky = 0; ky < p.kernel_h; ++ky) {
+      index_t oy_begin, oy_end;
+      DepthwiseValidRange(
+          ky * p.dilate_h - p.pad_h, p.stride_h, p.height, p.out_height, &oy_begin, &oy_end);
+      for (index_t kx = 0; kx < p.kernel_w; ++kx) {
+        const index_t offset = kx * p.dilate_w - p.pad_w;
+        const DType wv       = w[ky * p.kernel_w + kx];
+        index_t ox_begin, ox_end;
+        DepthwiseValidRange(offset, p.stride_w, p.width, p.out_width, &ox_begin, &ox_end);
+        for (index_t oy = oy_begin; oy < oy_end; ++oy) {
+          const DType* row = in + (oy * p.stride_h + ky * p.dilate_h - p.pad_h) * p.width + offset;
+          DType* to_row    = to + oy * p.out_width;
+          if (p.stride_w == 1) {
+            for (index_t ox = ox_begin; ox < ox_end; ++ox) {
+              to_row[ox] += wv * row[ox];
+            }
+          } else {
+            for (index_t ox = ox_begin; ox < ox_end; ++ox) {
+              to_row[ox] += wv * row[ox * p.stride_w];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/*!
+ * \brief Gradients of the direct depthwise convolution. The input gradient of a channel is
+ *        scattered from the output gradients of its multiplier filters, and the weight gradient
+ *        of a filter is reduced over the batch, so neither needs synchronization.
+ */
+template <typename DType>
+void DepthwiseConv2dBackward(const DepthwiseShape& p,
+                             const DType* out_grad,
+                             const DType* data,
+                             const DType* weight,
+                             DType* in_grad,
+                             DType* weight_grad,
+                             OpReqType req_data,
+                             OpReqType req_weight) {
+  const index_t num_filter = p.channels * p.multiplier;
+  const index_t in_plane   = p.height * p.width;
+  const index_t out_plane  = p.out_height * p.out_width;
+  const int omp_threads    = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  if (req_data != kNullOp) {
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t i = 0; i < p.num * p.channels; ++i) {
+      const index_t n = i / p.channels;
+      const index_t c = i % p.channels;
+      DType* to       = in_grad + i * in_plane;
+      if (req_data != kAddTo) {
+        std::fill(to, to + in_plane, DType(0));
+      }
+      for (index_t j = 0; j < p.multiplier; ++j) {
+        const index_t oc  = c * p.multiplier + j;
+        const DType* from = out_grad + (n * num_filter + oc) * out_plane;
+        const DType* w    = weight + oc * p.kernel_h * p.kernel_w;
+        for (index_t ky = 0; ky < p.kernel_h; ++ky) {
+          index_t oy_begin, oy_end;
+          DepthwiseValidRange(
+              ky * p.dilate_h - p.pad_h, p.stride_h, p.height, p.out_height, &oy_begin, &oy_end);
+          for (index_t kx = 0; kx < p.kernel_w; ++kx) {
+            const index_t offset = kx * p.dilate_w - p.pad_w;
+            const DType wv       = w[ky * p.kernel_w + kx];
+            index_t ox_begin, ox_end;
+            DepthwiseValidRange(offset, p.stride_w, p.width, p.out_width, &ox_begin, &ox_end);
+            for (index_t oy = oy_begin; oy < oy_end; ++oy) {
+              DType* row =
+                  to + (oy * p.stride_h + ky * p.dilate_h - p.pad_h) * p.width + offset;
+              const DType* from_row = from + oy * p.out_width;
+              for (index_t ox = ox_begin; ox < ox_end; ++ox) {
+                row[ox * p.stride_w] += wv * from_row[ox];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  if (req_weight != kNullOp) {
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t oc = 0; oc < num_filter; ++oc) {
+      const index_t c = oc / p.multiplier;
+      for (index_t ky = 0; ky < p.kernel_h; ++ky) {
+        index_t oy_begin, oy_end;
+        DepthwiseValidRange(
+            ky * p.dilate_h - p.pad_h, p.stride_h, p.height, p.out_height, &oy_begin, &oy_end);
+        for (index_t kx = 0; kx < p.kernel_w; ++kx) {
+          const index_t offset = kx * p.dilate_w - p.pad_w;
+          index_t ox_begin, ox_end;
+          DepthwiseValidRange(offset, p.stride_w, p.width, p.out_width, &ox_begin, &ox_end);
+          DType sum = 0;
+          for (index_t n = 0; n < p.num; ++n) {
+            const DType* in   = data + (n * p.channels + c) * in_plane;
+            const DType* from = out_grad + (n * num_filter + oc) * out_plane;
+            for (index_t oy = oy_begin; oy < oy_end; ++oy) {
+              const DType* row =
+                  in + (oy * p.stride_h + ky * p.dilate_h - p.pad_h) * p.width + offset;
+              const DType* from_row = from + oy * p.out_width;
+              for (index_t ox = ox_begin; ox < ox_end; ++ox) {
+                sum += from_row[ox] * row[ox * p.stride_w];
+              }
+            }
+          }
+          KERNEL_ASSIGN(weight_grad[(oc * p.kernel_h + ky) * p.kernel_w + kx], req_weight, sum);
+        }
+      }
+    }
+  }
+}
+
+/*!
+ * \brief Picks the CPU convolution algorithm of a 2D NCHW convolution by a rough count of the
+ *        multiply-adds of each: depthwise convolutions always run directly, 3x3 stride 1
+ *        convolutions use the cheapest of im2col + GEMM and the two Winograd variants whose
+ *        workspace is not larger than the column buffer. MXNET_CPU_CONV_NATIVE=0 disables both.
+ * \param col_buffer_size elements of the im2col column buffer of one image
+ */
+template <typename DType>
+ConvCPUAlgo SelectConvCPUAlgo(const mxnet::TShape& kernel,
+                              const mxnet::TShape& stride,
+                              const mxnet::TShape& dilate,
+                              const mxnet::TShape& ishape,
+                              const mxnet::TShape& oshape,
+                              index_t group,
+                              index_t col_buffer_size) {
+  // read on every call, so that the native kernels can be switched off in process
+  if (kernel.ndim() != 2 || !std::is_floating_point<DType>::value ||
+      !dmlc::GetEnv("MXNET_CPU_CONV_NATIVE", true)) {
+    return kIm2col;
+  }
+  const index_t channels   = ishape[1];
+  const index_t num_filter = oshape[1];
+  const index_t ic         = channels / group;
+  const index_t oc         = num_filter / group;
+  if (ic == 1) {
+    return kDepthwise;
+  }
+  if (kernel[0] != 3 || kernel[1] != 3 || stride[0] != 1 || stride[1] != 1 || dilate[0] != 1 ||
+      dilate[1] != 1) {
+    return kIm2col;
+  }
+  // per image: the GEMM and the copy into the column buffer
+  const double pixels = static_cast<double>(oshape[2]) * oshape[3];
+  ConvCPUAlgo best    = kIm2col;
+  double best_cost    = pixels * 9 * ic * (oc + 1) * group;
+  // per image: the kTile x kTile GEMMs, the input and output transforms at roughly two scalar
+  // operations per add, and the weight transform amortized over the batch
+  auto winograd_cost = [&](auto f, double input_ops, double output_ops) {
+    using F              = decltype(f);
+    const index_t tiles  = WinogradTiles<F>(oshape[2], oshape[3]);
+    const double weights = static_cast<double>(F::kTile * F::kTile) * num_filter * ic;
+    if (WinogradWorkspaceSize<F>(channels, num_filter, group, tiles) > col_buffer_size) {
+      return best_cost;
+    }
+    return tiles * (weights + 2 * (input_ops * channels + output_ops * num_filter)) +
+           2 * weights / ishape[0];
+  };
+  const double cost2 = winograd_cost(WinogradF<2>(), 32, 30);
+  if (cost2 < best_cost) {
+    best      = kWinograd2x2;
+    best_cost = cost2;
+  }
+  const double cost4 = winograd_cost(WinogradF<4>(), 288, 160);
+  if (cost4 < best_cost) {
+    best = kWinograd4x4;
+  }
+  return best;
+}
+
+}  // namespace conv_cpu
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_NN_CONVOLUTION_CPU_INL_H_
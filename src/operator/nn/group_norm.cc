@@ -61,6 +61,149 @@ static bool GroupNormShape(const nnvm::NodeAttrs& attrs,
   return true;
 }
 
+/*
+CPU backward kernel of group normalization, in two passes.
+The data is batch x (groups x group_channels) x spatial, and each of the batch x groups
+instances is normalized over its group_channels x spatial values:
+
+\bar{x} = (x - mean) / std
+w = og * gamma / std
+grad_x = w - mean(w, instance) - \bar{x} * mean(w * \bar{x}, instance)
+grad_gamma = sum(\bar{x} og, exclude channel axis)
+grad_beta = sum(og, exclude channel axis)
+
+The first pass splits the instances into nblocks contiguous blocks processed in parallel. Each
+instance is read once to reduce the means and to accumulate the per channel terms of grad_gamma
+and grad_beta into the partial sums of its block, then grad_x is written. The second pass adds up
+the partial sums of the blocks, which are 2 x channels per block.
+*/
+template <int req_data, typename DType, typename AType>
+void GroupNormBackwardCPUKernel(const index_t batch,
+                                const index_t groups,
+                                const index_t group_channels,
+                                const index_t spatial,
+                                const DType* ograd,
+                                const DType* data,
+                                const DType* gamma,
+                                const DType* mean,
+                                const DType* std,
+                                DType* data_grad,
+                                DType* gamma_grad,
+                                DType* beta_grad,
+                                const OpReqType req_gamma,
+                                const OpReqType req_beta,
+                                const int nblocks,
+                                AType* partial) {
+  const index_t channels      = groups * group_channels;
+  const index_t instances     = batch * groups;
+  const index_t instance_size = group_channels * spatial;
+#pragma omp parallel for num_threads(nblocks)
+  for (int b = 0; b < nblocks; ++b) {
+    AType* gamma_partial = partial + 2 * b * channels;
+    AType* beta_partial  = gamma_partial + channels;
+    std::fill(gamma_partial, gamma_partial + 2 * channels, AType(0));
+    const index_t begin = instances * b / nblocks;
+    const index_t end   = instances * (b + 1) / nblocks;
+    for (index_t j = begin; j < end; ++j) {
+      const index_t first_channel = (j % groups) * group_channels;
+      const AType mean_value      = mean[j];
+      const AType inv_std         = 1.f / static_cast<AType>(std[j]);
+      AType sum_w                 = 0.f;
+      AType sum_w_x               = 0.f;
+      for (index_t k = 0; k < group_channels; ++k) {
+        const DType* from = data + j * instance_size + k * spatial;
+        const DType* grad = ograd + j * instance_size + k * spatial;
+        const AType scale = static_cast<AType>(gamma[first_channel + k]) * inv_std;
+        AType sum_og_x    = 0.f;
+        AType sum_og      = 0.f;
+#pragma omp simd reduction(+ : sum_w, sum_w_x, sum_og_x, sum_og)
+        for (index_t i = 0; i < spatial; ++i) {
+          const AType x_hat = (static_cast<AType>(from[i]) - mean_value) * inv_std;
+          const AType og    = grad[i];
+          sum_w += og * scale;
+          sum_w_x += og * scale * x_hat;
+          sum_og_x += og * x_hat;
+          sum_og += og;
+        }
+        gamma_partial[first_channel + k] += sum_og_x;
+        beta_partial[first_channel + k] += sum_og;
+      }
+      if (req_data == kNullOp) {
+        continue;
+      }
+      const AType mean_w   = sum_w / instance_size;
+      const AType mean_w_x = sum_w_x / instance_size;
+      for (index_t k = 0; k < group_channels; ++k) {
+        const DType* from = data + j * instance_size + k * spatial;
+        const DType* grad = ograd + j * instance_size + k * spatial;
+        DType* to         = data_grad + j * instance_size + k * spatial;
+        const AType scale = static_cast<AType>(gamma[first_channel + k]) * inv_std;
+#pragma omp simd
+        for (index_t i = 0; i < spatial; ++i) {
+          const AType x_hat = (static_cast<AType>(from[i]) - mean_value) * inv_std;
+          const AType w     = static_cast<AType>(grad[i]) * scale;
+          KERNEL_ASSIGN(to[i], req_data, static_cast<DType>(w - mean_w - x_hat * mean_w_x));
+        }
+      }
+    }
+  }
+  if (req_gamma == kNullOp && req_beta == kNullOp) {
+    return;
+  }
+#pragma omp parallel for num_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount())
+  for (index_t c = 0; c < channels; ++c) {
+    AType sum_gamma = 0.f;
+    AType sum_beta  = 0.f;
+    for (int b = 0; b < nblocks; ++b) {
+      sum_gamma += partial[2 * b * channels + c];
+      sum_beta += partial[(2 * b + 1) * channels + c];
+    }
+    KERNEL_ASSIGN(gamma_grad[c], req_gamma, static_cast<DType>(sum_gamma));
+    KERNEL_ASSIGN(beta_grad[c], req_beta, static_cast<DType>(sum_beta));
+  }
+}
+
+static void GroupNormGradComputeCPU(const nnvm::NodeAttrs& attrs,
+                                    const OpContext& ctx,
+                                    const std::vector<TBlob>& inputs,
+                                    const std::vector<OpReqType>& req,
+                                    const std::vector<TBlob>& outputs) {
+  using namespace mshadow;
+  CHECK_EQ(inputs.size(), 5U);
+  CHECK_EQ(outputs.size(), 3U);
+  const GroupNormParam& param = nnvm::get<GroupNormParam>(attrs.parsed);
+  const TBlob& data           = inputs[1];
+  const mxnet::TShape& dshape = data.shape_;
+  const index_t batch         = dshape[0];
+  const index_t groups        = param.num_groups;
+  const index_t spatial       = dshape.ProdShape(2, dshape.ndim());
+  const int nblocks           = static_cast<int>(std::max<index_t>(
+      1,
+      std::min<index_t>(engine::OpenMP::Get()->GetRecommendedOMPThreadCount(), batch * groups)));
+  MSHADOW_REAL_TYPE_SWITCH_EX(data.type_flag_, DType, AType, {
+    Tensor<cpu, 1, AType> partial = ctx.requested[0].get_space_typed<cpu, 1, AType>(
+        Shape1(2 * nblocks * dshape[1]), ctx.get_stream<cpu>());
+    MXNET_REQ_TYPE_SWITCH(req[0], Req, {
+      GroupNormBackwardCPUKernel<Req>(batch,
+                                      groups,
+                                      dshape[1] / groups,
+                                      spatial,
+                                      inputs[0].dptr<DType>(),
+                                      data.dptr<DType>(),
+                                      inputs[2].dptr<DType>(),
+                                      inputs[3].dptr<DType>(),
+                                      inputs[4].dptr<DType>(),
+                                      outputs[0].dptr<DType>(),
+                                      outputs[1].dptr<DType>(),
+                                      outputs[2].dptr<DType>(),
+                                      req[1],
+                                      req[2],
+                                      nblocks,
+                                      partial.dptr_);
+    });
+  });
+}
+
 NNVM_REGISTER_OP(GroupNorm)
     .add_alias("_npx_group_norm")
     .describe(R"code(Group normalization.
@@ -127,7 +270,7 @@ NNVM_REGISTER_OP(_backward_GroupNorm)
     .set_num_outputs(3)
     .set_attr<nnvm::TIsBackward>("TIsBackward", true)
     .set_attr_parser(ParamParser<GroupNormParam>)
-    .set_attr<FCompute>("FCompute<cpu>", GroupNormGradCompute<cpu>)
+    .set_attr<FCompute>("FCompute<cpu>", GroupNormGradComputeCPU)
     .set_attr<FResourceRequest>("FResourceRequest", [](const NodeAttrs& n) {
       return std::vector<ResourceRequest>{ResourceRequest::kTempSpace};
     });
@@ -120,8 +120,11 @@ static bool LayerNormShape(const nnvm::NodeAttrs& attrs,
  */
 template <typename Data,
           typename Accum = typename
-          /* By default accumulate in float32 for float16.  Otherwise use same type. */
-          std::conditional<std::is_same<mshadow::half::half_t, Data>::value, float, Data>::type>
+          /* By default accumulate in float32 for float16 and bfloat16.  Otherwise use same type. */
+          std::conditional<std::is_same<mshadow::half::half_t, Data>::value ||
+                               std::is_same<mshadow::bfloat::bf16_t, Data>::value,
+                           float,
+                           Data>::type>
 void LayerNormCPUKernel(size_t width,
                         size_t instances,
                         Data eps,
@@ -195,16 +198,16 @@ bool LayerNormCPU(const nnvm::NodeAttrs& attrs,
   if (axis != inputs[layernorm::kData].ndim() - 1) {
     return false;
   }
-  MSHADOW_REAL_TYPE_SWITCH(inputs[layernorm::kData].type_flag_, DType, {
-    LayerNormCPUKernel<DType>(inputs[layernorm::kData].shape_[axis],
-                              outputs[layernorm::kMean].Size(),
-                              param.eps,
-                              inputs[layernorm::kData].dptr<DType>(),
-                              inputs[layernorm::kGamma].dptr<DType>(),
-                              inputs[layernorm::kBeta].dptr<DType>(),
-                              outputs[layernorm::kOut].dptr<DType>(),
-                              outputs[layernorm::kMean].dptr<DType>(),
-                              outputs[layernorm::kStd].dptr<DType>());
+  MSHADOW_REAL_TYPE_SWITCH_EX(inputs[layernorm::kData].type_flag_, DType, AType, {
+    LayerNormCPUKernel<DType, AType>(inputs[layernorm::kData].shape_[axis],
+                                     outputs[layernorm::kMean].Size(),
+                                     param.eps,
+                                     inputs[layernorm::kData].dptr<DType>(),
+                                     inputs[layernorm::kGamma].dptr<DType>(),
+                                     inputs[layernorm::kBeta].dptr<DType>(),
+                                     outputs[layernorm::kOut].dptr<DType>(),
+                                     outputs[layernorm::kMean].dptr<DType>(),
+                                     outputs[layernorm::kStd].dptr<DType>());
   });
   return true;
 }
@@ -407,13 +410,151 @@ void LayerNormGradComputeGeneralImpl<cpu>(const nnvm::NodeAttrs& attrs,
   }
 }
 
+/* CPU optimized backward kernel for LayerNorm assuming axis = -1.
+ * Data and Accum are as in LayerNormCPUKernel.
+ *
+ *   \bar{x} = (x - mean) / std
+ *   w = ograd * gamma / std
+ *   grad_x = w - mean(w) - \bar{x} * mean(w * \bar{x})
+ *   grad_gamma = sum(ograd * \bar{x}), grad_beta = sum(ograd) over the instances
+ *
+ * The first pass splits the instances into nblocks contiguous blocks processed in parallel.
+ * Each instance is read once to reduce mean(w) and mean(w * \bar{x}) and to accumulate its
+ * terms of grad_gamma and grad_beta into the partial sums of its block, then its grad_x is
+ * written while it is still in cache. The second pass adds up the partial sums of the blocks.
+ *
+ * partial is 2 x width per block: grad_gamma then grad_beta.
+ * data_grad can be the same as ograd.
+ */
+template <int req_data, typename Data, typename Accum>
+void LayerNormBackwardCPUKernel(size_t width,
+                                size_t instances,
+                                const Data* ograd,
+                                const Data* data,
+                                const Data* gamma,
+                                const Data* mean,
+                                const Data* std,
+                                Data* data_grad,
+                                Data* gamma_grad,
+                                Data* beta_grad,
+                                OpReqType req_gamma,
+                                OpReqType req_beta,
+                                int nblocks,
+                                Accum* partial) {
+  const mshadow::index_t signed_instances = static_cast<mshadow::index_t>(instances);
+  const mshadow::index_t signed_width     = static_cast<mshadow::index_t>(width);
+#pragma omp parallel for num_threads(nblocks)
+  for (int b = 0; b < nblocks; ++b) {
+    Accum* gamma_partial = partial + 2 * b * width;
+    Accum* beta_partial  = gamma_partial + width;
+    std::fill(gamma_partial, gamma_partial + 2 * width, Accum(0));
+    const mshadow::index_t begin = signed_instances * b / nblocks;
+    const mshadow::index_t end   = signed_instances * (b + 1) / nblocks;
+    for (mshadow::index_t j = begin; j < end; ++j) {
+      const Data* from       = data + j * width;
+      const Data* grad       = ograd + j * width;
+      const Accum mean_value = mean[j];
+      const Accum inv_sigma  = 1.f / static_cast<Accum>(std[j]);
+
+      // Reduce w and w * \bar{x}, accumulate the parameter gradients of the block.
+      Accum sum_w   = 0.f;
+      Accum sum_w_x = 0.f;
+#pragma omp simd reduction(+ : sum_w, sum_w_x)
+      for (size_t i = 0; i < width; ++i) {
+        const Accum x_hat = (static_cast<Accum>(from[i]) - mean_value) * inv_sigma;
+        const Accum og    = grad[i];
+        const Accum w     = og * static_cast<Accum>(gamma[i]) * inv_sigma;
+        sum_w += w;
+        sum_w_x += w * x_hat;
+        gamma_partial[i] += og * x_hat;
+        beta_partial[i] += og;
+      }
+      if (req_data == kNullOp) {
+        continue;
+      }
+
+      // Write the data gradient.
+      const Accum mean_w   = sum_w / width;
+      const Accum mean_w_x = sum_w_x / width;
+      Data* to             = data_grad + j * width;
+#pragma omp simd
+      for (size_t i = 0; i < width; ++i) {
+        const Accum x_hat = (static_cast<Accum>(from[i]) - mean_value) * inv_sigma;
+        const Accum og    = grad[i];
+        const Accum w     = og * static_cast<Accum>(gamma[i]) * inv_sigma;
+        KERNEL_ASSIGN(to[i], req_data, static_cast<Data>(w - mean_w - x_hat * mean_w_x));
+      }
+    }
+  }
+  if (req_gamma == kNullOp && req_beta == kNullOp) {
+    return;
+  }
+  // Add up the partial sums of the blocks.
+#pragma omp parallel for num_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount())
+  for (mshadow::index_t i = 0; i < signed_width; ++i) {
+    Accum sum_gamma = 0.f;
+    Accum sum_beta  = 0.f;
+    for (int b = 0; b < nblocks; ++b) {
+      sum_gamma += partial[2 * b * width + i];
+      sum_beta += partial[(2 * b + 1) * width + i];
+    }
+    KERNEL_ASSIGN(gamma_grad[i], req_gamma, static_cast<Data>(sum_gamma));
+    KERNEL_ASSIGN(beta_grad[i], req_beta, static_cast<Data>(sum_beta));
+  }
+}
+
+/* Wrap the above LayerNormBackwardCPUKernel in MXNet's API.  Returns true if it
+ * is able to run.
+ */
+bool LayerNormGradCPU(const nnvm::NodeAttrs& attrs,
+                      const OpContext& ctx,
+                      const std::vector<TBlob>& inputs,
+                      const std::vector<OpReqType>& req,
+                      const std::vector<TBlob>& outputs) {
+  using namespace mshadow;
+  const LayerNormParam& param = nnvm::get<LayerNormParam>(attrs.parsed);
+  const TBlob& data           = inputs[layernorm::kBwdData];
+  // Axis must be the last one.
+  int axis = GetRealAxis(param.axis, data.ndim());
+  if (axis != data.ndim() - 1) {
+    return false;
+  }
+  const size_t width     = data.shape_[axis];
+  const size_t instances = inputs[layernorm::kBwdMean].Size();
+  const int nblocks      = static_cast<int>(std::max<size_t>(
+      1, std::min<size_t>(engine::OpenMP::Get()->GetRecommendedOMPThreadCount(), instances)));
+  MSHADOW_REAL_TYPE_SWITCH_EX(data.type_flag_, DType, AType, {
+    Tensor<cpu, 1, AType> partial = ctx.requested[0].get_space_typed<cpu, 1, AType>(
+        Shape1(2 * nblocks * width), ctx.get_stream<cpu>());
+    MXNET_REQ_TYPE_SWITCH(req[layernorm::kBwdDataGrad], Req, {
+      LayerNormBackwardCPUKernel<Req>(width,
+                                      instances,
+                                      inputs[layernorm::kBwdOutGrad].dptr<DType>(),
+                                      data.dptr<DType>(),
+                                      inputs[layernorm::kBwdGamma].dptr<DType>(),
+                                      inputs[layernorm::kBwdMean].dptr<DType>(),
+                                      inputs[layernorm::kBwdStd].dptr<DType>(),
+                                      outputs[layernorm::kBwdDataGrad].dptr<DType>(),
+                                      outputs[layernorm::kBwdGammaGrad].dptr<DType>(),
+                                      outputs[layernorm::kBwdBetaGrad].dptr<DType>(),
+                                      req[layernorm::kBwdGammaGrad],
+                                      req[layernorm::kBwdBetaGrad],
+                                      nblocks,
+                                      partial.dptr_);
+    });
+  });
+  return true;
+}
+
 template <>
 void LayerNormGradCompute<cpu>(const nnvm::NodeAttrs& attrs,
                                const OpContext& ctx,
                                const std::vector<TBlob>& inputs,
                                const std::vector<OpReqType>& req,
                                const std::vector<TBlob>& outputs) {
-  return LayerNormGradComputeGeneral<cpu>(attrs, ctx, inputs, req, outputs);
+  if (LayerNormGradCPU(attrs, ctx, inputs, req, outputs))
+    return;
+  LayerNormGradComputeGeneral<cpu>(attrs, ctx, inputs, req, outputs);
 }
 
 #if MXNET_USE_ONEDNN == 1
@@ -0,0 +1,252 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file log_softmax_nll-inl.h
+ * \brief Negative log-likelihood of log_softmax fused into a single operator, which never
+ *        materializes the probabilities
+ */
+#ifndef MXNET_OPERATOR_NN_LOG_SOFTMAX_NLL_INL_H_
+#define MXNET_OPERATOR_NN_LOG_SOFTMAX_NLL_INL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "./softmax-inl.h"
+
+namespace mxnet {
+namespace op {
+
+namespace log_softmax_nll {
+enum LogSoftmaxNLLOpInputs { kData, kLabel };
+enum LogSoftmaxNLLOpOutputs { kOut, kLogSumExp };
+}  // namespace log_softmax_nll
+
+/*!
+ * \brief Rows of the data are [leading, M, trailing] with the softmax axis in the middle:
+ *        row r starts at (r / trailing) * M * trailing + r % trailing with a stride of trailing
+ */
+MSHADOW_XINLINE index_t log_softmax_nll_row_base(index_t r, index_t M, index_t trailing) {
+  return (r / trailing) * M * trailing + r % trailing;
+}
+
+/*! \brief loss of the row x[0], x[stride], ... x[(M - 1) * stride] with label l */
+template <int req, typename CType, typename DType, typename OType>
+inline void log_softmax_nll_row(const DType* row,
+                                const index_t l,
+                                OType* loss,
+                                CType* lse,
+                                const index_t M,
+                                const index_t stride,
+                                const CType scale) {
+  CType max;
+  double sum;
+  mxnet_op::OnlineSoftmaxStats<false>(row, M, stride, scale, &max, &sum);
+  const CType log_sum = static_cast<CType>(std::log(sum));
+  *lse                = max * scale + log_sum;
+  KERNEL_ASSIGN(*loss, req, OType((max - static_cast<CType>(row[l * stride])) * scale + log_sum));
+}
+
+/*!
+ * \brief loss = logsumexp(x * scale) - x[label] * scale for every row x of the data, keeping
+ *        the log-sum-exp of the rows for the backward pass. One read of the data per row.
+ */
+template <int req, typename CType, typename DType, typename IType, typename OType>
+inline void LogSoftmaxNLLForward(const DType* data,
+                                 const IType* label,
+                                 OType* loss,
+                                 CType* lse,
+                                 const index_t nrows,
+                                 const index_t M,
+                                 const index_t trailing,
+                                 const CType scale) {
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t r = 0; r < nrows; ++r) {
+    const DType* row = data + log_softmax_nll_row_base(r, M, trailing);
+    const index_t l  = std::min(std::max<index_t>(static_cast<index_t>(label[r]), 0), M - 1);
+    // a literal stride lets the compiler vectorize the contiguous rows
+    if (trailing == 1) {
+      log_softmax_nll_row<req>(row, l, loss + r, lse + r, M, 1, scale);
+    } else {
+      log_softmax_nll_row<req>(row, l, loss + r, lse + r, M, trailing, scale);
+    }
+  }
+}
+
+/*! \brief gradient of the row x[0], x[stride], ... x[(M - 1) * stride] with label l */
+template <int req, typename CType, typename DType>
+inline void log_softmax_nll_grad_row(const DType* row,
+                                     const index_t l,
+                                     DType* row_grad,
+                                     const index_t M,
+                                     const index_t stride,
+                                     const CType g,
+                                     const CType lse,
+                                     const CType scale) {
+  for (index_t j = 0; j < M; ++j) {
+    const CType p = vector_math::exp(static_cast<CType>(row[j * stride]) * scale - lse);
+    KERNEL_ASSIGN(row_grad[j * stride], req, DType(g * p));
+  }
+  row_grad[l * stride] -= DType(g);
+}
+
+/*!
+ * \brief grad = ograd * scale * (softmax(x * scale) - onehot(label)) for every row x of the
+ *        data, with the softmax recomputed from the saved log-sum-exp
+ */
+template <int req, typename CType, typename DType, typename IType, typename OType>
+inline void LogSoftmaxNLLBackward(const OType* ograd,
+                                  const DType* data,
+                                  const IType* label,
+                                  const CType* lse,
+                                  DType* grad,
+                                  const index_t nrows,
+                                  const index_t M,
+                                  const index_t trailing,
+                                  const CType scale) {
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t r = 0; r < nrows; ++r) {
+    const index_t base = log_softmax_nll_row_base(r, M, trailing);
+    const index_t l    = std::min(std::max<index_t>(static_cast<index_t>(label[r]), 0), M - 1);
+    const CType g      = static_cast<CType>(ograd[r]) * scale;
+    if (trailing == 1) {
+      log_softmax_nll_grad_row<req>(data + base, l, grad + base, M, 1, g, lse[r], scale);
+    } else {
+      log_softmax_nll_grad_row<req>(data + base, l, grad + base, M, trailing, g, lse[r], scale);
+    }
+  }
+}
+
+inline bool LogSoftmaxNLLOpShape(const nnvm::NodeAttrs& attrs,
+                                 mxnet::ShapeVector* in_attrs,
+                                 mxnet::ShapeVector* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 2U);
+  CHECK_EQ(out_attrs->size(), 2U);
+  const SoftmaxParam& param = nnvm::get<SoftmaxParam>(attrs.parsed);
+  CHECK(!param.use_length.value()) << "log_softmax_nll does not support use_length";
+  const mxnet::TShape& dshape = (*in_attrs)[log_softmax_nll::kData];
+  if (!ndim_is_known(dshape))
+    return false;
+  mxnet::TShape oshape = ReduceAxisShapeImpl(dshape, dmlc::optional<int>(param.axis), false);
+  SHAPE_ASSIGN_CHECK(*in_attrs, log_softmax_nll::kLabel, oshape);
+  SHAPE_ASSIGN_CHECK(*out_attrs, log_softmax_nll::kOut, oshape);
+  SHAPE_ASSIGN_CHECK(*out_attrs, log_softmax_nll::kLogSumExp, oshape);
+  return shape_is_known(oshape);
+}
+
+inline bool LogSoftmaxNLLOpType(const nnvm::NodeAttrs& attrs,
+                                std::vector<int>* in_attrs,
+                                std::vector<int>* out_attrs) {
+  CHECK_EQ(in_attrs->size(), 2U);
+  CHECK_EQ(out_attrs->size(), 2U);
+  CHECK_NE((*in_attrs)[log_softmax_nll::kLabel], -1)
+      << "Label type must be set for log_softmax_nll operator";
+  const SoftmaxParam& param = nnvm::get<SoftmaxParam>(attrs.parsed);
+  const int dtype           = (*in_attrs)[log_softmax_nll::kData];
+  if (softmax_has_dtype_override(attrs)) {
+    TYPE_ASSIGN_CHECK(*out_attrs, log_softmax_nll::kOut, param.dtype.value());
+  } else {
+    TYPE_ASSIGN_CHECK(*out_attrs, log_softmax_nll::kOut, dtype);
+  }
+  if (dtype == -1)
+    return false;
+  // the log-sum-exp is kept in the type the exponentials are computed in
+  TYPE_ASSIGN_CHECK(*out_attrs,
+                    log_softmax_nll::kLogSumExp,
+                    dtype == mshadow::kFloat64 ? mshadow::kFloat64 : mshadow::kFloat32);
+  return (*out_attrs)[log_softmax_nll::kOut] != -1;
+}
+
+template <typename xpu>
+void LogSoftmaxNLLCompute(const nnvm::NodeAttrs& attrs,
+                          const OpContext& ctx,
+                          const std::vector<TBlob>& inputs,
+                          const std::vector<OpReqType>& req,
+                          const std::vector<TBlob>& outputs) {
+  using namespace mxnet_op;
+  const TBlob& data = inputs[log_softmax_nll::kData];
+  if (data.Size() == 0U)
+    return;
+  const SoftmaxParam& param = nnvm::get<SoftmaxParam>(attrs.parsed);
+  int axis                  = CheckAxis(param.axis, data.ndim());
+  const double temperature  = param.temperature.has_value() ? param.temperature.value() : 1.0;
+  const mxnet::TShape shape = AxisShapeCompact(data.shape_, &axis, false);
+  MSHADOW_REAL_TYPE_SWITCH(data.type_flag_, DType, {
+    using CType = softmax_compute_t<DType>;
+    MSHADOW_REAL_TYPE_SWITCH(outputs[log_softmax_nll::kOut].type_flag_, OType, {
+      MSHADOW_TYPE_SWITCH(inputs[log_softmax_nll::kLabel].type_flag_, IType, {
+        // the log-sum-exp is needed by the backward pass even if the loss is not
+        MXNET_REQ_TYPE_SWITCH(req[log_softmax_nll::kOut], Req, {
+          LogSoftmaxNLLForward<Req>(data.dptr<DType>(),
+                                    inputs[log_softmax_nll::kLabel].dptr<IType>(),
+                                    outputs[log_softmax_nll::kOut].dptr<OType>(),
+                                    outputs[log_softmax_nll::kLogSumExp].dptr<CType>(),
+                                    shape[0] * shape[2],
+                                    shape[1],
+                                    shape[2],
+                                    static_cast<CType>(1.0 / temperature));
+        });
+      });
+    });
+  });
+}
+
+template <typename xpu>
+void LogSoftmaxNLLGradCompute(const nnvm::NodeAttrs& attrs,
+                              const OpContext& ctx,
+                              const std::vector<TBlob>& inputs,
+                              const std::vector<OpReqType>& req,
+                              const std::vector<TBlob>& outputs) {
+  using namespace mxnet_op;
+  // inputs: ograd, data, label, log-sum-exp
+  const TBlob& data = inputs[1];
+  if (req[0] == kNullOp || data.Size() == 0U)
+    return;
+  const SoftmaxParam& param = nnvm::get<SoftmaxParam>(attrs.parsed);
+  int axis                  = CheckAxis(param.axis, data.ndim());
+  const double temperature  = param.temperature.has_value() ? param.temperature.value() : 1.0;
+  const mxnet::TShape shape = AxisShapeCompact(data.shape_, &axis, false);
+  MSHADOW_REAL_TYPE_SWITCH(data.type_flag_, DType, {
+    using CType = softmax_compute_t<DType>;
+    // the gradient of the loss has the type of the loss, which dtype may override
+    MSHADOW_REAL_TYPE_SWITCH(inputs[0].type_flag_, OType, {
+      MSHADOW_TYPE_SWITCH(inputs[2].type_flag_, IType, {
+        MXNET_ASSIGN_REQ_SWITCH(req[0], Req, {
+          LogSoftmaxNLLBackward<Req>(inputs[0].dptr<OType>(),
+                                     data.dptr<DType>(),
+                                     inputs[2].dptr<IType>(),
+                                     inputs[3].dptr<CType>(),
+                                     outputs[0].dptr<DType>(),
+                                     shape[0] * shape[2],
+                                     shape[1],
+                                     shape[2],
+                                     static_cast<CType>(1.0 / temperature));
+        });
+      });
+    });
+  });
+}
+
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_NN_LOG_SOFTMAX_NLL_INL_H_
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file log_softmax_nll.cc
+ * \brief CPU Implementation of log_softmax_nll
+ */
+#include "./log_softmax_nll-inl.h"
+#include "../elemwise_op_common.h"
+
+namespace mxnet {
+namespace op {
+
+NNVM_REGISTER_OP(log_softmax_nll)
+    .add_alias("_npx_log_softmax_nll")
+    .describe(R"code(Computes the negative log-likelihood of the labels under the log softmax
+of the input, i.e. ``-pick(log_softmax(data, axis), label, axis)``, without materializing the
+softmax. The data is read once per row in the forward pass and the gradient is written in a
+single pass in the backward pass, which matters for large vocabularies.
+
+The label is the index along ``axis`` of the expected class, of the shape of ``data`` without
+``axis``. Out of range labels are clipped. ``temperature`` scales the data as in ``log_softmax``.
+
+Example::
+
+  x = [[1, 2, 3],
+       [11, 7, 5]]
+
+  label = [2, 0]
+
+  log_softmax_nll(x, label) = [0.40760596, 0.02058114]
+
+)code" ADD_FILELINE)
+    .set_attr_parser(ParamParser<SoftmaxParam>)
+    .set_num_inputs(2)
+    .set_num_outputs(2)
+    .set_attr<nnvm::FNumVisibleOutputs>("FNumVisibleOutputs",
+                                        [](const NodeAttrs& attrs) { return 1; })
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       return std::vector<std::string>{"data", "label"};
+                                     })
+    .set_attr<nnvm::FListOutputNames>("FListOutputNames",
+                                      [](const NodeAttrs& attrs) {
+                                        return std::vector<std::string>{"output", "logsumexp"};
+                                      })
+    .set_attr<mxnet::FInferShape>("FInferShape", LogSoftmaxNLLOpShape)
+    .set_attr<nnvm::FInferType>("FInferType", LogSoftmaxNLLOpType)
+    .set_attr<FCompute>("FCompute<cpu>", LogSoftmaxNLLCompute<cpu>)
+    .set_attr<nnvm::FGradient>(
+        "FGradient",
+        [](const nnvm::ObjectPtr& n, const std::vector<nnvm::NodeEntry>& ograds) {
+          if (CheckGradAllZero(ograds))
+            return MakeZeroGradNodes(n, ograds);
+          auto ret = MakeGradNode("_backward_log_softmax_nll",
+                                  n,
+                                  {ograds[log_softmax_nll::kOut],
+                                   n->inputs[log_softmax_nll::kData],
+                                   n->inputs[log_softmax_nll::kLabel],
+                                   nnvm::NodeEntry{n, log_softmax_nll::kLogSumExp, 0}},
+                                  n->attrs.dict);
+          ret.emplace_back(MakeNode("zeros_like",
+                                    n->attrs.name + "_label_backward",
+                                    {n->inputs[log_softmax_nll::kLabel]},
+                                    nullptr,
+                                    &n));
+          return ret;
+        })
+    .add_argument("data", "NDArray-or-Symbol", "The input array.")
+    .add_argument("label", "NDArray-or-Symbol", "The index of the expected class.")
+    .add_arguments(SoftmaxParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_backward_log_softmax_nll)
+    .set_num_inputs(4)
+    .set_num_outputs(1)
+    .set_attr_parser(ParamParser<SoftmaxParam>)
+    .set_attr<nnvm::TIsBackward>("TIsBackward", true)
+    .set_attr<FCompute>("FCompute<cpu>", LogSoftmaxNLLGradCompute<cpu>);
+
+}  // namespace op
+}  // namespace mxnet
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file mkldnn_weight_cache-inl.h
+ * \brief Process-wide cache of weights reordered into the layouts of oneDNN primitives
+ */
+
+#ifndef MXNET_OPERATOR_NN_MKLDNN_MKLDNN_WEIGHT_CACHE_INL_H_
+#define MXNET_OPERATOR_NN_MKLDNN_MKLDNN_WEIGHT_CACHE_INL_H_
+
+#if MXNET_USE_ONEDNN == 1
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./mkldnn_base-inl.h"
+
+namespace mxnet {
+
+/*!
+ * \brief Weights packed into the layouts of oneDNN primitives, keyed by the content and layout
+ *        of the weight, the packed layout and the output scales of the reorder.
+ *
+ *        The fused convolution and fully connected operators take their packed weights from the
+ *        cache, so that the operators of all the CachedOps of a process that have the same
+ *        weights share one copy. The weights packed in place by the other operators are copied
+ *        from the cache when it has them. The entries can be exported with the parameters and
+ *        imported by another process, which then skips the reorders.
+ *
+ *        An entry lives as long as an operator holds its packed weight: the entries only held by
+ *        the cache are dropped when the cache is next used. The imported entries and the weights
+ *        packed in place, which no operator holds, are pinned until Clear.
+ */
+class MKLDNNWeightCache {
+ public:
+  /*! \brief prefix of the names of the entries among saved parameters */
+  static constexpr const char* kPrefix = "onednn:";
+
+  /*! \brief the cache of the process */
+  static MKLDNNWeightCache* Get();
+  /*!
+   * \brief MXNET_ONEDNN_WEIGHT_CACHE: 0 disables the cache, 1 shares the packed weights of
+   *        the fused operators, 2 also keeps a copy of the weights packed in place
+   */
+  static int Level();
+  /*!
+   * \brief the key of src reordered to md
+   * \param src the weight, whose data is ready
+   * \param md the packed layout
+   * \param scales the output scales of the reorder, empty for none
+   */
+  static std::string Key(const mkldnn::memory& src,
+                         const mkldnn::memory::desc& md,
+                         const std::vector<float>& scales);
+
+  /*! \brief the packed weight of key, or an empty array */
+  NDArray Find(const std::string& key);
+  /*!
+   * \brief adds a packed weight, whose data is ready
+   * \param pinned whether the entry is kept when the cache holds the only reference to it
+   * \return the entry of key, which is packed when another thread added it first
+   */
+  NDArray Insert(const std::string& key, const NDArray& packed, bool pinned = false);
+  /*!
+   * \brief the entries, as uint8 arrays of the memory descriptor followed by the packed data
+   * \param names the names of the entries, starting with kPrefix
+   */
+  void Export(std::vector<std::string>* names, std::vector<NDArray>* arrays);
+  /*!
+   * \brief adds the entries of Export. Entries of another version of oneDNN are skipped
+   * \return the number of entries added
+   */
+  size_t Import(const std::vector<std::string>& names, const std::vector<NDArray>& arrays);
+  /*! \brief removes all the entries */
+  void Clear();
+  /*! \brief the number of entries */
+  size_t Size();
+
+ private:
+  /*! \brief a packed weight, and whether it is kept when no operator holds it */
+  struct Entry {
+    NDArray packed;
+    bool pinned;
+  };
+
+  MKLDNNWeightCache() = default;
+  /*! \brief drops the entries which are not pinned and only held by the cache */
+  void Evict();
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace mxnet
+#endif  // MXNET_USE_ONEDNN == 1
+#endif  // MXNET_OPERATOR_NN_MKLDNN_MKLDNN_WEIGHT_CACHE_INL_H_
@@ -0,0 +1,179 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file mkldnn_weight_cache.cc
+ * \brief Process-wide cache of weights reordered into the layouts of oneDNN primitives
+ */
+
+#if MXNET_USE_ONEDNN == 1
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "./mkldnn_weight_cache-inl.h"
+
+namespace mxnet {
+
+namespace {
+
+/*! \brief hash of size bytes, 8 at a time */
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+  const uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  const char* bytes   = static_cast<const char*>(data);
+  uint64_t hash       = seed ^ (size * kMul);
+  size_t i            = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * kMul;
+    hash ^= hash >> 47;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(bytes[i])) * kMul;
+  }
+  return hash;
+}
+
+/*! \brief the version of oneDNN, which the packed layouts depend on */
+std::string VersionTag() {
+  const mkldnn_version_t* version = mkldnn_version();
+  std::ostringstream os;
+  os << 'v' << version->major << '.' << version->minor << '.' << version->patch;
+  return os.str();
+}
+
+}  // namespace
+
+MKLDNNWeightCache* MKLDNNWeightCache::Get() {
+  static MKLDNNWeightCache inst;
+  return &inst;
+}
+
+int MKLDNNWeightCache::Level() {
+  static int level = dmlc::GetEnv("MXNET_ONEDNN_WEIGHT_CACHE", 1);
+  return level;
+}
+
+std::string MKLDNNWeightCache::Key(const mkldnn::memory& src,
+                                   const mkldnn::memory::desc& md,
+                                   const std::vector<float>& scales) {
+  const uint64_t kSeed              = 0x6f6e65646e6e7763ULL;
+  const mkldnn::memory::desc src_md = src.get_desc();
+  const uint64_t content = HashBytes(src.get_data_handle(), src_md.get_size(), kSeed);
+  uint64_t layout        = HashBytes(&src_md.data, sizeof(src_md.data), kSeed);
+  layout                 = HashBytes(&md.data, sizeof(md.data), layout);
+  layout                 = HashBytes(scales.data(), scales.size() * sizeof(float), layout);
+  std::ostringstream os;
+  os << VersionTag() << ':' << std::hex << std::setfill('0') << std::setw(16) << content
+     << std::setw(16) << layout;
+  return os.str();
+}
+
+void MKLDNNWeightCache::Evict() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!it->second.pinned && it->second.packed.ptr_.use_count() == 1) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+NDArray MKLDNNWeightCache::Find(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Evict();
+  auto it = entries_.find(key);
+  return it == entries_.end() ? NDArray() : it->second.packed;
+}
+
+NDArray MKLDNNWeightCache::Insert(const std::string& key, const NDArray& packed, bool pinned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Evict();
+  Entry& entry = entries_.emplace(key, Entry{packed, pinned}).first->second;
+  entry.pinned = entry.pinned || pinned;
+  return entry.packed;
+}
+
+void MKLDNNWeightCache::Export(std::vector<std::string>* names, std::vector<NDArray>* arrays) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Evict();
+  names->clear();
+  arrays->clear();
+  for (const auto& entry : entries_) {
+    const mkldnn::memory* mem      = entry.second.packed.GetMKLDNNData();
+    const mkldnn::memory::desc& md = mem->get_desc();
+    const size_t bytes             = md.get_size();
+    NDArray out(mxnet::TShape({static_cast<dim_t>(sizeof(md.data) + bytes)}),
+                Context::CPU(),
+                false,
+                mshadow::kUint8);
+    uint8_t* dst = out.data().dptr<uint8_t>();
+    std::memcpy(dst, &md.data, sizeof(md.data));
+    std::memcpy(dst + sizeof(md.data), mem->get_data_handle(), bytes);
+    names->push_back(kPrefix + entry.first);
+    arrays->push_back(out);
+  }
+}
+
+size_t MKLDNNWeightCache::Import(const std::vector<std::string>& names,
+                                 const std::vector<NDArray>& arrays) {
+  CHECK_EQ(names.size(), arrays.size());
+  const std::string prefix = kPrefix + VersionTag() + ":";
+  size_t imported          = 0;
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i].compare(0, prefix.size(), prefix) != 0) {
+      LOG(WARNING) << "Skipping packed weight " << names[i] << ", which is not of oneDNN "
+                   << VersionTag();
+      continue;
+    }
+    const NDArray& array = arrays[i];
+    CHECK(array.storage_type() == kDefaultStorage && array.dtype() == mshadow::kUint8 &&
+          array.ctx().dev_mask() == Context::kCPU)
+        << "Packed weight " << names[i] << " must be a dense uint8 array on CPU";
+    array.WaitToRead();
+    const uint8_t* src = array.data().dptr<uint8_t>();
+    mkldnn::memory::desc md;
+    CHECK_GE(array.shape().Size(), sizeof(md.data)) << "Invalid packed weight " << names[i];
+    std::memcpy(&md.data, src, sizeof(md.data));
+    CHECK_EQ(array.shape().Size(), sizeof(md.data) + md.get_size())
+        << "Invalid packed weight " << names[i];
+    NDArray packed(md);
+    std::memcpy(packed.GetMKLDNNData()->get_data_handle(), src + sizeof(md.data), md.get_size());
+    // no operator holds the entry until it is found
+    Insert(names[i].substr(std::strlen(kPrefix)), packed, true);
+    ++imported;
+  }
+  return imported;
+}
+
+void MKLDNNWeightCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+size_t MKLDNNWeightCache::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Evict();
+  return entries_.size();
+}
+
+}  // namespace mxnet
+#endif  // MXNET_USE_ONEDNN == 1
@@ -26,6 +26,7 @@
 #define MXNET_OPERATOR_NN_SOFTMAX_INL_H_
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,6 +34,7 @@
 
 #include "../mxnet_op.h"
 #include "../operator_common.h"
+#include "../vector_math-inl.h"
 #include "../tensor/broadcast_reduce_op.h"
 
 using mshadow::red::limits::MinValue;
@@ -65,6 +67,157 @@ struct log_softmax_fwd {
   }
 };
 
+/*! \brief type the contiguous softmax kernels compute exp in: float unless DType is double */
+template <typename DType>
+using softmax_compute_t =
+    typename std::conditional<std::is_same<DType, double>::value, double, float>::type;
+
+/*!
+ * \brief Online softmax statistics of the row in[0], in[stride], ... in[(len - 1) * stride]:
+ *        its maximum m and the sum of exp((x - m) * scale), in a single pass over the input.
+ *        The row is read in blocks that stay in L1, and the partial sum is rescaled whenever a
+ *        block raises the maximum. A row made of -inf only gets a zero sum.
+ */
+template <bool negate, typename CType, typename AType, typename DType>
+inline void OnlineSoftmaxStats(const DType* in,
+                               const index_t len,
+                               const index_t stride,
+                               const CType scale,
+                               CType* max,
+                               AType* sum) {
+  constexpr index_t kBlock = 64;
+  constexpr index_t kLanes = 16;
+  const CType kNegInf      = -std::numeric_limits<CType>::infinity();
+  CType m                  = kNegInf;
+  AType acc[kLanes]        = {};
+  CType x[kBlock];
+  for (index_t j0 = 0; j0 < len; j0 += kBlock) {
+    const index_t n = std::min(kBlock, len - j0);
+    CType block_max = m;
+    for (index_t j = 0; j < n; ++j) {
+      const CType v = static_cast<CType>(in[(j0 + j) * stride]);
+      x[j]          = negate ? -v : v;
+      block_max     = block_max < x[j] ? x[j] : block_max;
+    }
+    if (m < block_max) {
+      const AType rescale = static_cast<AType>(vector_math::exp((m - block_max) * scale));
+      for (index_t l = 0; l < kLanes; ++l) {
+        acc[l] *= rescale;
+      }
+      m = block_max;
+    }
+    if (m == kNegInf) {
+      continue;
+    }
+    if (n == kBlock) {
+      for (index_t j = 0; j < kBlock; j += kLanes) {
+        for (index_t l = 0; l < kLanes; ++l) {
+          acc[l] += static_cast<AType>(vector_math::exp((x[j + l] - m) * scale));
+        }
+      }
+    } else {
+      for (index_t j = 0; j < n; ++j) {
+        acc[j % kLanes] += static_cast<AType>(vector_math::exp((x[j] - m) * scale));
+      }
+    }
+  }
+  AType total = 0;
+  for (index_t l = 0; l < kLanes; ++l) {
+    total += acc[l];
+  }
+  *max = m;
+  *sum = total;
+}
+
+/*! \brief Write OP of the contiguous row in[0, len) given its online softmax statistics */
+template <typename OP, bool negate, typename CType, typename AType, typename DType, typename OType>
+inline void OnlineSoftmaxWrite(const DType* in,
+                               OType* out,
+                               const index_t len,
+                               const CType scale,
+                               const CType max,
+                               const AType sum) {
+  if constexpr (std::is_same<OP, softmax_fwd>::value) {
+    const CType inv_sum = static_cast<CType>(AType(1) / sum);
+    for (index_t j = 0; j < len; ++j) {
+      const CType v = negate ? -static_cast<CType>(in[j]) : static_cast<CType>(in[j]);
+      out[j]        = OType(vector_math::exp((v - max) * scale) * inv_sum);
+    }
+  } else if constexpr (std::is_same<OP, log_softmax_fwd>::value) {
+    const CType log_sum = static_cast<CType>(std::log(sum));
+    for (index_t j = 0; j < len; ++j) {
+      const CType v = negate ? -static_cast<CType>(in[j]) : static_cast<CType>(in[j]);
+      out[j]        = OType((v - max) * scale - log_sum);
+    }
+  } else {
+    for (index_t j = 0; j < len; ++j) {
+      const CType v = negate ? -static_cast<CType>(in[j]) : static_cast<CType>(in[j]);
+      out[j]        = OP::Map(static_cast<DType>((v - max) * scale), sum);
+    }
+  }
+}
+
+/*!
+ * \brief Softmax over the contiguous rows of an N x M matrix in two passes over the input
+ *        instead of three. Rows too few to keep the threads busy are split into chunks whose
+ *        online statistics are merged.
+ */
+template <typename OP, bool negate, typename AType, typename DType, typename OType>
+inline void SoftmaxContiguous(const DType* in,
+                              OType* out,
+                              const index_t N,
+                              const index_t M,
+                              const DType temperature) {
+  using CType                 = softmax_compute_t<DType>;
+  constexpr index_t kMinChunk = 16384;
+  const CType scale           = CType(1) / static_cast<CType>(temperature);
+  const int omp_threads       = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  if (N >= omp_threads || M < 2 * kMinChunk) {
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t i = 0; i < N; ++i) {
+      CType max;
+      AType sum;
+      OnlineSoftmaxStats<negate>(in + i * M, M, 1, scale, &max, &sum);
+      OnlineSoftmaxWrite<OP, negate>(in + i * M, out + i * M, M, scale, max, sum);
+    }
+    return;
+  }
+  const index_t nchunks = std::min<index_t>(omp_threads, M / kMinChunk);
+  const index_t chunk   = (M + nchunks - 1) / nchunks;
+  std::vector<CType> chunk_max(nchunks);
+  std::vector<AType> chunk_sum(nchunks);
+  for (index_t i = 0; i < N; ++i) {
+    const DType* row_in = in + i * M;
+    OType* row_out      = out + i * M;
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t c = 0; c < nchunks; ++c) {
+      const index_t begin = c * chunk;
+      OnlineSoftmaxStats<negate>(row_in + begin,
+                                 std::min(chunk, M - begin),
+                                 1,
+                                 scale,
+                                 &chunk_max[c],
+                                 &chunk_sum[c]);
+    }
+    CType max = chunk_max[0];
+    for (index_t c = 1; c < nchunks; ++c) {
+      max = max < chunk_max[c] ? chunk_max[c] : max;
+    }
+    AType sum = 0;
+    for (index_t c = 0; c < nchunks; ++c) {
+      if (chunk_max[c] != -std::numeric_limits<CType>::infinity()) {
+        sum += chunk_sum[c] * static_cast<AType>(vector_math::exp((chunk_max[c] - max) * scale));
+      }
+    }
+#pragma omp parallel for num_threads(omp_threads)
+    for (index_t c = 0; c < nchunks; ++c) {
+      const index_t begin = c * chunk;
+      OnlineSoftmaxWrite<OP, negate>(
+          row_in + begin, row_out + begin, std::min(chunk, M - begin), scale, max, sum);
+    }
+  }
+}
+
 template <typename OP,
           bool negate,
           typename AType,
@@ -88,6 +241,12 @@ inline void Softmax(Stream<cpu>* s,
   sshape[axis]       = 1;
   index_t sa         = stride[axis];
 
+  if constexpr (std::is_same<AType, float>::value || std::is_same<AType, double>::value) {
+    if (length == nullptr && sa == 1) {
+      SoftmaxContiguous<OP, negate, AType>(in, out, N, M, temperature);
+      return;
+    }
+  }
   if (length == nullptr) {
 #pragma omp parallel for
     for (index_t i = 0; i < N; ++i) {
@@ -65,6 +65,7 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
 #include "./np_tensordot_op-inl.h"
 #include "./np_einsum_path_op-inl.h"
 #include "../../common/static_array.h"
@@ -415,6 +416,10 @@ class EinsumOp {
   std::string subscripts;
   std::shared_ptr<NDArray> tempspace;
   std::vector<Step> paths;
+  /*! \brief contraction paths computed so far, keyed by the operand shapes and dtype */
+  std::unordered_map<std::string, std::vector<Step> > path_cache;
+  /*! \brief upper bound on the number of cached paths */
+  static constexpr size_t kMaxCachedPaths = 64;
   explicit EinsumOp(int num_args, int optimize, std::string subscripts) {
     this->num_args   = num_args;
     this->optimize   = optimize;
@@ -424,6 +429,30 @@ class EinsumOp {
     return this->num_args == other.num_args && !this->subscripts.compare(other.subscripts) &&
            this->optimize == other.optimize;
   }
+  /*!
+   * \brief Set `paths` to the contraction path of the operands, running the path search
+   *        only the first time a combination of shapes is seen.
+   */
+  void UpdatePaths(const std::vector<TBlob>& operands, const RunContext& run_ctx) {
+    std::ostringstream key_s;
+    key_s << operands[0].type_flag_;
+    for (const TBlob& operand : operands) {
+      key_s << operand.shape_;
+    }
+    const std::string key = key_s.str();
+    auto it               = path_cache.find(key);
+    if (it == path_cache.end()) {
+      std::vector<std::vector<int> > pos;
+      std::string string_repr;
+      if (path_cache.size() >= kMaxCachedPaths) {
+        path_cache.clear();
+      }
+      it = path_cache
+               .emplace(key, einsum_path(subscripts, operands, true, run_ctx, &pos, &string_repr))
+               .first;
+    }
+    paths = it->second;
+  }
 };  // class EinsumOp
 
 template <int dimension, int req, bool back, typename AType>
@@ -779,6 +808,174 @@ inline void NumpyEinsumProcess(const std::vector<TBlob>& inputs,
   }
 }
 
+/*!
+ * \brief Evaluate a two-operand contraction "lhs,rhs->out" as a batched GEMM. Every label is
+ *        classified as batch (in lhs, rhs and out), left (lhs and out), right (rhs and out) or
+ *        contracted (lhs and rhs), the operands are transposed to [batch, left, contracted] and
+ *        [batch, contracted, right], and the product is transposed to the output layout.
+ * \return false if the contraction does not have this form, e.g. repeated labels in a term,
+ *         labels summed within one operand, broadcasting or unsupported dtypes; the caller then
+ *         falls back to the generic einsum loop.
+ */
+template <typename xpu>
+inline bool NumpyEinsumBatchGemm(const std::vector<TBlob>& operands,
+                                 const OpReqType req,
+                                 const TBlob& out,
+                                 const std::string& einsum_str,
+                                 const OpContext& ctx) {
+  using namespace mshadow;
+  if (operands.size() != 2U || req == kWriteInplace ||
+      (out.type_flag_ != kFloat32 && out.type_flag_ != kFloat64) ||
+      operands[0].type_flag_ != out.type_flag_ || operands[1].type_flag_ != out.type_flag_) {
+    return false;
+  }
+  const size_t comma = einsum_str.find(',');
+  const size_t arrow = einsum_str.find("->");
+  if (comma == std::string::npos || arrow == std::string::npos || comma > arrow) {
+    return false;
+  }
+  const std::string terms[3] = {einsum_str.substr(0, comma),
+                                einsum_str.substr(comma + 1, arrow - comma - 1),
+                                einsum_str.substr(arrow + 2)};
+  const TShape* shapes[3]    = {&operands[0].shape_, &operands[1].shape_, &out.shape_};
+  // bit k of where[c] is set if label c appears in terms[k]
+  int where[MAXAXIS]    = {0};
+  dim_t extent[MAXAXIS] = {0};
+  for (int k = 0; k < 3; ++k) {
+    if (terms[k].empty() || static_cast<int>(terms[k].length()) != shapes[k]->ndim() ||
+        shapes[k]->ndim() > 6) {
+      return false;
+    }
+    for (size_t j = 0; j < terms[k].length(); ++j) {
+      const int c = static_cast<unsigned char>(terms[k][j]);
+      if (!isalpha(c) || (where[c] & (1 << k)) || (where[c] && extent[c] != (*shapes[k])[j])) {
+        return false;
+      }
+      where[c] |= 1 << k;
+      extent[c] = (*shapes[k])[j];
+    }
+  }
+  // labels of each group, batch/left/right in output order and contracted in lhs order
+  std::string batch, left, right, contract;
+  for (const char& c : terms[2]) {
+    switch (where[static_cast<unsigned char>(c)]) {
+      case 7:
+        batch += c;
+        break;
+      case 5:
+        left += c;
+        break;
+      case 6:
+        right += c;
+        break;
+      default:
+        return false;
+    }
+  }
+  for (const char& c : terms[0]) {
+    const int w = where[static_cast<unsigned char>(c)];
+    if (w == 3) {
+      contract += c;
+    } else if (w == 1) {
+      return false;
+    }
+  }
+  for (const char& c : terms[1]) {
+    if (where[static_cast<unsigned char>(c)] == 2) {
+      return false;
+    }
+  }
+  auto size_of = [&extent](const std::string& labels) {
+    index_t size = 1;
+    for (const char& c : labels) {
+      size *= extent[static_cast<unsigned char>(c)];
+    }
+    return size;
+  };
+  const index_t nbatch = size_of(batch), m = size_of(left), n = size_of(right),
+                nk = size_of(contract);
+  if (nbatch == 0 || m == 0 || n == 0 || nk == 0) {
+    return false;
+  }
+  if (req == kNullOp) {
+    return true;
+  }
+  // axes of the transpose taking the label order `from` to the label order `to`
+  auto permutation = [](const std::string& from, const std::string& to) {
+    TShape axes(to.length(), -1);
+    for (size_t j = 0; j < to.length(); ++j) {
+      axes[j] = static_cast<dim_t>(from.find(to[j]));
+    }
+    return axes;
+  };
+  const std::string lhs_order = batch + left + contract, rhs_order = batch + contract + right,
+                    out_order = batch + left + right;
+  const bool lhs_t = lhs_order != terms[0], rhs_t = rhs_order != terms[1],
+             out_t = out_order != terms[2];
+  Stream<xpu>* s        = ctx.get_stream<xpu>();
+  MSHADOW_SGL_DBL_TYPE_SWITCH(out.type_flag_, DType, {
+    const size_t lhs_size = lhs_t ? nbatch * m * nk : 0;
+    const size_t rhs_size = rhs_t ? nbatch * nk * n : 0;
+    const size_t out_size = out_t ? nbatch * m * n : 0;
+    Tensor<xpu, 1, char> workspace = ctx.requested[0].get_space_typed<xpu, 1, char>(
+        Shape1(3 * nbatch * sizeof(DType*) + (lhs_size + rhs_size + out_size) * sizeof(DType)),
+        s);
+    DType** ptrs     = reinterpret_cast<DType**>(workspace.dptr_);
+    DType* lhs_dptr  = reinterpret_cast<DType*>(workspace.dptr_ + 3 * nbatch * sizeof(DType*));
+    DType* rhs_dptr  = lhs_dptr + lhs_size;
+    DType* prod_dptr = rhs_dptr + rhs_size;
+    if (lhs_t) {
+      TShape lhs_shape(lhs_order.length(), -1);
+      for (size_t j = 0; j < lhs_order.length(); ++j) {
+        lhs_shape[j] = extent[static_cast<unsigned char>(lhs_order[j])];
+      }
+      TransposeImpl<xpu>(
+          ctx.run_ctx, operands[0], TBlob(lhs_dptr, lhs_shape, xpu::kDevMask),
+          permutation(terms[0], lhs_order));
+    } else {
+      lhs_dptr = operands[0].dptr<DType>();
+    }
+    if (rhs_t) {
+      TShape rhs_shape(rhs_order.length(), -1);
+      for (size_t j = 0; j < rhs_order.length(); ++j) {
+        rhs_shape[j] = extent[static_cast<unsigned char>(rhs_order[j])];
+      }
+      TransposeImpl<xpu>(
+          ctx.run_ctx, operands[1], TBlob(rhs_dptr, rhs_shape, xpu::kDevMask),
+          permutation(terms[1], rhs_order));
+    } else {
+      rhs_dptr = operands[1].dptr<DType>();
+    }
+    if (!out_t) {
+      prod_dptr = out.dptr<DType>();
+    }
+    Tensor<xpu, 3, DType> lhs(lhs_dptr, Shape3(nbatch, m, nk), s);
+    Tensor<xpu, 3, DType> rhs(rhs_dptr, Shape3(nbatch, nk, n), s);
+    Tensor<xpu, 3, DType> prod(prod_dptr, Shape3(nbatch, m, n), s);
+    const bool addto = req == kAddTo && !out_t;
+    BatchGEMM<false, false>(prod,
+                            lhs,
+                            rhs,
+                            DType(1),
+                            addto ? DType(1) : DType(0),
+                            Tensor<xpu, 1, DType*>(ptrs, Shape1(3 * nbatch), s));
+    if (out_t) {
+      TShape prod_shape(out_order.length(), -1);
+      for (size_t j = 0; j < out_order.length(); ++j) {
+        prod_shape[j] = extent[static_cast<unsigned char>(out_order[j])];
+      }
+      const TBlob prod_blob(prod_dptr, prod_shape, xpu::kDevMask);
+      const TShape out_axes = permutation(out_order, terms[2]);
+      if (req == kAddTo) {
+        TransposeImpl<xpu, true>(ctx.run_ctx, prod_blob, out, out_axes);
+      } else {
+        TransposeImpl<xpu>(ctx.run_ctx, prod_blob, out, out_axes);
+      }
+    }
+  });
+  return true;
+}
+
 template <typename xpu>
 inline void NumpyEinsumForward(const OpStatePtr& state_ptr,
                                const OpContext& ctx,
@@ -795,14 +992,14 @@ inline void NumpyEinsumForward(const OpStatePtr& state_ptr,
   CHECK_EQ(inputs.size(), num_args);
   CHECK_EQ(outputs.size(), 1U);
   if (optimize == 0) {
-    NumpyEinsumProcess<xpu, 0>(inputs, req, outputs, subscripts, num_args, ctx);
+    if (!NumpyEinsumBatchGemm<xpu>(inputs, req[0], outputs[0], state.subscripts, ctx)) {
+      NumpyEinsumProcess<xpu, 0>(inputs, req, outputs, subscripts, num_args, ctx);
+    }
     return;
   }
+  state.UpdatePaths(inputs, ctx.run_ctx);
   std::vector<Step>& paths = state.paths;
-  std::vector<std::vector<int> > pos;
-  std::string string_repr;
-  paths         = einsum_path(state.subscripts, inputs, true, ctx.run_ctx, &pos, &string_repr);
-  int paths_len = paths.size();
+  int paths_len            = paths.size();
   size_t temp_space_size = 0, max_temp_space_size = 0;
   std::vector<TBlob> operands(inputs), tmp_operands, temp_space_vec(paths_len - 1);
   for (int i = 0; i + 1 < paths_len; ++i) {
@@ -880,7 +1077,12 @@ inline void NumpyEinsumForward(const OpStatePtr& state_ptr,
                              std::vector<OpReqType>{OpReqType::kWriteTo},
                              tensordot_tempspace);
         }
-      } else {
+      } else if (!NumpyEinsumBatchGemm<xpu>(
+                     tmp_operands,
+                     handle_out ? req[0] : OpReqType::kWriteTo,
+                     handle_out ? outputs[0] : temp_space_vec[i],
+                     paths[i].einsum_str,
+                     ctx)) {
         NumpyEinsumProcess<xpu, 0>(tmp_operands,
                                    handle_out ? req : std::vector<OpReqType>{OpReqType::kWriteTo},
                                    handle_out ? outputs : std::vector<TBlob>{temp_space_vec[i]},
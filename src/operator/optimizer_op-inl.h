@@ -39,6 +39,7 @@
 #include "mxnet_op.h"
 #include "./tensor/init_op.h"
 #include "./tensor/util/tensor_util-inl.h"
+#include "./contrib/multi_tensor_chunk-inl.h"
 
 namespace mxnet {
 namespace op {
@@ -1683,6 +1684,113 @@ inline void AdamUpdateEx(const nnvm::NodeAttrs& attrs,
   }
 }
 
+struct MultiAdamParam : public dmlc::Parameter<MultiAdamParam> {
+  mxnet::Tuple<float> lrs;
+  mxnet::Tuple<float> wds;
+  float beta1;
+  float beta2;
+  float epsilon;
+  float rescale_grad;
+  float clip_gradient;
+  int num_weights;
+  DMLC_DECLARE_PARAMETER(MultiAdamParam) {
+    DMLC_DECLARE_FIELD(lrs).describe("Learning rates.");
+    DMLC_DECLARE_FIELD(wds).describe(
+        "Weight decay augments the objective function with a "
+        "regularization term that penalizes large weights. "
+        "The penalty scales with the square of the magnitude of each weight.");
+    DMLC_DECLARE_FIELD(beta1).set_default(0.9f).describe(
+        "The decay rate for the 1st moment estimates.");
+    DMLC_DECLARE_FIELD(beta2).set_default(0.999f).describe(
+        "The decay rate for the 2nd moment estimates.");
+    DMLC_DECLARE_FIELD(epsilon).set_default(1e-8f).describe(
+        "A small constant for numerical stability.");
+    DMLC_DECLARE_FIELD(rescale_grad)
+        .set_default(1.0f)
+        .describe("Rescale gradient to grad = rescale_grad*grad.");
+    DMLC_DECLARE_FIELD(clip_gradient)
+        .set_default(-1.0f)
+        .describe(
+            "Clip gradient to the range of [-clip_gradient, clip_gradient] "
+            "If clip_gradient <= 0, gradient clipping is turned off. "
+            "grad = max(min(grad, clip_gradient), -clip_gradient).");
+    DMLC_DECLARE_FIELD(num_weights).set_default(1).describe("Number of updated weights.");
+  }
+};
+
+template <typename DType, typename MPDType, int input_stride>
+inline void MultiAdamUpdateRun(const MultiAdamParam& param,
+                               const std::vector<TBlob>& inputs,
+                               const std::vector<OpReqType>& req,
+                               const std::vector<TBlob>& outputs) {
+  using namespace mshadow_op;
+  constexpr bool has_mixed_precision = !std::is_same<DType, MPDType>::value;
+  const MPDType beta1                = param.beta1;
+  const MPDType beta2                = param.beta2;
+  const MPDType epsilon              = param.epsilon;
+  const MPDType rescale_grad         = param.rescale_grad;
+  const MPDType clip_gradient        = param.clip_gradient;
+  std::vector<size_t> sizes(param.num_weights);
+  for (int i = 0; i < param.num_weights; ++i) {
+    sizes[i] = req[i] == kNullOp ? 0 : inputs[i * input_stride].Size();
+  }
+  MultiTensorChunkedFor(sizes, [&](const int t, const size_t begin, const size_t end) {
+    const size_t idx     = t * input_stride;
+    const DType* weight  = inputs[idx].dptr<DType>();
+    const DType* grad    = inputs[idx + 1].dptr<DType>();
+    MPDType* mean        = inputs[idx + 2].dptr<MPDType>();
+    MPDType* var         = inputs[idx + 3].dptr<MPDType>();
+    DType* out           = outputs[t].dptr<DType>();
+    const MPDType lr     = param.lrs[t];
+    const MPDType wd     = param.wds[t];
+    const OpReqType treq = req[t];
+    // if mixed precision, then the last input in a set is the float32 master copy
+    MPDType* weight32 =
+        has_mixed_precision ? inputs[idx + input_stride - 1].dptr<MPDType>() : nullptr;
+    for (size_t i = begin; i < end; ++i) {
+      MPDType w             = has_mixed_precision ? weight32[i] : MPDType(weight[i]);
+      MPDType grad_rescaled = static_cast<MPDType>(grad[i]) * rescale_grad;
+      if (clip_gradient >= 0.0f) {
+        grad_rescaled = clip::Map(grad_rescaled, clip_gradient);
+      }
+      grad_rescaled += w * wd;
+      mean[i] = beta1 * mean[i] + (MPDType(1.0f) - beta1) * grad_rescaled;
+      var[i]  = beta2 * var[i] + (MPDType(1.0f) - beta2) * grad_rescaled * grad_rescaled;
+      w -= lr * mean[i] / (square_root::Map(var[i]) + epsilon);
+      if (has_mixed_precision)
+        weight32[i] = w;
+      KERNEL_ASSIGN(out[i], treq, static_cast<DType>(w));
+    }
+  });
+}
+
+/*!
+ * \brief Adam update of many dense weights on CPU. All the weights are flattened into one
+ *        list of balanced chunks updated in a single OpenMP pass. The multi-precision variant
+ *        updates float16 and bfloat16 weights through their float32 master copies.
+ */
+template <typename xpu, template <typename> class MPTypeChooser, int input_stride>
+inline void MultiAdamUpdate(const nnvm::NodeAttrs& attrs,
+                            const OpContext& ctx,
+                            const std::vector<TBlob>& inputs,
+                            const std::vector<OpReqType>& req,
+                            const std::vector<TBlob>& outputs) {
+  static_assert(std::is_same<xpu, cpu>::value, "multi-tensor Adam is only implemented on CPU");
+  const MultiAdamParam& param = nnvm::get<MultiAdamParam>(attrs.parsed);
+  const int dtype             = outputs[0].type_flag_;
+  if (dtype == mshadow::kBfloat16) {
+    using MPDType = typename MPTypeChooser<mshadow::bfloat::bf16_t>::type;
+    CHECK((std::is_same<MPDType, float>::value))
+        << "bfloat16 weights are only supported by multi_mp_adam_update";
+    MultiAdamUpdateRun<mshadow::bfloat::bf16_t, float, input_stride>(param, inputs, req, outputs);
+    return;
+  }
+  MSHADOW_REAL_TYPE_SWITCH(dtype, DType, {
+    MultiAdamUpdateRun<DType, typename MPTypeChooser<DType>::type, input_stride>(
+        param, inputs, req, outputs);
+  });
+}
+
 struct LambUpdatePhaseOneParam : public dmlc::Parameter<LambUpdatePhaseOneParam> {
   float beta1;
   float beta2;
@@ -2934,6 +3042,311 @@ inline void AdagradUpdateEx(const nnvm::NodeAttrs& attrs,
   }
 }
 
+struct MultiSparseAdamParam : public dmlc::Parameter<MultiSparseAdamParam> {
+  mxnet::Tuple<float> lrs;
+  mxnet::Tuple<float> wds;
+  float beta1;
+  float beta2;
+  float epsilon;
+  float rescale_grad;
+  float clip_gradient;
+  int num_weights;
+  DMLC_DECLARE_PARAMETER(MultiSparseAdamParam) {
+    DMLC_DECLARE_FIELD(lrs).describe("Learning rates.");
+    DMLC_DECLARE_FIELD(wds).describe(
+        "Weight decay augments the objective function with a "
+        "regularization term that penalizes large weights. "
+        "The penalty scales with the square of the magnitude of each weight.");
+    DMLC_DECLARE_FIELD(beta1).set_default(0.9f).describe(
+        "The decay rate for the 1st moment estimates.");
+    DMLC_DECLARE_FIELD(beta2).set_default(0.999f).describe(
+        "The decay rate for the 2nd moment estimates.");
+    DMLC_DECLARE_FIELD(epsilon).set_default(1e-8f).describe(
+        "A small constant for numerical stability.");
+    DMLC_DECLARE_FIELD(rescale_grad)
+        .set_default(1.0f)
+        .describe("Rescale gradient to grad = rescale_grad*grad.");
+    DMLC_DECLARE_FIELD(clip_gradient)
+        .set_default(-1.0f)
+        .describe(
+            "Clip gradient to the range of [-clip_gradient, clip_gradient] "
+            "If clip_gradient <= 0, gradient clipping is turned off. "
+            "grad = max(min(grad, clip_gradient), -clip_gradient).");
+    DMLC_DECLARE_FIELD(num_weights).set_default(1).describe("Number of updated weights.");
+  }
+};
+
+struct MultiSparseAdagradParam : public dmlc::Parameter<MultiSparseAdagradParam> {
+  mxnet::Tuple<float> lrs;
+  mxnet::Tuple<float> wds;
+  float epsilon;
+  float rescale_grad;
+  float clip_gradient;
+  int num_weights;
+  DMLC_DECLARE_PARAMETER(MultiSparseAdagradParam) {
+    DMLC_DECLARE_FIELD(lrs).describe("Learning rates.");
+    DMLC_DECLARE_FIELD(wds).describe(
+        "Weight decay augments the objective function with a "
+        "regularization term that penalizes large weights. "
+        "The penalty scales with the square of the magnitude of each weight.");
+    DMLC_DECLARE_FIELD(epsilon).set_default(1.0e-7).describe("epsilon");
+    DMLC_DECLARE_FIELD(rescale_grad)
+        .set_default(1.0f)
+        .describe("Rescale gradient to grad = rescale_grad*grad.");
+    DMLC_DECLARE_FIELD(clip_gradient)
+        .set_default(-1.0f)
+        .describe(
+            "Clip gradient to the range of [-clip_gradient, clip_gradient] "
+            "If clip_gradient <= 0, gradient clipping is turned off. "
+            "grad = max(min(grad, clip_gradient), -clip_gradient).");
+    DMLC_DECLARE_FIELD(num_weights).set_default(1).describe("Number of updated weights.");
+  }
+};
+
+struct MultiSparseFtrlParam : public dmlc::Parameter<MultiSparseFtrlParam> {
+  mxnet::Tuple<float> lrs;
+  mxnet::Tuple<float> wds;
+  float lamda1;
+  float beta;
+  float rescale_grad;
+  float clip_gradient;
+  int num_weights;
+  DMLC_DECLARE_PARAMETER(MultiSparseFtrlParam) {
+    DMLC_DECLARE_FIELD(lrs).describe("Learning rates.");
+    DMLC_DECLARE_FIELD(wds).describe(
+        "Weight decay augments the objective function with a "
+        "regularization term that penalizes large weights. "
+        "The penalty scales with the square of the magnitude of each weight.");
+    DMLC_DECLARE_FIELD(lamda1).set_default(0.01f).describe("The L1 regularization coefficient.");
+    DMLC_DECLARE_FIELD(beta).set_default(1.0f).describe("Per-Coordinate Learning Rate beta.");
+    DMLC_DECLARE_FIELD(rescale_grad)
+        .set_default(1.0f)
+        .describe("Rescale gradient to grad = rescale_grad*grad.");
+    DMLC_DECLARE_FIELD(clip_gradient)
+        .set_default(-1.0f)
+        .describe(
+            "Clip gradient to the range of [-clip_gradient, clip_gradient] "
+            "If clip_gradient <= 0, gradient clipping is turned off. "
+            "grad = max(min(grad, clip_gradient), -clip_gradient).");
+    DMLC_DECLARE_FIELD(num_weights).set_default(1).describe("Number of updated weights.");
+  }
+};
+
+/*!
+ * \brief Lazy adam update of one row: w, mean and var are read and written once.
+ */
+struct MultiSparseAdamRow {
+  static const int num_states = 2;
+  template <typename DType>
+  MSHADOW_XINLINE static void Map(const MultiSparseAdamParam& param,
+                                  const int index,
+                                  const nnvm::dim_t row_length,
+                                  const DType* grad,
+                                  DType* weight,
+                                  DType* mean,
+                                  DType* var) {
+    using namespace mshadow_op;
+    const DType lr           = param.lrs[index];
+    const DType wd           = param.wds[index];
+    const DType beta1        = param.beta1;
+    const DType beta2        = param.beta2;
+    const DType epsilon      = param.epsilon;
+    const DType rescale_grad = param.rescale_grad;
+    const DType clip_grad    = param.clip_gradient;
+    for (nnvm::dim_t j = 0; j < row_length; ++j) {
+      DType grad_rescaled = grad[j] * rescale_grad;
+      if (clip_grad >= 0.0f) {
+        grad_rescaled = clip::Map(grad_rescaled, clip_grad);
+      }
+      grad_rescaled += weight[j] * wd;
+      mean[j] = beta1 * mean[j] + (1.f - beta1) * grad_rescaled;
+      var[j]  = beta2 * var[j] + (1.f - beta2) * grad_rescaled * grad_rescaled;
+      weight[j] -= lr * mean[j] / (square_root::Map(var[j]) + epsilon);
+    }
+  }
+};
+
+/*!
+ * \brief Adagrad update of one row: w and history are read and written once.
+ */
+struct MultiSparseAdagradRow {
+  static const int num_states = 1;
+  template <typename DType>
+  MSHADOW_XINLINE static void Map(const MultiSparseAdagradParam& param,
+                                  const int index,
+                                  const nnvm::dim_t row_length,
+                                  const DType* grad,
+                                  DType* weight,
+                                  DType* history,
+                                  DType* unused) {
+    using namespace mshadow_op;
+    const DType lr           = param.lrs[index];
+    const DType wd           = param.wds[index];
+    const DType epsilon      = param.epsilon;
+    const DType rescale_grad = param.rescale_grad;
+    const DType clip_grad    = param.clip_gradient;
+    for (nnvm::dim_t j = 0; j < row_length; ++j) {
+      DType grad_rescaled = grad[j] * rescale_grad;
+      if (clip_grad >= 0.0f) {
+        grad_rescaled = clip::Map(grad_rescaled, clip_grad);
+      }
+      grad_rescaled += weight[j] * wd;
+      history[j] += grad_rescaled * grad_rescaled;
+      weight[j] -= lr * grad_rescaled / (square_root::Map(history[j]) + epsilon);
+    }
+  }
+};
+
+/*!
+ * \brief Ftrl update of one row: w, z and n are read and written once.
+ */
+struct MultiSparseFtrlRow {
+  static const int num_states = 2;
+  template <typename DType>
+  MSHADOW_XINLINE static void Map(const MultiSparseFtrlParam& param,
+                                  const int index,
+                                  const nnvm::dim_t row_length,
+                                  const DType* grad,
+                                  DType* weight,
+                                  DType* z,
+                                  DType* n) {
+    using namespace mshadow_op;
+    const DType lr           = param.lrs[index];
+    const DType wd           = param.wds[index];
+    const DType lamda1       = param.lamda1;
+    const DType beta         = param.beta;
+    const DType rescale_grad = param.rescale_grad;
+    const DType clip_grad    = param.clip_gradient;
+    for (nnvm::dim_t j = 0; j < row_length; ++j) {
+      DType grad_rescaled = grad[j] * rescale_grad;
+      if (clip_grad >= 0.0f) {
+        grad_rescaled = clip::Map(grad_rescaled, clip_grad);
+      }
+      const DType n_new = n[j] + square::Map(grad_rescaled);
+      z[j] += grad_rescaled - (square_root::Map(n_new) - square_root::Map(n[j])) * weight[j] / lr;
+      n[j] = n_new;
+      const DType d = -sign::Map(z[j]) * maximum::Map(abs::Map(z[j]) - lamda1, DType(0));
+      weight[j]     = d / ((beta + square_root::Map(n[j])) / lr + wd);
+    }
+  }
+};
+
+/*!
+ * \brief Storage type inference of the multi-tensor sparse optimizers: every gradient is
+ *        row_sparse, and every weight is dense or row_sparse with states of the same stype.
+ */
+template <typename ParamType, int input_stride>
+inline bool MultiSparseOptStorageType(const nnvm::NodeAttrs& attrs,
+                                      const int dev_mask,
+                                      DispatchMode* dispatch_mode,
+                                      std::vector<int>* in_attrs,
+                                      std::vector<int>* out_attrs) {
+  const ParamType& param = nnvm::get<ParamType>(attrs.parsed);
+  CHECK_EQ(in_attrs->size(), input_stride * param.num_weights);
+  CHECK_EQ(out_attrs->size(), param.num_weights);
+  for (int i = 0; i < param.num_weights; ++i) {
+    const int weight_stype = in_attrs->at(i * input_stride);
+    if (in_attrs->at(i * input_stride + 1) != kRowSparseStorage ||
+        (weight_stype != kDefaultStorage && weight_stype != kRowSparseStorage)) {
+      return false;
+    }
+    for (int j = 2; j < input_stride; ++j) {
+      if (in_attrs->at(i * input_stride + j) != weight_stype) {
+        return false;
+      }
+    }
+    if (!type_assign(&(*out_attrs)[i], weight_stype)) {
+      return false;
+    }
+  }
+  return dispatch_mode_assign(dispatch_mode, DispatchMode::kFComputeEx);
+}
+
+/*!
+ * \brief Lazy update of many weights with row_sparse gradients in a single parallel pass.
+ *        The rows present in all the gradients are flattened into one work list, so small
+ *        and large embedding tables share the threads, and each row of the weight and its
+ *        states is updated in one pass by the row kernel RowOp.
+ */
+template <typename xpu, typename RowOp, typename ParamType, int input_stride>
+inline void MultiSparseOptUpdateEx(const nnvm::NodeAttrs& attrs,
+                                   const OpContext& ctx,
+                                   const std::vector<NDArray>& inputs,
+                                   const std::vector<OpReqType>& req,
+                                   const std::vector<NDArray>& outputs) {
+  using namespace rowsparse;
+  using nnvm::dim_t;
+  static_assert(input_stride == RowOp::num_states + 2, "wrong number of inputs per weight");
+  const ParamType& param = nnvm::get<ParamType>(attrs.parsed);
+  Stream<xpu>* s         = ctx.get_stream<xpu>();
+  // (index of the weight, position of the row in its gradient)
+  std::vector<std::pair<int, dim_t>> rows;
+  for (int i = 0; i < param.num_weights; ++i) {
+    const NDArray& weight = inputs[i * input_stride];
+    const NDArray& grad   = inputs[i * input_stride + 1];
+    if (req[i] == kNullOp || !grad.storage_initialized())
+      continue;
+    CHECK_EQ(req[i], kWriteInplace) << "kWriteInplace is expected for " << attrs.op->name;
+    CHECK_EQ(grad.aux_type(kIdx), inputs[1].aux_type(kIdx))
+        << "All gradients of " << attrs.op->name << " are expected to have the same index type";
+    if (weight.storage_type() == kRowSparseStorage) {
+      CheckAllRowsPresent(weight, attrs.op->name, "weights");
+      for (int j = 2; j < input_stride; ++j) {
+        const NDArray& state = inputs[i * input_stride + j];
+        if (!state.storage_initialized()) {
+          NDArray state_zeros = state;
+          FillDnsZerosRspImpl(s, &state_zeros);
+        }
+      }
+    }
+    const dim_t nnr = grad.aux_shape(kIdx)[0];
+    for (dim_t r = 0; r < nnr; ++r) {
+      rows.emplace_back(i, r);
+    }
+  }
+  if (rows.empty())
+    return;
+  const dim_t num_rows  = rows.size();
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  MSHADOW_REAL_TYPE_SWITCH(inputs[0].dtype(), DType, {
+    MSHADOW_IDX_TYPE_SWITCH(inputs[1].aux_type(kIdx), IType, {
+      std::vector<DType*> weights(param.num_weights);
+      std::vector<const DType*> grads(param.num_weights);
+      std::vector<const IType*> grad_idx(param.num_weights);
+      std::vector<DType*> states0(param.num_weights);
+      std::vector<DType*> states1(param.num_weights, nullptr);
+      std::vector<dim_t> row_lengths(param.num_weights);
+      for (int i = 0; i < param.num_weights; ++i) {
+        const NDArray& grad = inputs[i * input_stride + 1];
+        if (req[i] == kNullOp || !grad.storage_initialized())
+          continue;
+        const TBlob weight = inputs[i * input_stride].data();
+        weights[i]         = weight.dptr<DType>();
+        grads[i]           = grad.data().dptr<DType>();
+        grad_idx[i]        = grad.aux_data(kIdx).dptr<IType>();
+        states0[i]         = inputs[i * input_stride + 2].data().dptr<DType>();
+        if (RowOp::num_states > 1) {
+          states1[i] = inputs[i * input_stride + 3].data().dptr<DType>();
+        }
+        row_lengths[i] = weight.shape_.ProdShape(1, weight.ndim());
+      }
+#pragma omp parallel for num_threads(omp_threads)
+      for (dim_t r = 0; r < num_rows; ++r) {
+        const int i            = rows[r].first;
+        const dim_t row_length = row_lengths[i];
+        const dim_t offset     = static_cast<dim_t>(grad_idx[i][rows[r].second]) * row_length;
+        RowOp::Map(param,
+                   i,
+                   row_length,
+                   grads[i] + rows[r].second * row_length,
+                   weights[i] + offset,
+                   states0[i] + offset,
+                   RowOp::num_states > 1 ? states1[i] + offset : nullptr);
+      }
+    });
+  });
+}
+
 }  // namespace op
 }  // namespace mxnet
 
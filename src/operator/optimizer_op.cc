@@ -35,6 +35,7 @@ DMLC_REGISTER_PARAMETER(MultiSGDParam);
 DMLC_REGISTER_PARAMETER(MultiSGDMomParam);
 DMLC_REGISTER_PARAMETER(FTMLParam);
 DMLC_REGISTER_PARAMETER(AdamParam);
+DMLC_REGISTER_PARAMETER(MultiAdamParam);
 DMLC_REGISTER_PARAMETER(NAGParam);
 DMLC_REGISTER_PARAMETER(NAGMomParam);
 DMLC_REGISTER_PARAMETER(RMSPropParam);
@@ -43,6 +44,9 @@ DMLC_REGISTER_PARAMETER(FtrlParam);
 DMLC_REGISTER_PARAMETER(SignSGDParam);
 DMLC_REGISTER_PARAMETER(SignumParam);
 DMLC_REGISTER_PARAMETER(AdagradParam);
+DMLC_REGISTER_PARAMETER(MultiSparseAdamParam);
+DMLC_REGISTER_PARAMETER(MultiSparseAdagradParam);
+DMLC_REGISTER_PARAMETER(MultiSparseFtrlParam);
 DMLC_REGISTER_PARAMETER(LambUpdatePhaseOneParam);
 DMLC_REGISTER_PARAMETER(LambUpdatePhaseTwoParam);
 
@@ -754,6 +758,119 @@ only the row slices whose indices appear in grad.indices are updated (for w, m a
     .add_argument("var", "NDArray-or-Symbol", "Moving variance")
     .add_arguments(AdamParam::__FIELDS__());
 
+NNVM_REGISTER_OP(multi_adam_update)
+    .describe(R"code(Update function for Adam optimizer applied to many weights at once.
+
+For every weight, it applies the same update as ``adam_update``::
+
+ rescaled_grad = clip(grad * rescale_grad, clip_gradient) + wd * weight
+ m = beta1*m + (1-beta1)*rescaled_grad
+ v = beta2*v + (1-beta2)*(rescaled_grad**2)
+ w += - learning_rate * m / (sqrt(v) + epsilon)
+
+All the weights are updated in a single parallel pass.
+
+)code" ADD_FILELINE)
+    .set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights * 4);
+    })
+    .set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights);
+    })
+    .set_attr_parser(ParamParser<MultiAdamParam>)
+    .set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiAdamParam, 4>)
+    .set_attr<nnvm::FInferType>("FInferType", ElemwiseType<-1, -1>)
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       uint32_t num_args =
+                                           dmlc::get<MultiAdamParam>(attrs.parsed).num_weights;
+                                       std::vector<std::string> ret;
+                                       for (uint32_t i = 0; i < num_args; ++i) {
+                                         ret.push_back(std::string("weight_") + std::to_string(i));
+                                         ret.push_back(std::string("grad_") + std::to_string(i));
+                                         ret.push_back(std::string("mean_") + std::to_string(i));
+                                         ret.push_back(std::string("var_") + std::to_string(i));
+                                       }
+                                       return ret;
+                                     })
+    .set_attr<nnvm::FMutateInputs>("FMutateInputs",
+                                   [](const nnvm::NodeAttrs& attrs) {
+                                     std::vector<uint32_t> ret;
+                                     const MultiAdamParam& param =
+                                         dmlc::get<MultiAdamParam>(attrs.parsed);
+                                     ret.reserve(param.num_weights * 2);
+                                     for (int i = 0; i < param.num_weights; ++i) {
+                                       ret.push_back(i * 4 + 2);
+                                       ret.push_back(i * 4 + 3);
+                                     }
+                                     return ret;
+                                   })
+    .set_attr<FCompute>("FCompute<cpu>", MultiAdamUpdate<cpu, type_identity, 4>)
+    .add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients, means and variances")
+    .add_arguments(MultiAdamParam::__FIELDS__());
+
+NNVM_REGISTER_OP(multi_mp_adam_update)
+    .describe(R"code(Update function for multi-precision Adam optimizer applied to many
+weights at once.
+
+For every weight, it applies the same update as ``adam_update`` to the float32 master
+copy of the weight, and then casts it to the float16 or bfloat16 weight::
+
+ rescaled_grad = clip(grad * rescale_grad, clip_gradient) + wd * weight32
+ m = beta1*m + (1-beta1)*rescaled_grad
+ v = beta2*v + (1-beta2)*(rescaled_grad**2)
+ weight32 += - learning_rate * m / (sqrt(v) + epsilon)
+ weight = weight32
+
+All the weights are updated in a single parallel pass.
+
+)code" ADD_FILELINE)
+    .set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights * 5);
+    })
+    .set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiAdamParam& param = dmlc::get<MultiAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights);
+    })
+    .set_attr_parser(ParamParser<MultiAdamParam>)
+    .set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiAdamParam, 5>)
+    .set_attr<nnvm::FInferType>("FInferType", MP_MultiSGD_InferType<MultiAdamParam, 5, 3>)
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       uint32_t num_args =
+                                           dmlc::get<MultiAdamParam>(attrs.parsed).num_weights;
+                                       std::vector<std::string> ret;
+                                       for (uint32_t i = 0; i < num_args; ++i) {
+                                         ret.push_back(std::string("weight_") + std::to_string(i));
+                                         ret.push_back(std::string("grad_") + std::to_string(i));
+                                         ret.push_back(std::string("mean_") + std::to_string(i));
+                                         ret.push_back(std::string("var_") + std::to_string(i));
+                                         ret.push_back(std::string("weight32_") +
+                                                       std::to_string(i));
+                                       }
+                                       return ret;
+                                     })
+    .set_attr<nnvm::FMutateInputs>("FMutateInputs",
+                                   [](const nnvm::NodeAttrs& attrs) {
+                                     std::vector<uint32_t> ret;
+                                     const MultiAdamParam& param =
+                                         dmlc::get<MultiAdamParam>(attrs.parsed);
+                                     ret.reserve(param.num_weights * 3);
+                                     for (int i = 0; i < param.num_weights; ++i) {
+                                       ret.push_back(i * 5 + 2);
+                                       ret.push_back(i * 5 + 3);
+                                       ret.push_back(i * 5 + 4);
+                                     }
+                                     return ret;
+                                   })
+    .set_attr<FCompute>("FCompute<cpu>", MultiAdamUpdate<cpu, single_precision, 5>)
+    .add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients, means, variances and "
+                  "float32 master copies of the weights")
+    .add_arguments(MultiAdamParam::__FIELDS__());
+
 NNVM_REGISTER_OP(nag_mom_update)
     .describe(R"code(Update function for Nesterov Accelerated Gradient( NAG) optimizer.
 It updates the weights using the following formula,
@@ -967,6 +1084,188 @@ Note that non-zero values for the weight decay option are not supported.
     .add_argument("history", "NDArray-or-Symbol", "History")
     .add_arguments(AdagradParam::__FIELDS__());
 
+NNVM_REGISTER_OP(_sparse_multi_adam_update)
+    .describe(R"code(Lazy update function for Adam optimizer applied to many weights with
+``row_sparse`` gradients at once.
+
+For every weight, only the row slices whose indices appear in grad.indices are updated
+(for w, m and v), exactly as in ``adam_update`` with ``lazy_update=True``::
+
+ for row in grad.indices:
+     rescaled_grad[row] = clip(grad[row] * rescale_grad, clip_gradient) + wd * w[row]
+     m[row] = beta1 * m[row] + (1 - beta1) * rescaled_grad[row]
+     v[row] = beta2 * v[row] + (1 - beta2) * (rescaled_grad[row]**2)
+     w[row] = w[row] - learning_rate * m[row] / (sqrt(v[row]) + epsilon)
+
+The rows of all the gradients are updated in one parallel pass, so many small embedding
+tables do not pay one operator launch each.
+Weights, means and variances are of ``default`` or ``row_sparse`` storage type.
+
+)code" ADD_FILELINE)
+    .set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseAdamParam& param = dmlc::get<MultiSparseAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights * 4);
+    })
+    .set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseAdamParam& param = dmlc::get<MultiSparseAdamParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights);
+    })
+    .set_attr_parser(ParamParser<MultiSparseAdamParam>)
+    .set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiSparseAdamParam, 4>)
+    .set_attr<nnvm::FInferType>("FInferType", ElemwiseType<-1, -1>)
+    .set_attr<FInferStorageType>("FInferStorageType",
+                                 MultiSparseOptStorageType<MultiSparseAdamParam, 4>)
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       const MultiSparseAdamParam& param =
+                                           dmlc::get<MultiSparseAdamParam>(attrs.parsed);
+                                       const uint32_t num_args = param.num_weights;
+                                       std::vector<std::string> ret;
+                                       for (uint32_t i = 0; i < num_args; ++i) {
+                                         ret.push_back(std::string("weight_") + std::to_string(i));
+                                         ret.push_back(std::string("grad_") + std::to_string(i));
+                                         ret.push_back(std::string("mean_") + std::to_string(i));
+                                         ret.push_back(std::string("var_") + std::to_string(i));
+                                       }
+                                       return ret;
+                                     })
+    .set_attr<nnvm::FMutateInputs>("FMutateInputs",
+                                   [](const nnvm::NodeAttrs& attrs) {
+                                     std::vector<uint32_t> ret;
+                                     const MultiSparseAdamParam& param =
+                                         dmlc::get<MultiSparseAdamParam>(attrs.parsed);
+                                     ret.reserve(param.num_weights * 2);
+                                     for (int i = 0; i < param.num_weights; ++i) {
+                                       ret.push_back(i * 4 + 2);
+                                       ret.push_back(i * 4 + 3);
+                                     }
+                                     return ret;
+                                   })
+    .set_attr<FComputeEx>("FComputeEx<cpu>",
+                          MultiSparseOptUpdateEx<cpu, MultiSparseAdamRow, MultiSparseAdamParam, 4>)
+    .add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients, means and variances")
+    .add_arguments(MultiSparseAdamParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_sparse_multi_adagrad_update)
+    .describe(R"code(Update function for AdaGrad optimizer applied to many weights with
+``row_sparse`` gradients at once.
+
+For every weight, only the row slices whose indices appear in grad.indices are updated
+(for w and history)::
+
+ for row in grad.indices:
+     rescaled_grad[row] = clip(grad[row] * rescale_grad, clip_gradient) + wd * w[row]
+     history[row] = history[row] + square(rescaled_grad[row])
+     w[row] = w[row] - learning_rate * rescaled_grad[row] / (sqrt(history[row]) + epsilon)
+
+The rows of all the gradients are updated in one parallel pass.
+Weights and histories are of ``default`` or ``row_sparse`` storage type.
+
+)code" ADD_FILELINE)
+    .set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseAdagradParam& param = dmlc::get<MultiSparseAdagradParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights * 3);
+    })
+    .set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseAdagradParam& param = dmlc::get<MultiSparseAdagradParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights);
+    })
+    .set_attr_parser(ParamParser<MultiSparseAdagradParam>)
+    .set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiSparseAdagradParam, 3>)
+    .set_attr<nnvm::FInferType>("FInferType", ElemwiseType<-1, -1>)
+    .set_attr<FInferStorageType>("FInferStorageType",
+                                 MultiSparseOptStorageType<MultiSparseAdagradParam, 3>)
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       const MultiSparseAdagradParam& param =
+                                           dmlc::get<MultiSparseAdagradParam>(attrs.parsed);
+                                       const uint32_t num_args = param.num_weights;
+                                       std::vector<std::string> ret;
+                                       for (uint32_t i = 0; i < num_args; ++i) {
+                                         ret.push_back(std::string("weight_") + std::to_string(i));
+                                         ret.push_back(std::string("grad_") + std::to_string(i));
+                                         ret.push_back(std::string("history_") + std::to_string(i));
+                                       }
+                                       return ret;
+                                     })
+    .set_attr<nnvm::FMutateInputs>("FMutateInputs",
+                                   [](const nnvm::NodeAttrs& attrs) {
+                                     std::vector<uint32_t> ret;
+                                     const MultiSparseAdagradParam& param =
+                                         dmlc::get<MultiSparseAdagradParam>(attrs.parsed);
+                                     ret.reserve(param.num_weights);
+                                     for (int i = 0; i < param.num_weights; ++i) {
+                                       ret.push_back(i * 3 + 2);
+                                     }
+                                     return ret;
+                                   })
+    .set_attr<FComputeEx>(
+        "FComputeEx<cpu>",
+        MultiSparseOptUpdateEx<cpu, MultiSparseAdagradRow, MultiSparseAdagradParam, 3>)
+    .add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients and histories")
+    .add_arguments(MultiSparseAdagradParam::__FIELDS__());
+
+NNVM_REGISTER_OP(_sparse_multi_ftrl_update)
+    .describe(R"code(Update function for Ftrl optimizer applied to many weights with
+``row_sparse`` gradients at once.
+
+For every weight, only the row slices whose indices appear in grad.indices are updated
+(for w, z and n), exactly as in ``ftrl_update``::
+
+ for row in grad.indices:
+     rescaled_grad[row] = clip(grad[row] * rescale_grad, clip_gradient)
+     z[row] += rescaled_grad[row] - (sqrt(n[row] + rescaled_grad[row]**2) - sqrt(n[row])) * weight[row] / learning_rate
+     n[row] += rescaled_grad[row]**2
+     w[row] = (sign(z[row]) * lamda1 - z[row]) / ((beta + sqrt(n[row])) / learning_rate + wd) * (abs(z[row]) > lamda1)
+
+The rows of all the gradients are updated in one parallel pass.
+Weights, z and n are of ``default`` or ``row_sparse`` storage type.
+
+)code" ADD_FILELINE)
+    .set_num_inputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseFtrlParam& param = dmlc::get<MultiSparseFtrlParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights * 4);
+    })
+    .set_num_outputs([](const nnvm::NodeAttrs& attrs) {
+      const MultiSparseFtrlParam& param = dmlc::get<MultiSparseFtrlParam>(attrs.parsed);
+      return static_cast<uint32_t>(param.num_weights);
+    })
+    .set_attr_parser(ParamParser<MultiSparseFtrlParam>)
+    .set_attr<mxnet::FInferShape>("FInferShape", MultiSGDShape<MultiSparseFtrlParam, 4>)
+    .set_attr<nnvm::FInferType>("FInferType", ElemwiseType<-1, -1>)
+    .set_attr<FInferStorageType>("FInferStorageType",
+                                 MultiSparseOptStorageType<MultiSparseFtrlParam, 4>)
+    .set_attr<nnvm::FListInputNames>("FListInputNames",
+                                     [](const NodeAttrs& attrs) {
+                                       const MultiSparseFtrlParam& param =
+                                           dmlc::get<MultiSparseFtrlParam>(attrs.parsed);
+                                       const uint32_t num_args = param.num_weights;
+                                       std::vector<std::string> ret;
+                                       for (uint32_t i = 0; i < num_args; ++i) {
+                                         ret.push_back(std::string("weight_") + std::to_string(i));
+                                         ret.push_back(std::string("grad_") + std::to_string(i));
+                                         ret.push_back(std::string("z_") + std::to_string(i));
+                                         ret.push_back(std::string("n_") + std::to_string(i));
+                                       }
+                                       return ret;
+                                     })
+    .set_attr<nnvm::FMutateInputs>("FMutateInputs",
+                                   [](const nnvm::NodeAttrs& attrs) {
+                                     std::vector<uint32_t> ret;
+                                     const MultiSparseFtrlParam& param =
+                                         dmlc::get<MultiSparseFtrlParam>(attrs.parsed);
+                                     ret.reserve(param.num_weights * 2);
+                                     for (int i = 0; i < param.num_weights; ++i) {
+                                       ret.push_back(i * 4 + 2);
+                                       ret.push_back(i * 4 + 3);
+                                     }
+                                     return ret;
+                                   })
+    .set_attr<FComputeEx>("FComputeEx<cpu>",
+                          MultiSparseOptUpdateEx<cpu, MultiSparseFtrlRow, MultiSparseFtrlParam, 4>)
+    .add_argument("data", "NDArray-or-Symbol[]", "Weights, gradients, z and n")
+    .add_arguments(MultiSparseFtrlParam::__FIELDS__());
+
 NNVM_REGISTER_OP(lamb_update_phase1)
     .describe(R"code(Phase I of lamb update it performs the following operations and returns g:.
 
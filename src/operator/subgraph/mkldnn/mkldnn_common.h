@@ -27,8 +27,10 @@
 #ifndef MXNET_OPERATOR_SUBGRAPH_MKLDNN_MKLDNN_COMMON_H_
 #define MXNET_OPERATOR_SUBGRAPH_MKLDNN_MKLDNN_COMMON_H_
 #if MXNET_USE_ONEDNN == 1
+#include <string>
 #include <vector>
 
+#include "../../nn/mkldnn/mkldnn_weight_cache-inl.h"
 #include "../../numpy/np_matrix_op-inl.h"
 
 namespace mxnet {
@@ -101,22 +103,41 @@ static inline void ConvertWeightBias2MKLDNN(NDArray* weight,
                                             float data_scale,
                                             const std::vector<float>& weight_scales,
                                             const bool submit = true) {
-  MKLDNNStream* stream           = MKLDNNStream::Get();
-  const auto new_weight          = NDArray(weight_md);
-  const auto conv_weights_memory = new_weight.GetMKLDNNData();
-  mkldnn::primitive_attr weight_attr;
-  if (weight_scales.size()) {
-    const int weight_mask = (weight_scales.size()) == 1 ? 0 : 1;
-    weight_attr.set_output_scales(weight_mask, weight_scales);
-  }
+  MKLDNNStream* stream        = MKLDNNStream::Get();
   auto default_weights_memory = GetWeights(*weight, num_group);
   if (default_weights_memory == nullptr)
     default_weights_memory = weight->GetMKLDNNData();
-  const auto weight_reorder_pd =
-      mkldnn::reorder::primitive_desc(*default_weights_memory, *conv_weights_memory, weight_attr);
-  MKLDNNStream::Get()->RegisterPrimArgs(
-      mkldnn::reorder(weight_reorder_pd),
-      {{MKLDNN_ARG_FROM, *default_weights_memory}, {MKLDNN_ARG_TO, *conv_weights_memory}});
+  // operators with the same weights share the packed copy
+  const bool use_cache = MKLDNNWeightCache::Level() > 0;
+  std::string weight_key;
+  NDArray new_weight;
+  if (use_cache) {
+    weight_key = MKLDNNWeightCache::Key(*default_weights_memory, weight_md, weight_scales);
+    new_weight = MKLDNNWeightCache::Get()->Find(weight_key);
+  }
+  if (new_weight.is_none()) {
+    new_weight                     = NDArray(weight_md);
+    const auto conv_weights_memory = new_weight.GetMKLDNNData();
+    mkldnn::primitive_attr weight_attr;
+    if (weight_scales.size()) {
+      const int weight_mask = (weight_scales.size()) == 1 ? 0 : 1;
+      weight_attr.set_output_scales(weight_mask, weight_scales);
+    }
+    const auto weight_reorder_pd =
+        mkldnn::reorder::primitive_desc(*default_weights_memory, *conv_weights_memory, weight_attr);
+    if (use_cache) {
+      // the entry must be packed before other operators can find it, so the reorder runs on its
+      // own stream and leaves the primitives registered by the caller to its submit
+      mkldnn::stream s(CpuEngine::Get()->get_engine());
+      mkldnn::reorder(weight_reorder_pd).execute(s, *default_weights_memory, *conv_weights_memory);
+      s.wait();
+      new_weight = MKLDNNWeightCache::Get()->Insert(weight_key, new_weight);
+    } else {
+      stream->RegisterPrimArgs(
+          mkldnn::reorder(weight_reorder_pd),
+          {{MKLDNN_ARG_FROM, *default_weights_memory}, {MKLDNN_ARG_TO, *conv_weights_memory}});
+    }
+  }
   NDArray new_bias;
   if (has_bias && data_scale) {
     std::vector<float> bias_scales(weight_scales.size());
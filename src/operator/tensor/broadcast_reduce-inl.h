@@ -407,12 +407,152 @@ inline int fastest_stride(const TShape& small, const TShape& big, const TShape&
 
 }  // namespace
 
+/*!
+ * \brief Layout of the innermost non-trivial output axis of a broadcast binary op: both
+ *        operands run along it (e.g. (N, C) op (1, C)), or one of them is constant along it
+ *        (e.g. (N, C) op (N, 1), (N, C, H, W) op (1, C, 1, 1) or an operand of size 1).
+ */
+enum class BroadcastRowPattern { kBothContiguous, kLhsScalar, kRhsScalar };
+
+/*!
+ * \brief Apply OP to a row of len outputs. The loop touches contiguous memory only, so that
+ *        it can be vectorized.
+ */
+template <OpReqType req, BroadcastRowPattern pattern, typename DType, typename OP>
+MSHADOW_XINLINE void binary_broadcast_row(const index_t len,
+                                          const DType* lhs,
+                                          const DType* rhs,
+                                          DType* out) {
+  if (pattern == BroadcastRowPattern::kLhsScalar) {
+    const DType lval = lhs[0];
+    for (index_t i = 0; i < len; ++i) {
+      KERNEL_ASSIGN(out[i], req, OP::Map(lval, rhs[i]));
+    }
+  } else if (pattern == BroadcastRowPattern::kRhsScalar) {
+    const DType rval = rhs[0];
+    for (index_t i = 0; i < len; ++i) {
+      KERNEL_ASSIGN(out[i], req, OP::Map(lhs[i], rval));
+    }
+  } else {
+    for (index_t i = 0; i < len; ++i) {
+      KERNEL_ASSIGN(out[i], req, OP::Map(lhs[i], rhs[i]));
+    }
+  }
+}
+
+/*!
+ * \brief Run binary_broadcast_row over nrows rows of len outputs, each cut into chunks of at
+ *        most chunk elements so that a few long rows still keep all the threads busy.
+ */
+template <OpReqType req, BroadcastRowPattern pattern, int ndim, typename DType, typename OP>
+void binary_broadcast_rows(const index_t nrows,
+                           const index_t len,
+                           const index_t chunk,
+                           const Shape<ndim>& row_shape,
+                           const Shape<ndim>& lstride,
+                           const Shape<ndim>& rstride,
+                           const DType* lhs,
+                           const DType* rhs,
+                           DType* out,
+                           const int omp_threads) {
+  const index_t nchunks = (len + chunk - 1) / chunk;
+  const index_t nitems  = nrows * nchunks;
+  const index_t lstep   = pattern == BroadcastRowPattern::kLhsScalar ? 0 : 1;
+  const index_t rstep   = pattern == BroadcastRowPattern::kRhsScalar ? 0 : 1;
+#pragma omp parallel for num_threads(omp_threads)
+  for (index_t item = 0; item < nitems; ++item) {
+    const index_t row       = item / nchunks;
+    const index_t begin     = item % nchunks * chunk;
+    const Shape<ndim> coord = mxnet_op::unravel(row, row_shape);
+    binary_broadcast_row<req, pattern, DType, OP>(
+        std::min(chunk, len - begin),
+        lhs + mxnet_op::dot(coord, lstride) + lstep * begin,
+        rhs + mxnet_op::dot(coord, rstride) + rstep * begin,
+        out + row * len + begin);
+  }
+}
+
+/*!
+ * \brief Broadcast binary op computed row by row along the innermost non-trivial output axis.
+ *        The row pattern is selected once for the shape pair; only the start of each row is
+ *        computed from its coordinates, instead of the operand offsets of every element.
+ * \return false if the rows are too short for this to pay off.
+ */
+template <int ndim, typename DType, typename OP>
+bool BinaryBroadcastRowsImpl(const OpReqType req,
+                             const TBlob& lhs,
+                             const TBlob& rhs,
+                             const TBlob& out) {
+  const index_t kMinRowLength = 16;
+  const index_t kChunk        = 8192;
+  const Shape<ndim> oshape    = out.shape_.get<ndim>();
+  const Shape<ndim> lshape    = lhs.shape_.get<ndim>();
+  const Shape<ndim> rshape    = rhs.shape_.get<ndim>();
+  int axis                    = ndim - 1;
+  while (axis > 0 && oshape[axis] == 1) {
+    --axis;
+  }
+  const index_t len = oshape[axis];
+  if (len < kMinRowLength) {
+    return false;
+  }
+  Shape<ndim> row_shape     = oshape;
+  row_shape[axis]           = 1;
+  const Shape<ndim> lstride = mxnet_op::calc_stride(lshape);
+  const Shape<ndim> rstride = mxnet_op::calc_stride(rshape);
+  const int omp_threads =
+      out.Size() >= kChunk ? engine::OpenMP::Get()->GetRecommendedOMPThreadCount() : 1;
+  MXNET_ASSIGN_REQ_SWITCH(req, Req, {
+    if (lshape[axis] == 1) {
+      binary_broadcast_rows<Req, BroadcastRowPattern::kLhsScalar, ndim, DType, OP>(
+          row_shape.Size(),
+          len,
+          kChunk,
+          row_shape,
+          lstride,
+          rstride,
+          lhs.dptr<DType>(),
+          rhs.dptr<DType>(),
+          out.dptr<DType>(),
+          omp_threads);
+    } else if (rshape[axis] == 1) {
+      binary_broadcast_rows<Req, BroadcastRowPattern::kRhsScalar, ndim, DType, OP>(
+          row_shape.Size(),
+          len,
+          kChunk,
+          row_shape,
+          lstride,
+          rstride,
+          lhs.dptr<DType>(),
+          rhs.dptr<DType>(),
+          out.dptr<DType>(),
+          omp_threads);
+    } else {
+      binary_broadcast_rows<Req, BroadcastRowPattern::kBothContiguous, ndim, DType, OP>(
+          row_shape.Size(),
+          len,
+          kChunk,
+          row_shape,
+          lstride,
+          rstride,
+          lhs.dptr<DType>(),
+          rhs.dptr<DType>(),
+          out.dptr<DType>(),
+          omp_threads);
+    }
+  });
+  return true;
+}
+
 template <int ndim, typename DType, typename OP>
 void BinaryBroadcastComputeImpl(Stream<cpu>* s,
                                 const OpReqType req,
                                 const TBlob& lhs,
                                 const TBlob& rhs,
                                 const TBlob& out) {
+  if (BinaryBroadcastRowsImpl<ndim, DType, OP>(req, lhs, rhs, out)) {
+    return;
+  }
   mshadow::Shape<ndim> oshape  = out.shape_.get<ndim>();
   mshadow::Shape<ndim> lstride = mxnet_op::calc_stride(lhs.shape_.get<ndim>());
   mshadow::Shape<ndim> rstride = mxnet_op::calc_stride(rhs.shape_.get<ndim>());
@@ -483,6 +623,285 @@ void seq_reduce_compute_extra_mem(const size_t N,
   }
 }
 
+/*!
+ * \brief Non-volatile counterparts of the reducers, used by the contiguous reduction kernels
+ *        below so that the compiler can vectorize their loops. Reducers without a
+ *        specialization go through seq_reduce_compute.
+ */
+template <typename Reducer>
+struct ContiguousReducer {
+  static constexpr bool enabled = false;
+};
+
+template <>
+struct ContiguousReducer<mshadow::red::sum> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& dst, const AType src, AType& residual) {
+    const AType y = src - residual;
+    const AType t = dst + y;
+    // t is infinite iff it is not NaN and t - t is NaN
+    residual = (t == t && (t - t) != (t - t)) ? AType(0) : AType((t - dst) - y);
+    dst      = t;
+  }
+};
+
+template <>
+struct ContiguousReducer<mshadow_op::sum> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& dst, const AType src, AType& residual) {
+    const AType y = src - residual;
+    const AType t = dst + y;
+    residual      = (t - dst) - y;
+    dst           = t;
+  }
+};
+
+template <>
+struct ContiguousReducer<mshadow::red::maximum> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& dst, const AType src, AType& none) {
+    dst = (dst != dst || dst >= src) ? dst : src;
+  }
+};
+
+template <>
+struct ContiguousReducer<mshadow::red::minimum> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& dst, const AType src, AType& none) {
+    dst = (dst != dst || dst <= src) ? dst : src;
+  }
+};
+
+template <>
+struct ContiguousReducer<mshadow_op::product> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& dst, const AType src, AType& none) {
+    dst *= src;
+  }
+};
+
+template <>
+struct ContiguousReducer<mshadow_op::nrm2> {
+  static constexpr bool enabled = true;
+  template <typename AType>
+  MSHADOW_XINLINE static void Reduce(AType& sum_of_squares, const AType src, AType& scale) {
+    const AType abs = mshadow_op::abs::Map(src);
+    if (abs != AType(0)) {
+      if (scale < abs) {
+        sum_of_squares = 1 + sum_of_squares * (scale / abs) * (scale / abs);
+        scale          = abs;
+      } else {
+        sum_of_squares = sum_of_squares + (abs / scale) * (abs / scale);
+      }
+    }
+  }
+};
+
+/*!
+ * \brief Reduction whose reduced axes form a single block: big is viewed as
+ *        [outer, reduce, inner] and small as [outer, inner].
+ */
+struct ReduceBlockShape {
+  index_t outer;
+  index_t reduce;
+  index_t inner;
+};
+
+/*!
+ * \brief Classify the reduction from big to small.
+ * \return false if the reduced axes are interleaved with kept axes.
+ */
+template <int ndim>
+inline bool GetReduceBlockShape(const Shape<ndim>& small,
+                                const Shape<ndim>& big,
+                                ReduceBlockShape* block) {
+  int first = -1, last = -1;
+  for (int i = 0; i < ndim; ++i) {
+    if (small[i] != big[i]) {
+      if (first < 0) {
+        first = i;
+      } else {
+        for (int k = last + 1; k < i; ++k) {
+          if (big[k] != 1) {
+            return false;
+          }
+        }
+      }
+      last = i;
+    }
+  }
+  if (first < 0) {
+    return false;
+  }
+  block->outer = block->reduce = block->inner = 1;
+  for (int i = 0; i < ndim; ++i) {
+    index_t* extent = i < first ? &block->outer : (i <= last ? &block->reduce : &block->inner);
+    *extent *= big[i];
+  }
+  return true;
+}
+
+/*!
+ * \brief Reduce len contiguous elements into (val, residual) with kLanes independent
+ *        accumulators, which breaks the loop-carried dependency of a single accumulator.
+ */
+template <typename Reducer, typename AType, typename DType, typename OP>
+MSHADOW_XINLINE void reduce_contiguous_lanes(const DType* __restrict big,
+                                             const index_t len,
+                                             AType* val,
+                                             AType* residual) {
+  const int kLanes = 8;
+  if (len < 2 * kLanes) {
+    Reducer::SetInitValue(*val, *residual);
+    for (index_t k = 0; k < len; ++k) {
+      ContiguousReducer<Reducer>::Reduce(*val, static_cast<AType>(OP::Map(big[k])), *residual);
+    }
+    return;
+  }
+  AType lane_val[kLanes], lane_residual[kLanes];
+  for (int l = 0; l < kLanes; ++l) {
+    Reducer::SetInitValue(lane_val[l], lane_residual[l]);
+  }
+  index_t k = 0;
+  for (; k + kLanes <= len; k += kLanes) {
+#pragma unroll
+    for (int l = 0; l < kLanes; ++l) {
+      ContiguousReducer<Reducer>::Reduce(
+          lane_val[l], static_cast<AType>(OP::Map(big[k + l])), lane_residual[l]);
+    }
+  }
+  for (; k < len; ++k) {
+    ContiguousReducer<Reducer>::Reduce(
+        lane_val[0], static_cast<AType>(OP::Map(big[k])), lane_residual[0]);
+  }
+  for (int l = 1; l < kLanes; ++l) {
+    Reducer::Merge(lane_val[0], lane_residual[0], lane_val[l], lane_residual[l]);
+  }
+  *val      = lane_val[0];
+  *residual = lane_residual[0];
+}
+
+/*!
+ * \brief Reduce rows [row_begin, row_end) of a [reduce, inner] slice, restricted to the columns
+ *        [0, len) of the tile starting at big, into val and residual. Four rows are accumulated
+ *        per pass over the tile so that the accumulators stay in registers.
+ */
+template <typename Reducer, typename AType, typename DType, typename OP>
+MSHADOW_XINLINE void reduce_contiguous_tile(const DType* __restrict big,
+                                            const index_t inner,
+                                            const index_t row_begin,
+                                            const index_t row_end,
+                                            const index_t len,
+                                            AType* __restrict val,
+                                            AType* __restrict residual) {
+  index_t r = row_begin;
+  for (; r + 4 <= row_end; r += 4) {
+    const DType* row0 = big + r * inner;
+    const DType* row1 = row0 + inner;
+    const DType* row2 = row1 + inner;
+    const DType* row3 = row2 + inner;
+    for (index_t i = 0; i < len; ++i) {
+      AType v = val[i], res = residual[i];
+      ContiguousReducer<Reducer>::Reduce(v, static_cast<AType>(OP::Map(row0[i])), res);
+      ContiguousReducer<Reducer>::Reduce(v, static_cast<AType>(OP::Map(row1[i])), res);
+      ContiguousReducer<Reducer>::Reduce(v, static_cast<AType>(OP::Map(row2[i])), res);
+      ContiguousReducer<Reducer>::Reduce(v, static_cast<AType>(OP::Map(row3[i])), res);
+      val[i]      = v;
+      residual[i] = res;
+    }
+  }
+  for (; r < row_end; ++r) {
+    const DType* row = big + r * inner;
+    for (index_t i = 0; i < len; ++i) {
+      ContiguousReducer<Reducer>::Reduce(val[i], static_cast<AType>(OP::Map(row[i])), residual[i]);
+    }
+  }
+}
+
+/*!
+ * \brief Reduction over a single block of axes with contiguous inner loops. The innermost-axis
+ *        case (inner == 1) reduces each row with several accumulator lanes; otherwise the inner
+ *        axis is cut into tiles that are accumulated row by row. Work is split along the reduced
+ *        axis as well when there are too few outputs to keep all the threads busy, the partial
+ *        results being merged afterwards.
+ */
+template <typename Reducer, typename AType, typename DType, typename OType, typename OP>
+void seq_reduce_compute_contiguous(const ReduceBlockShape& block,
+                                   const bool addto,
+                                   const DType* big,
+                                   OType* small) {
+  const index_t kTile         = 256;
+  const index_t kMinSplitSize = 8192;
+  const index_t outer = block.outer, reduce = block.reduce, inner = block.inner;
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
+  const index_t tile    = std::min(inner, kTile);
+  const index_t ntiles  = (inner + tile - 1) / tile;
+  const index_t nblocks = outer * ntiles;
+  // number of pieces the reduced axis is cut into
+  index_t nsplit = 1;
+  if (nblocks < omp_threads) {
+    const index_t min_rows = (kMinSplitSize + tile - 1) / tile;
+    nsplit = std::max<index_t>(
+        1, std::min<index_t>((omp_threads + nblocks - 1) / nblocks, reduce / min_rows));
+  }
+  const index_t rows_per_split = (reduce + nsplit - 1) / nsplit;
+  const index_t nitems         = nblocks * nsplit;
+  // partial (val, residual) of each split, only needed when the reduced axis is split
+  std::unique_ptr<AType[]> partial;
+  if (nsplit > 1) {
+    partial = std::make_unique<AType[]>(2 * nsplit * outer * inner);
+  }
+#pragma omp parallel for num_threads(omp_threads) if (nitems > 1)
+  for (index_t item = 0; item < nitems; ++item) {
+    const index_t split     = item % nsplit;
+    const index_t o         = item / nsplit / ntiles;
+    const index_t col       = item / nsplit % ntiles * tile;
+    const index_t len       = std::min(tile, inner - col);
+    const index_t row_begin = split * rows_per_split;
+    const index_t row_end   = std::min(reduce, row_begin + rows_per_split);
+    const DType* src        = big + o * reduce * inner + col;
+    AType val[kTile], residual[kTile];
+    if (inner == 1) {
+      reduce_contiguous_lanes<Reducer, AType, DType, OP>(
+          src + row_begin, row_end - row_begin, &val[0], &residual[0]);
+    } else {
+      for (index_t i = 0; i < len; ++i) {
+        Reducer::SetInitValue(val[i], residual[i]);
+      }
+      reduce_contiguous_tile<Reducer, AType, DType, OP>(
+          src, inner, row_begin, row_end, len, val, residual);
+    }
+    if (nsplit == 1) {
+      for (index_t i = 0; i < len; ++i) {
+        Reducer::Finalize(val[i], residual[i]);
+        assign(&small[o * inner + col + i], addto, OType(val[i]));
+      }
+    } else {
+      AType* out = &partial[2 * (split * outer * inner + o * inner + col)];
+      for (index_t i = 0; i < len; ++i) {
+        out[2 * i]     = val[i];
+        out[2 * i + 1] = residual[i];
+      }
+    }
+  }
+  if (nsplit > 1) {
+    for (index_t idx = 0; idx < outer * inner; ++idx) {
+      AType val = partial[2 * idx], residual = partial[2 * idx + 1];
+      for (index_t split = 1; split < nsplit; ++split) {
+        AType* src = &partial[2 * (split * outer * inner + idx)];
+        Reducer::Merge(val, residual, src[0], src[1]);
+      }
+      Reducer::Finalize(val, residual);
+      assign(&small[idx], addto, OType(val));
+    }
+  }
+}
+
 template <typename Reducer, int ndim, typename DType, typename OP, bool safe_acc = false>
 void Reduce(Stream<cpu>* s,
             const TBlob& small,
@@ -494,7 +913,18 @@ void Reduce(Stream<cpu>* s,
   Shape<ndim> rshape, rstride;
   diff(small.shape_.get<ndim>(), big.shape_.get<ndim>(), &rshape, &rstride);
   size_t N = small.shape_.Size(), M = rshape.Size();
+  ReduceBlockShape block;
+  const bool contiguous =
+      ContiguousReducer<Reducer>::enabled &&
+      GetReduceBlockShape(small.shape_.get<ndim>(), big.shape_.get<ndim>(), &block);
   if (!safe_acc) {
+    if constexpr (ContiguousReducer<Reducer>::enabled) {
+      if (contiguous) {
+        seq_reduce_compute_contiguous<Reducer, DType, DType, DType, OP>(
+            block, req == kAddTo, big.dptr<DType>(), small.dptr<DType>());
+        return;
+      }
+    }
     seq_reduce_compute<Reducer, ndim, DType, DType, DType, OP>(N,
                                                                M,
                                                                req == kAddTo,
@@ -509,6 +939,13 @@ void Reduce(Stream<cpu>* s,
       typedef typename std::conditional<safe_acc, AType, DataType>::type AccType;
       MSHADOW_TYPE_SWITCH_WITH_BOOL(small.type_flag_, OType, {
         typedef typename std::conditional<safe_acc, OType, DataType>::type OutType;
+        if constexpr (ContiguousReducer<Reducer>::enabled) {
+          if (contiguous) {
+            seq_reduce_compute_contiguous<Reducer, AccType, DataType, OutType, OP>(
+                block, req == kAddTo, big.dptr<DataType>(), small.dptr<OutType>());
+            return;
+          }
+        }
         seq_reduce_compute<Reducer, ndim, AccType, DataType, OutType, OP>(N,
                                                                           M,
                                                                           req == kAddTo,
@@ -366,41 +366,123 @@ inline bool DotBackwardInferStorageType(const nnvm::NodeAttrs& attrs,
   return dispatched;
 }
 
+/*!
+ * \brief out[0, num_cols) += val * rhs[0, num_cols)
+ */
+template <typename DType>
+MSHADOW_CINLINE void DotRowAxpy(DType* out,
+                                const DType* rhs,
+                                const DType val,
+                                const nnvm::dim_t num_cols) {
+#pragma omp simd
+  for (nnvm::dim_t l = 0; l < num_cols; ++l) {
+    out[l] += rhs[l] * val;
+  }
+}
+
+/*!
+ * \brief Accumulate the nonzeros [k_begin, k_end) of one csr row times the matching
+ *        rows of dns into out. Four nonzeros are folded into every pass over the output
+ *        row, so it is loaded and stored once per four dense rows instead of once per row.
+ */
+template <typename DType, typename CType>
+MSHADOW_CINLINE void DotCsrRowAccumulate(DType* out,
+                                         const DType* data_l,
+                                         const CType* col_idx_l,
+                                         const DType* data_r,
+                                         nnvm::dim_t k_begin,
+                                         const nnvm::dim_t k_end,
+                                         const nnvm::dim_t num_cols) {
+  using nnvm::dim_t;
+  for (; k_begin + 4 <= k_end; k_begin += 4) {
+    const DType v0  = data_l[k_begin];
+    const DType v1  = data_l[k_begin + 1];
+    const DType v2  = data_l[k_begin + 2];
+    const DType v3  = data_l[k_begin + 3];
+    const DType* r0 = data_r + static_cast<dim_t>(col_idx_l[k_begin]) * num_cols;
+    const DType* r1 = data_r + static_cast<dim_t>(col_idx_l[k_begin + 1]) * num_cols;
+    const DType* r2 = data_r + static_cast<dim_t>(col_idx_l[k_begin + 2]) * num_cols;
+    const DType* r3 = data_r + static_cast<dim_t>(col_idx_l[k_begin + 3]) * num_cols;
+#pragma omp simd
+    for (dim_t l = 0; l < num_cols; ++l) {
+      out[l] += r0[l] * v0 + r1[l] * v1 + r2[l] * v2 + r3[l] * v3;
+    }
+  }
+  for (; k_begin < k_end; ++k_begin) {
+    DotRowAxpy(
+        out, data_r + static_cast<dim_t>(col_idx_l[k_begin]) * num_cols, data_l[k_begin], num_cols);
+  }
+}
+
+/*!
+ * \brief Find the coordinate of a diagonal of the merge path between the row ends
+ *        (indptr[1:]) and the nonzeros of a csr matrix, i.e. the number of rows completed
+ *        and the number of nonzeros consumed after `diagonal` steps of the merge.
+ */
+template <typename IType>
+MSHADOW_CINLINE void CsrMergePathSearch(const nnvm::dim_t diagonal,
+                                        const IType* indptr,
+                                        const nnvm::dim_t num_rows,
+                                        const nnvm::dim_t nnz,
+                                        nnvm::dim_t* row,
+                                        nnvm::dim_t* k) {
+  using nnvm::dim_t;
+  dim_t lo = std::max<dim_t>(diagonal - nnz, 0);
+  dim_t hi = std::min<dim_t>(diagonal, num_rows);
+  while (lo < hi) {
+    const dim_t pivot = (lo + hi) / 2;
+    if (static_cast<dim_t>(indptr[pivot + 1]) <= diagonal - pivot - 1) {
+      lo = pivot + 1;
+    } else {
+      hi = pivot;
+    }
+  }
+  *row = lo;
+  *k   = diagonal - lo;
+}
+
 /*!
  * \brief CPU Kernel of dot(csr, dns1) = dns2
- * Parallelization by row blocks
+ * Parallelization by merge-path partitions: every thread gets the same number of rows plus
+ * nonzeros, so a few very long rows do not serialize the whole product. A thread finishes
+ * every row whose end falls into its partition and writes it to out directly; the partial sum
+ * of the row it leaves unfinished goes to its carry-out slot, which is added afterwards.
  */
-struct DotCsrDnsDnsByRowBlocks {
+struct DotCsrDnsDnsMergePath {
   /*!
    * \brief
-   * \param i the i-th thread
+   * \param i the i-th partition
    */
   template <typename DType, typename IType, typename CType>
   MSHADOW_CINLINE static void Map(int i,
                                   DType* out,
+                                  DType* carry_out,
+                                  nnvm::dim_t* carry_row,
                                   const DType* data_l,
                                   const IType* indptr_l,
                                   const CType* col_idx_l,
                                   const DType* data_r,
-                                  const nnvm::dim_t seg_len,
+                                  const nnvm::dim_t items_per_part,
                                   const nnvm::dim_t num_rows,
                                   const nnvm::dim_t num_cols) {
     using nnvm::dim_t;
-    const dim_t seg_start = i * seg_len;
-    if (seg_start >= num_rows)
-      return;
-    const dim_t seg_end = std::min(seg_start + seg_len, num_rows);
-    for (dim_t j = seg_start; j < seg_end; ++j) {
-      if (indptr_l[j] == indptr_l[j + 1])
-        continue;
-      const dim_t offset_out = j * num_cols;
-      for (IType k = indptr_l[j]; k < indptr_l[j + 1]; ++k) {
-        const DType val      = data_l[k];
-        const dim_t offset_r = col_idx_l[k] * num_cols;
-        for (dim_t l = 0; l < num_cols; ++l) {
-          out[offset_out + l] += data_r[offset_r + l] * val;
-        }
-      }
+    const dim_t nnz   = indptr_l[num_rows];
+    const dim_t total = num_rows + nnz;
+    dim_t row, k, row_end, k_end;
+    CsrMergePathSearch(std::min(i * items_per_part, total), indptr_l, num_rows, nnz, &row, &k);
+    CsrMergePathSearch(
+        std::min((i + 1) * items_per_part, total), indptr_l, num_rows, nnz, &row_end, &k_end);
+    for (; row < row_end; ++row) {
+      const dim_t row_k_end = indptr_l[row + 1];
+      DotCsrRowAccumulate(out + row * num_cols, data_l, col_idx_l, data_r, k, row_k_end, num_cols);
+      k = row_k_end;
+    }
+    carry_row[i] = num_rows;
+    if (k < k_end) {
+      DType* carry = carry_out + i * num_cols;
+      std::fill(carry, carry + num_cols, DType(0));
+      DotCsrRowAccumulate(carry, data_l, col_idx_l, data_r, k, k_end, num_cols);
+      carry_row[i] = row_end;
     }
   }
 };
@@ -438,11 +520,7 @@ struct DotCsrTransDnsDnsByRowBlocks {
         const CType col_idx = col_idx_l[k];
         if (col_idx < seg_start || col_idx >= seg_end)
           continue;
-        const dim_t offset_out = col_idx * num_cols;
-        const DType val        = data_l[k];
-        for (dim_t l = 0; l < num_cols; ++l) {
-          out[offset_out + l] += data_r[offset_r + l] * val;
-        }
+        DotRowAxpy(out + col_idx * num_cols, data_r + offset_r, data_l[k], num_cols);
       }
     }
   }
@@ -486,13 +564,8 @@ struct DotCsrTransDnsRspByRowBlocks {
         if (col_idx < col_start || col_idx >= col_end)
           continue;
 
-        const nnvm::dim_t rsp_row    = row_flg_sum[col_idx] - 1;
-        const nnvm::dim_t offset_out = rsp_row * num_cols;
-        const DType val              = data_l[k];
-
-        for (dim_t l = 0; l < num_cols; ++l) {
-          out[offset_out + l] += data_r[offset_r + l] * val;
-        }
+        const nnvm::dim_t rsp_row = row_flg_sum[col_idx] - 1;
+        DotRowAxpy(out + rsp_row * num_cols, data_r + offset_r, data_l[k], num_cols);
       }
     }
   }
@@ -839,17 +912,11 @@ inline void DotCsrDnsDnsImpl(const OpContext& ctx,
           num_threads = data_out.Size();
           mxnet_op::Kernel<mxnet_op::set_zero, cpu>::Launch(s, num_threads, data_out.dptr<DType>());
         }
-        num_threads                        = mxnet_op::get_num_threads<cpu>(data_out.shape_[0]);
-        bool dynamic                       = false;
-        const dim_t large_matrix_threshold = 1024 * 10;
-        if (data_out.shape_[0] > large_matrix_threshold) {
-          dynamic = true;
-          // each unit of work processes at least 1024 elements in the output
-          const dim_t unit_work_per_thread = 1024;
-          num_threads                      = data_out.Size() / unit_work_per_thread;
-        }
-        dim_t seg_len = (data_out.shape_[0] + num_threads - 1) / num_threads;
+        const dim_t num_rows = data_out.shape_[0];
+        const dim_t num_cols = data_out.shape_[1];
         if (trans_lhs) {
+          num_threads   = mxnet_op::get_num_threads<cpu>(num_rows);
+          dim_t seg_len = (num_rows + num_threads - 1) / num_threads;
           mxnet_op::Kernel<DotCsrTransDnsDnsByRowBlocks, cpu>::Launch(s,
                                                                       num_threads,
                                                                       data_out.dptr<DType>(),
@@ -859,31 +926,38 @@ inline void DotCsrDnsDnsImpl(const OpContext& ctx,
                                                                       data_r.dptr<DType>(),
                                                                       seg_len,
                                                                       lhs.shape()[0],
-                                                                      data_out.shape_[0],
-                                                                      data_out.shape_[1]);
+                                                                      num_rows,
+                                                                      num_cols);
         } else {
-          if (dynamic) {
-            mxnet_op::Kernel<DotCsrDnsDnsByRowBlocks, cpu>::LaunchDynamic(s,
-                                                                          num_threads,
-                                                                          data_out.dptr<DType>(),
-                                                                          data_l.dptr<DType>(),
-                                                                          indptr_l.dptr<IType>(),
-                                                                          col_idx_l.dptr<CType>(),
-                                                                          data_r.dptr<DType>(),
-                                                                          seg_len,
-                                                                          data_out.shape_[0],
-                                                                          data_out.shape_[1]);
-          } else {
-            mxnet_op::Kernel<DotCsrDnsDnsByRowBlocks, cpu>::Launch(s,
-                                                                   num_threads,
-                                                                   data_out.dptr<DType>(),
-                                                                   data_l.dptr<DType>(),
-                                                                   indptr_l.dptr<IType>(),
-                                                                   col_idx_l.dptr<CType>(),
-                                                                   data_r.dptr<DType>(),
-                                                                   seg_len,
-                                                                   data_out.shape_[0],
-                                                                   data_out.shape_[1]);
+          const dim_t nnz       = col_idx_l.Size();
+          const dim_t num_parts = std::max<dim_t>(
+              1, std::min<dim_t>(mxnet_op::get_num_threads<cpu>(num_rows), num_rows + nnz));
+          const dim_t items_per_part = (num_rows + nnz + num_parts - 1) / num_parts;
+          // the row index of every partition's carry-out, followed by the carry-out rows
+          size_t workspace_size = num_parts * (sizeof(dim_t) + num_cols * sizeof(DType));
+          mshadow::Tensor<cpu, 1, char> workspace =
+              ctx.requested[0].get_space_typed<cpu, 1, char>(mshadow::Shape1(workspace_size), s);
+          dim_t* carry_row = reinterpret_cast<dim_t*>(workspace.dptr_);
+          DType* carry_out = reinterpret_cast<DType*>(workspace.dptr_ + num_parts * sizeof(dim_t));
+          mxnet_op::Kernel<DotCsrDnsDnsMergePath, cpu>::Launch(s,
+                                                               num_parts,
+                                                               data_out.dptr<DType>(),
+                                                               carry_out,
+                                                               carry_row,
+                                                               data_l.dptr<DType>(),
+                                                               indptr_l.dptr<IType>(),
+                                                               col_idx_l.dptr<CType>(),
+                                                               data_r.dptr<DType>(),
+                                                               items_per_part,
+                                                               num_rows,
+                                                               num_cols);
+          for (dim_t i = 0; i < num_parts; ++i) {
+            if (carry_row[i] < num_rows) {
+              DotRowAxpy(data_out.dptr<DType>() + carry_row[i] * num_cols,
+                         carry_out + i * num_cols,
+                         DType(1),
+                         num_cols);
+            }
           }
         }
       });
@@ -25,6 +25,8 @@
  */
 
 #include "./indexing_op.h"
+#include <algorithm>
+#include <vector>
 namespace mxnet {
 namespace op {
 
@@ -415,6 +417,73 @@ void TakeOpForward<cpu>(const nnvm::NodeAttrs& attrs,
   });
 }
 
+/*!
+ * \brief Stable LSD radix sort of non-negative keys together with their values.
+ *        Each pass counts the digits of a contiguous chunk of the input per thread and
+ *        scatters every chunk to its own slots, so all passes run in parallel.
+ * \param keys the keys to sort, holding the sorted keys on return
+ * \param values the values to permute together with the keys
+ * \param keys_buf scratch space of the same size as keys
+ * \param values_buf scratch space of the same size as values
+ * \param size number of keys
+ * \param num_bits number of low bits which can differ between the keys
+ */
+template <typename KType, typename VType>
+void ParallelRadixSortByKey(KType* keys,
+                            VType* values,
+                            KType* keys_buf,
+                            VType* values_buf,
+                            const nnvm::dim_t size,
+                            const int num_bits) {
+  using nnvm::dim_t;
+  constexpr int kRadixBits    = 8;
+  constexpr dim_t kNumBuckets = 1 << kRadixBits;
+  const int num_threads       = static_cast<int>(std::max<dim_t>(
+      1,
+      std::min<dim_t>(engine::OpenMP::Get()->GetRecommendedOMPThreadCount(),
+                      size / kNumBuckets)));
+  const dim_t chunk           = (size + num_threads - 1) / num_threads;
+  KType* const keys_out       = keys;
+  VType* const values_out     = values;
+  std::vector<dim_t> offsets(num_threads * kNumBuckets);
+  for (int shift = 0; shift < num_bits; shift += kRadixBits) {
+#pragma omp parallel for num_threads(num_threads)
+    for (int t = 0; t < num_threads; ++t) {
+      dim_t* count = offsets.data() + t * kNumBuckets;
+      std::fill(count, count + kNumBuckets, 0);
+      const dim_t end = std::min(size, (t + 1) * chunk);
+      for (dim_t i = t * chunk; i < end; ++i) {
+        ++count[(keys[i] >> shift) & (kNumBuckets - 1)];
+      }
+    }
+    // exclusive scan in (bucket, thread) order, which keeps the sort stable
+    dim_t sum = 0;
+    for (dim_t b = 0; b < kNumBuckets; ++b) {
+      for (int t = 0; t < num_threads; ++t) {
+        const dim_t count             = offsets[t * kNumBuckets + b];
+        offsets[t * kNumBuckets + b] = sum;
+        sum += count;
+      }
+    }
+#pragma omp parallel for num_threads(num_threads)
+    for (int t = 0; t < num_threads; ++t) {
+      dim_t* offset   = offsets.data() + t * kNumBuckets;
+      const dim_t end = std::min(size, (t + 1) * chunk);
+      for (dim_t i = t * chunk; i < end; ++i) {
+        const dim_t pos = offset[(keys[i] >> shift) & (kNumBuckets - 1)]++;
+        keys_buf[pos]   = keys[i];
+        values_buf[pos] = values[i];
+      }
+    }
+    std::swap(keys, keys_buf);
+    std::swap(values, values_buf);
+  }
+  if (keys != keys_out) {
+    std::copy(keys, keys + size, keys_out);
+    std::copy(values, values + size, values_out);
+  }
+}
+
 template <>
 inline void SparseEmbeddingOpBackwardRspImpl<cpu>(const bool deterministic,
                                                   const OpContext& ctx,
@@ -432,17 +501,26 @@ inline void SparseEmbeddingOpBackwardRspImpl<cpu>(const bool deterministic,
   CHECK_EQ(req, kWriteTo) << "SparseEmbedding layer doesn't support "
                           << "weight gradient calculation with req != write";
 
-  // Request temporary storage for marking non-zero rows and prefix sum
-  Stream<cpu>* s        = ctx.get_stream<cpu>();
-  dim_t num_rows        = output.shape()[0];
-  dim_t row_length      = output.shape()[1];
-  size_t workspace_size = num_rows * sizeof(dim_t);
+  Stream<cpu>* s         = ctx.get_stream<cpu>();
+  const dim_t num_rows   = output.shape()[0];
+  const dim_t row_length = output.shape()[1];
+  const dim_t data_size  = static_cast<dim_t>(data.shape_.Size());
+  if (data_size == 0) {
+    FillZerosRspImpl(s, output);
+    return;
+  }
+  // Request temporary storage for the row ids sorted together with the positions of the
+  // lookups, the buffers of the radix sort and the offsets of the segments of equal row ids.
+  // Unlike a flag array over all rows, its size only depends on the number of lookups.
+  size_t workspace_size = (5 * data_size + 1) * sizeof(dim_t);
   Tensor<cpu, 1, char> workspace =
       ctx.requested[embedding::kTempSpace].get_space_typed<cpu, 1, char>(Shape1(workspace_size), s);
-  dim_t* row_flg = reinterpret_cast<dim_t*>(workspace.dptr_);
-  // prefix sum array re-uses the row_flg array temp space
-  dim_t* prefix_sum = row_flg;
-  dim_t data_size   = static_cast<dim_t>(data.shape_.Size());
+  dim_t* sorted_rows   = reinterpret_cast<dim_t*>(workspace.dptr_);
+  dim_t* sorted_pos    = sorted_rows + data_size;
+  dim_t* rows_buf      = sorted_pos + data_size;
+  dim_t* pos_buf       = rows_buf + data_size;
+  dim_t* segment_start = pos_buf + data_size;
+  const int omp_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
 
   MSHADOW_TYPE_SWITCH(data.type_flag_, IType, {
     MSHADOW_SGL_DBL_TYPE_SWITCH(ograd.type_flag_, DType, {
@@ -456,41 +534,43 @@ inline void SparseEmbeddingOpBackwardRspImpl<cpu>(const bool deterministic,
           bool is_valid   = CheckIndexOutOfBound(data_ptr, data.shape_.Size(), min, max);
           CHECK(is_valid) << "Embedding input contains data out of bound";
         }
-        // mark row flags
-        Fill<false>(s, TBlob(row_flg, Shape1(num_rows), cpu::kDevMask), kWriteTo, 0);
-        Kernel<MarkRowFlgKernel, cpu>::Launch(s, data_size, row_flg, data.dptr<IType>());
-        // calculate inclusive prefix sum
-        // TODO(haibin) ideally this is should be done in parallel
-        prefix_sum[0] = row_flg[0];
-        for (dim_t i = 1; i < num_rows; i++) {
-          prefix_sum[i] = prefix_sum[i - 1] + row_flg[i];
+        // sort the lookups by row id, remembering where each of them came from
+        const IType* data_ptr = data.dptr<IType>();
+#pragma omp parallel for num_threads(omp_threads)
+        for (dim_t i = 0; i < data_size; ++i) {
+          sorted_rows[i] = static_cast<dim_t>(data_ptr[i]);
+          sorted_pos[i]  = i;
         }
-        // total number of non-zero rows
-        dim_t nnr = prefix_sum[num_rows - 1];
-        if (nnr == 0) {
-          FillZerosRspImpl(s, output);
-          return;
+        ParallelRadixSortByKey(
+            sorted_rows, sorted_pos, rows_buf, pos_buf, data_size, common::ilog2ul(num_rows - 1));
+        // every segment of equal row ids is one row of the gradient
+        dim_t nnr = 0;
+        for (dim_t i = 0; i < data_size; ++i) {
+          if (i == 0 || sorted_rows[i] != sorted_rows[i - 1]) {
+            segment_start[nnr++] = i;
+          }
         }
+        segment_start[nnr] = data_size;
         output.CheckAndAlloc({Shape1(nnr)});
-        RType* grad_row_idx = output.aux_data(kIdx).dptr<RType>();
-        // fill row_idx array of output matrix, using the row_flg values
-        Kernel<FillRspRowIdxKernel, cpu>::Launch(s, num_rows, grad_row_idx, prefix_sum, num_rows);
-        // prefill with zeros
-        DType* grad_data = output.data().dptr<DType>();
-        Fill<false>(s, TBlob(grad_data, Shape1(nnr * row_length), cpu::kDevMask), kWriteTo, 0);
-        // add the final gradients
-        const int num_threads = engine::OpenMP::Get()->GetRecommendedOMPThreadCount();
-        dim_t segment_len     = (nnr + num_threads - 1) / num_threads;
-        Kernel<AddTakeGradRspKernel, cpu>::Launch(s,
-                                                  num_threads,
-                                                  grad_data,
-                                                  prefix_sum,
-                                                  ograd.dptr<DType>(),
-                                                  row_length,
-                                                  data.dptr<IType>(),
-                                                  data_size,
-                                                  segment_len,
-                                                  num_rows);
+        RType* grad_row_idx    = output.aux_data(kIdx).dptr<RType>();
+        DType* grad_data       = output.data().dptr<DType>();
+        const DType* ograd_ptr = ograd.dptr<DType>();
+        // Each row is reduced by exactly one thread in the order of the lookups, so neither
+        // zero-filling nor atomics are needed and the result does not depend on the threads.
+#pragma omp parallel for num_threads(omp_threads) schedule(dynamic, 64)
+        for (dim_t seg = 0; seg < nnr; ++seg) {
+          grad_row_idx[seg]  = static_cast<RType>(sorted_rows[segment_start[seg]]);
+          DType* grad_row    = grad_data + seg * row_length;
+          const DType* first = ograd_ptr + sorted_pos[segment_start[seg]] * row_length;
+          std::copy(first, first + row_length, grad_row);
+          for (dim_t k = segment_start[seg] + 1; k < segment_start[seg + 1]; ++k) {
+            const DType* src = ograd_ptr + sorted_pos[k] * row_length;
+#pragma omp simd
+            for (dim_t j = 0; j < row_length; ++j) {
+              grad_row[j] += src[j];
+            }
+          }
+        }
       });
     });
   });
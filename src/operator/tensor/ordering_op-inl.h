@@ -263,6 +263,154 @@ struct fill_ind {
   }
 };
 
+/*!
+ * \brief Order of the elements in the intra-row parallel top-k: by value, and by index
+ *        among equal values, so that the result does not depend on the number of threads.
+ */
+template <typename DType, typename IDXType>
+struct TopKBetter {
+  const DType* vals;
+  bool is_ascend;
+  bool operator()(const IDXType& i1, const IDXType& i2) const {
+    const DType v1 = vals[i1];
+    const DType v2 = vals[i2];
+    if (v1 != v2)
+      return is_ascend ? v1 < v2 : v1 > v2;
+    return i1 < i2;
+  }
+};
+
+/*!
+ * \brief Local top-k of vals[begin, end) into `heap`, whose top is the worst element kept.
+ *        Blocks of values that cannot beat the current k-th value are skipped by a vectorized
+ *        count, so after the heap is full most of the row is only streamed through once.
+ */
+template <typename DType, typename IDXType>
+inline void TopKSelectRange(const DType* vals,
+                            IDXType begin,
+                            IDXType end,
+                            IDXType K,
+                            bool is_ascend,
+                            std::vector<IDXType>* heap) {
+  const IDXType kBlock = 256;
+  TopKBetter<DType, IDXType> better{vals, is_ascend};
+  heap->clear();
+  IDXType j = begin;
+  for (; j < end && static_cast<IDXType>(heap->size()) < K; ++j) {
+    heap->push_back(j);
+    std::push_heap(heap->begin(), heap->end(), better);
+  }
+  for (; j < end; j += kBlock) {
+    const IDXType block_end = std::min(end, j + kBlock);
+    DType threshold         = vals[heap->front()];
+    int hits                = 0;
+    if (is_ascend) {
+#pragma omp simd reduction(+ : hits)
+      for (IDXType l = j; l < block_end; ++l) {
+        hits += vals[l] < threshold;
+      }
+    } else {
+#pragma omp simd reduction(+ : hits)
+      for (IDXType l = j; l < block_end; ++l) {
+        hits += vals[l] > threshold;
+      }
+    }
+    if (hits == 0)
+      continue;
+    // indices only grow within the scan, so a tie with the threshold never gets in
+    for (IDXType l = j; l < block_end; ++l) {
+      if (is_ascend ? vals[l] < threshold : vals[l] > threshold) {
+        std::pop_heap(heap->begin(), heap->end(), better);
+        heap->back() = l;
+        std::push_heap(heap->begin(), heap->end(), better);
+        threshold = vals[heap->front()];
+      }
+    }
+  }
+}
+
+/*!
+ * \brief Sort indices[0, n) with all the threads: every thread sorts one slice, and the sorted
+ *        slices are merged pairwise in parallel.
+ */
+template <typename IDXType, typename Compare>
+inline void TopKParallelSort(IDXType* indices, IDXType n, Compare comp, int nthreads) {
+  const int nslices = std::max(1, std::min<int>(nthreads, n / 1024));
+  std::vector<IDXType> bounds(nslices + 1);
+  for (int t = 0; t <= nslices; ++t) {
+    bounds[t] = static_cast<IDXType>(static_cast<int64_t>(n) * t / nslices);
+  }
+#pragma omp parallel for num_threads(nthreads)
+  for (int t = 0; t < nslices; ++t) {
+    std::sort(indices + bounds[t], indices + bounds[t + 1], comp);
+  }
+  for (int width = 1; width < nslices; width *= 2) {
+#pragma omp parallel for num_threads(nthreads)
+    for (int t = 0; t < nslices - width; t += 2 * width) {
+      std::inplace_merge(indices + bounds[t],
+                         indices + bounds[t + width],
+                         indices + bounds[std::min(t + 2 * width, nslices)],
+                         comp);
+    }
+  }
+}
+
+/*!
+ * \brief Top-k of one long row with all the threads, used when there are fewer rows than
+ *        threads. Small k: every thread keeps the top-k of its slice of the row in a heap,
+ *        and the candidates of all the threads are merged. Large k: nth_element selects the
+ *        top-k, which are then sorted in parallel. Full sort: parallel merge sort.
+ */
+template <typename DType, typename IDXType>
+inline void TopKSortRowParallel(const DType* vals,
+                                DType* sorted_vals,
+                                IDXType* indices,
+                                IDXType row_begin,
+                                IDXType K,
+                                IDXType N,
+                                bool is_ascend,
+                                int nthreads) {
+  TopKBetter<DType, IDXType> better{vals, is_ascend};
+  if (K == 0)
+    return;
+  if (static_cast<int64_t>(K) * 16 * nthreads <= N) {
+    std::vector<std::vector<IDXType>> heaps(nthreads);
+#pragma omp parallel for num_threads(nthreads)
+    for (int t = 0; t < nthreads; ++t) {
+      const IDXType begin =
+          row_begin + static_cast<IDXType>(static_cast<int64_t>(N) * t / nthreads);
+      const IDXType end =
+          row_begin + static_cast<IDXType>(static_cast<int64_t>(N) * (t + 1) / nthreads);
+      heaps[t].reserve(K);
+      TopKSelectRange(vals, begin, end, K, is_ascend, &heaps[t]);
+    }
+    std::vector<IDXType> candidates;
+    candidates.reserve(static_cast<size_t>(K) * nthreads);
+    for (const auto& heap : heaps) {
+      candidates.insert(candidates.end(), heap.begin(), heap.end());
+    }
+    std::partial_sort(candidates.begin(), candidates.begin() + K, candidates.end(), better);
+    std::copy(candidates.begin(), candidates.begin() + K, indices);
+  } else if (K * 8 <= N) {
+#pragma omp parallel for num_threads(nthreads)
+    for (IDXType j = 0; j < N; ++j) {
+      indices[j] = row_begin + j;
+    }
+    std::nth_element(indices, indices + K, indices + N, better);
+    TopKParallelSort(indices, K, better, nthreads);
+  } else {
+#pragma omp parallel for num_threads(nthreads)
+    for (IDXType j = 0; j < N; ++j) {
+      indices[j] = row_begin + j;
+    }
+    TopKParallelSort(indices, N, better, nthreads);
+  }
+#pragma omp parallel for num_threads(nthreads) if (K > 65536)
+  for (IDXType j = 0; j < K; ++j) {
+    sorted_vals[j] = vals[indices[j]];
+  }
+}
+
 template <typename DType, typename IDXType>
 MSHADOW_FORCE_INLINE void TopKSort(const Tensor<cpu, 1, DType>& dat,
                                    const Tensor<cpu, 1, IDXType>& ind,
@@ -276,6 +424,21 @@ MSHADOW_FORCE_INLINE void TopKSort(const Tensor<cpu, 1, DType>& dat,
   // Batch size.
   const size_t M(work.size(0) / (sizeof(DType) * N));
   const int omp_threads(engine::OpenMP::Get()->GetRecommendedOMPThreadCount());
+  // A few long rows: parallelize inside the rows instead of across them.
+  if (static_cast<int>(M) < omp_threads && N >= 32768) {
+    const DType* vals = reinterpret_cast<DType*>(work.dptr_);
+    for (size_t i = 0; i < M; ++i) {
+      TopKSortRowParallel(vals,
+                          dat.dptr_ + i * N,
+                          ind.dptr_ + i * N,
+                          static_cast<IDXType>(i * N),
+                          K,
+                          N,
+                          is_ascend,
+                          omp_threads);
+    }
+    return;
+  }
 #pragma omp parallel for num_threads(omp_threads)
   for (index_t i = 0; i < static_cast<index_t>(M); ++i) {
     // Tensor `work` stores the flattened source data, while `dat` stores the sorted result.
@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file vector_math-inl.h
+ * \brief Branch-free approximations of math functions that the compiler can vectorize
+ *        when they are called in a loop over contiguous CPU data
+ */
+#ifndef MXNET_OPERATOR_VECTOR_MATH_INL_H_
+#define MXNET_OPERATOR_VECTOR_MATH_INL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace mxnet {
+namespace op {
+namespace vector_math {
+
+/*! \brief float with the bits of i */
+inline float bits_to_float(uint32_t i) {
+  float f;
+  std::memcpy(&f, &i, sizeof(f));
+  return f;
+}
+
+/*! \brief bits of the float f */
+inline uint32_t float_to_bits(float f) {
+  uint32_t i;
+  std::memcpy(&i, &f, sizeof(i));
+  return i;
+}
+
+/*!
+ * \brief exp(x) within 1 ulp for normal results, exact 0 below -103.97 and +inf above 88.72.
+ *        Cephes range reduction x = n ln2 + r with a degree 6 polynomial for exp(r); 2^n is
+ *        applied in two halves so that denormal results are kept.
+ *        Out of range inputs are handled by masking the bits of the result: a floating point
+ *        comparison or a select on the polynomial keeps the compiler from vectorizing it.
+ */
+inline float exp(float x) {
+  const float kLog2e = 1.44269504088896341f;
+  const float kLn2Hi = 0.693359375f;
+  const float kLn2Lo = -2.12194440e-4f;
+  // adding 1.5 * 2^23 rounds to the nearest integer, which lands in the low mantissa bits
+  const float kRound = 12582912.0f;
+  // bits of 88.72283935546875f, 103.97208404541015625f and inf
+  const uint32_t kHiBits  = 0x42b17218;
+  const uint32_t kLoBits  = 0x42cff1b5;
+  const uint32_t kInfBits = 0x7f800000;
+
+  const uint32_t bits      = float_to_bits(x);
+  const uint32_t abs_bits  = bits & 0x7fffffff;
+  const uint32_t negative  = bits >> 31;
+  const uint32_t is_nan    = 0u - static_cast<uint32_t>(abs_bits > kInfBits);
+  const uint32_t underflow = 0u - (negative & static_cast<uint32_t>(abs_bits > kLoBits));
+  const uint32_t overflow  = 0u - ((negative ^ 1u) & static_cast<uint32_t>(abs_bits > kHiBits));
+  const uint32_t special   = underflow | overflow | is_nan;
+  // the special lanes compute exp(0), rather than going through denormals or infinities
+  x = bits_to_float(bits & ~special);
+
+  const float t    = x * kLog2e + kRound;
+  const int32_t n  = static_cast<int32_t>(float_to_bits(t) - float_to_bits(kRound));
+  const int32_t n1 = n >> 1;
+  const float nf   = t - kRound;
+  const float r    = (x - nf * kLn2Hi) - nf * kLn2Lo;
+  float p          = 1.9875691500e-4f;
+  p                = p * r + 1.3981999507e-3f;
+  p                = p * r + 8.3334519073e-3f;
+  p                = p * r + 4.1665795894e-2f;
+  p                = p * r + 1.6666665459e-1f;
+  p                = p * r + 5.0000001201e-1f;
+  p                = p * r * r + r + 1.0f;
+  const float y    = p * bits_to_float(static_cast<uint32_t>(n1 + 127) << 23) *
+                  bits_to_float(static_cast<uint32_t>(n - n1 + 127) << 23);
+
+  // +0 on underflow, +inf on overflow, NaN passed through
+  const uint32_t y_bits = float_to_bits(y) & ~special;
+  return bits_to_float(y_bits | (kInfBits & overflow) | (bits & is_nan));
+}
+
+/*! \brief exp(x) of libm: double precision callers need the full accuracy */
+inline double exp(double x) {
+  return std::exp(x);
+}
+
+/*!
+ * \brief log(x) within 1 ulp. Cephes reduction x = m 2^e with m in [sqrt(1/2), sqrt(2)) and
+ *        a degree 8 polynomial for log(m); denormals are scaled by 2^23 first.
+ *        -inf for zeros, NaN for negative numbers and NaN, +inf for +inf.
+ */
+inline float log(float x) {
+  const uint32_t kSqrt2Bits = 0x3fb504f3;
+  const uint32_t kOneBits   = 0x3f800000;
+  const uint32_t kInfBits   = 0x7f800000;
+
+  const uint32_t bits     = float_to_bits(x);
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  const uint32_t is_zero  = 0u - static_cast<uint32_t>(abs_bits == 0);
+  const uint32_t is_nan   = 0u - static_cast<uint32_t>((bits >> 31) > 0 || abs_bits > kInfBits);
+  const uint32_t is_inf   = 0u - static_cast<uint32_t>(bits == kInfBits);
+  const uint32_t denormal = 0u - static_cast<uint32_t>(bits < 0x00800000);
+
+  const uint32_t b = (float_to_bits(x * 8388608.0f) & denormal) | (bits & ~denormal);
+  int32_t e = static_cast<int32_t>(b >> 23) - 127 - static_cast<int32_t>(denormal & 23);
+  // mantissa in [1, 2), halved above sqrt(2)
+  uint32_t m_bits      = (b & 0x007fffff) | kOneBits;
+  const uint32_t above = 0u - static_cast<uint32_t>(m_bits > kSqrt2Bits);
+  m_bits -= above & 0x00800000;
+  e += static_cast<int32_t>(above & 1);
+
+  const float f  = bits_to_float(m_bits) - 1.0f;
+  const float z  = f * f;
+  const float fe = static_cast<float>(e);
+  float y        = 7.0376836292e-2f;
+  y              = y * f - 1.1514610310e-1f;
+  y              = y * f + 1.1676998740e-1f;
+  y              = y * f - 1.2420140846e-1f;
+  y              = y * f + 1.4249322787e-1f;
+  y              = y * f - 1.6668057665e-1f;
+  y              = y * f + 2.0000714765e-1f;
+  y              = y * f - 2.4999993993e-1f;
+  y              = y * f + 3.3333331174e-1f;
+  y              = y * f * z - 2.12194440e-4f * fe - 0.5f * z;
+  const float r  = f + y + 0.693359375f * fe;
+
+  const uint32_t special = is_zero | is_nan | is_inf;
+  return bits_to_float((float_to_bits(r) & ~special) | (0xff800000u & is_zero) |
+                       (0x7fc00000u & is_nan & ~is_zero) | (kInfBits & is_inf));
+}
+
+/*! \brief log(x) of libm */
+inline double log(double x) {
+  return std::log(x);
+}
+
+/*!
+ * \brief tanh(x) within 2 ulp: odd polynomial of Cephes below 0.625 in magnitude,
+ *        1 - 2 / (exp(2|x|) + 1) with the sign of x above
+ */
+inline float tanh(float x) {
+  const uint32_t bits     = float_to_bits(x);
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  const uint32_t sign     = bits & 0x80000000;
+  // bits of 0.625f
+  const uint32_t small = 0u - static_cast<uint32_t>(abs_bits < 0x3f200000);
+
+  const float z = x * x;
+  float p       = -5.70498872745e-3f;
+  p             = p * z + 2.06390887954e-2f;
+  p             = p * z - 5.37397155531e-2f;
+  p             = p * z + 1.33314422036e-1f;
+  p             = p * z - 3.33332819422e-1f;
+  p             = p * z * x + x;
+
+  const float a = bits_to_float(abs_bits);
+  const float q = 1.0f - 2.0f / (exp(a + a) + 1.0f);
+  return bits_to_float((float_to_bits(p) & small) | ((float_to_bits(q) | sign) & ~small));
+}
+
+/*! \brief tanh(x) of libm */
+inline double tanh(double x) {
+  return std::tanh(x);
+}
+
+/*! \brief 1 / (1 + exp(-x)) */
+inline float sigmoid(float x) {
+  return 1.0f / (1.0f + exp(-x));
+}
+
+/*! \brief 1 / (1 + exp(-x)) in double precision */
+inline double sigmoid(double x) {
+  return 1.0 / (1.0 + std::exp(-x));
+}
+
+/*! \brief u T(u^2), erf(u) within 2 ulp for |u| below 1 (Cephes) */
+inline float erf_small(float u) {
+  const float z = u * u;
+  float p       = 7.853861353153693e-5f;
+  p             = p * z - 8.010193625184903e-4f;
+  p             = p * z + 5.188327685732524e-3f;
+  p             = p * z - 2.685381193529856e-2f;
+  p             = p * z + 1.128358514861418e-1f;
+  p             = p * z - 3.761262582423300e-1f;
+  p             = p * z + 1.128379165726710e+0f;
+  return u * p;
+}
+
+/*!
+ * \brief P(t) of erfc(a) = t exp(P(t) - a^2) with t = 1 / (1 + a / 2) for a >= 0, Chebyshev
+ *        fit of Numerical Recipes within a relative error of 1.2e-7 in exact arithmetic
+ */
+inline float erfc_poly(float t) {
+  float p = 0.17087277f;
+  p       = p * t - 0.82215223f;
+  p       = p * t + 1.48851587f;
+  p       = p * t - 1.13520398f;
+  p       = p * t + 0.27886807f;
+  p       = p * t - 0.18628806f;
+  p       = p * t + 0.09678418f;
+  p       = p * t + 0.37409196f;
+  p       = p * t + 1.00002368f;
+  return p * t - 1.26551223f;
+}
+
+/*!
+ * \brief erfc(a) for a >= 0 within a relative error of 5e-7, in the tail too: a^2 is split
+ *        in exact and rounded parts, which costs a second exponential
+ */
+inline float erfc_positive(float a) {
+  // erfc is 0 in single precision beyond 10.5
+  a              = bits_to_float(std::min(float_to_bits(a), 0x41280000u));
+  const float t  = 1.0f / (1.0f + 0.5f * a);
+  const float p  = erfc_poly(t);
+  const float hi = bits_to_float(float_to_bits(a) & 0xfffff000);
+  const float lo = a - hi;
+  return t * exp(-hi * hi) * exp(p - lo * (hi + a));
+}
+
+/*!
+ * \brief erf(x) within 2 ulp: the polynomial of Cephes below 1 in magnitude,
+ *        1 - erfc(|x|) with the sign of x above, NaN passed through. The rounding of |x|^2
+ *        does not matter to 1 - erfc(|x|), so a single exponential is enough.
+ */
+inline float erf(float x) {
+  const uint32_t bits     = float_to_bits(x);
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  const uint32_t small    = 0u - static_cast<uint32_t>(abs_bits < 0x3f800000);
+  const uint32_t is_nan   = 0u - static_cast<uint32_t>(abs_bits > 0x7f800000);
+  // erf is +-1 in single precision beyond 4
+  const float a         = bits_to_float(std::min(abs_bits, 0x40800000u));
+  const float t         = 1.0f / (1.0f + 0.5f * a);
+  const float large     = 1.0f - t * exp(erfc_poly(t) - a * a);
+  const uint32_t r_bits = (float_to_bits(erf_small(x)) & small) |
+                          ((float_to_bits(large) | (bits & 0x80000000)) & ~small);
+  return bits_to_float((r_bits & ~is_nan) | (bits & is_nan));
+}
+
+/*! \brief erf(x) of libm */
+inline double erf(double x) {
+  return std::erf(x);
+}
+
+/*!
+ * \brief x Phi(x) = x (1 + erf(x / sqrt(2))) / 2, with 1 + erf(u) = erfc(-u) below -0.5 so
+ *        that the result keeps its relative accuracy in the tail. NaN for NaN and -inf.
+ */
+inline float gelu(float x) {
+  const float u           = x * 0.70710678118654752f;
+  const uint32_t bits     = float_to_bits(u);
+  const uint32_t abs_bits = bits & 0x7fffffff;
+  const uint32_t negative = 0u - (bits >> 31);
+  // u in (-0.5, 1), where 1 + erf(u) does not cancel much
+  const uint32_t small = (negative & (0u - static_cast<uint32_t>(abs_bits < 0x3f000000))) |
+                         (~negative & (0u - static_cast<uint32_t>(abs_bits < 0x3f800000)));
+  // erfc(u) only matters below 4 on the positive side, which keeps it out of denormals there
+  const uint32_t a_bits = (abs_bits & negative) | (std::min(abs_bits, 0x40800000u) & ~negative);
+  const float tail      = erfc_positive(bits_to_float(a_bits));
+  // 1 + erf(u): erfc(|u|) below -0.5, 2 - erfc(u) above 1
+  const uint32_t large =
+      (float_to_bits(tail) & negative) | (float_to_bits(2.0f - tail) & ~negative);
+  const uint32_t one_plus_erf = (float_to_bits(1.0f + erf_small(u)) & small) | (large & ~small);
+  return 0.5f * x * bits_to_float(one_plus_erf);
+}
+
+/*! \brief x Phi(x) in double precision */
+inline double gelu(double x) {
+  return 0.5 * x * (1.0 + std::erf(x * 0.70710678118654752));
+}
+
+}  // namespace vector_math
+}  // namespace op
+}  // namespace mxnet
+
+#endif  // MXNET_OPERATOR_VECTOR_MATH_INL_H_
@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file thread_team_test.cc
+ * \brief Tests the parallel loops of engine::ThreadTeam
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../../src/engine/thread_team.h"
+
+using mxnet::engine::ThreadTeam;
+
+TEST(ThreadTeam, ParallelForCoversRange) {
+  ThreadTeam* team = ThreadTeam::Get();
+  for (size_t n : {1, 3, 64, 1000, 4097}) {
+    for (int nthreads : {1, 2, 3, 8}) {
+      std::vector<int> hits(n, 0);
+      team->ParallelFor(n, nthreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          ++hits[i];
+        }
+      });
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(hits[i], 1) << "n=" << n << " nthreads=" << nthreads << " i=" << i;
+      }
+      std::fill(hits.begin(), hits.end(), 0);
+      team->ParallelForDynamic(n, nthreads, 7, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          ++hits[i];
+        }
+      });
+      for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(hits[i], 1) << "n=" << n << " nthreads=" << nthreads << " i=" << i;
+      }
+    }
+  }
+}
+
+TEST(ThreadTeam, NestedRegionRunsSerially) {
+  ThreadTeam* team = ThreadTeam::Get();
+  EXPECT_FALSE(ThreadTeam::InParallel());
+  std::atomic<int> inner_threads(0);
+  team->Run(4, [&](int, int) {
+    EXPECT_TRUE(ThreadTeam::InParallel());
+    team->Run(4, [&](int tid, int nthreads) {
+      EXPECT_EQ(tid, 0);
+      EXPECT_EQ(nthreads, 1);
+      ++inner_threads;
+    });
+  });
+  EXPECT_FALSE(ThreadTeam::InParallel());
+  EXPECT_GE(inner_threads.load(), 1);
+  EXPECT_LE(inner_threads.load(), 4);
+}
+
+TEST(ThreadTeam, ConcurrentCallers) {
+  ThreadTeam* team = ThreadTeam::Get();
+  const size_t n = 10000;
+  std::vector<std::thread> callers;
+  std::atomic<int> errors(0);
+  for (int c = 0; c < 4; ++c) {
+    callers.emplace_back([&]() {
+      for (int iter = 0; iter < 200; ++iter) {
+        std::vector<int> hits(n, 0);
+        team->ParallelFor(n, 4, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            ++hits[i];
+          }
+        });
+        for (size_t i = 0; i < n; ++i) {
+          if (hits[i] != 1) {
+            ++errors;
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(errors.load(), 0);
+}
+
+TEST(ThreadTeam, ThreadLimit) {
+  std::thread([]() {
+    ThreadTeam::SetThreadLimit(1);
+    int threads = 0;
+    ThreadTeam::Get()->Run(4, [&](int, int nthreads) { threads = nthreads; });
+    EXPECT_EQ(threads, 1);
+  }).join();
+}
@@ -36,6 +36,9 @@
 #include <chrono>
 #include <vector>
 #include <random>
+#include <memory>
+#include <mutex>
+#include <set>
 
 #include "../src/engine/engine_impl.h"
 #include "../include/test_util.h"
@@ -494,6 +497,102 @@ TEST(Engine, VarVersion) {
   }
 }
 
+/*!
+ * \brief pushes num_ops operators on lane from a new thread, each writing its own variable
+ *        and sleeping for sleep_us, and returns the ids of the threads that ran them
+ */
+static std::set<std::thread::id> PushOnLane(mxnet::Engine* engine, int lane, int num_ops,
+                                            int sleep_us) {
+  std::mutex mutex;
+  std::set<std::thread::id> workers;
+  std::vector<mxnet::Engine::VarHandle> vars;
+  std::thread pusher([&]() {
+    EXPECT_EQ(engine->set_execution_lane(lane), 0);
+    for (int i = 0; i < num_ops; ++i) {
+      vars.push_back(engine->NewVariable());
+      engine->PushSync(
+          [&, sleep_us](mxnet::RunContext) {
+            std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+            std::lock_guard<std::mutex> lock(mutex);
+            workers.insert(std::this_thread::get_id());
+          },
+          mxnet::Context::CPU(), {}, {vars.back()});
+    }
+  });
+  pusher.join();
+  engine->WaitForAll();
+  for (auto var : vars) {
+    engine->DeleteVariable([](mxnet::RunContext) {}, mxnet::Context::CPU(), var);
+  }
+  engine->WaitForAll();
+  return workers;
+}
+
+TEST(Engine, ExecutionLanes) {
+  std::unique_ptr<mxnet::Engine> engine(mxnet::engine::CreateThreadedEnginePerDevice());
+  const int lane = engine->CreateExecutionLane("latency", 2);
+  EXPECT_GT(lane, 0);
+  EXPECT_EQ(engine->CreateExecutionLane("latency", 4), lane);
+  EXPECT_EQ(engine->GetExecutionLane("latency"), lane);
+  EXPECT_EQ(engine->GetExecutionLane(""), 0);
+  EXPECT_EQ(engine->GetExecutionLane("unknown"), -1);
+
+  const std::set<std::thread::id> shared   = PushOnLane(engine.get(), 0, 50, 100);
+  const std::set<std::thread::id> isolated = PushOnLane(engine.get(), lane, 50, 100);
+  EXPECT_LE(isolated.size(), 2U);
+  for (const auto& id : isolated) {
+    EXPECT_EQ(shared.count(id), 0) << "an operator of the lane ran on a shared worker";
+  }
+
+  // the lanes survive a restart of the engine, and get new workers
+  engine->Stop();
+  engine->Start();
+  EXPECT_EQ(engine->GetExecutionLane("latency"), lane);
+  EXPECT_LE(PushOnLane(engine.get(), lane, 10, 100).size(), 2U);
+}
+
+/*!
+ * \brief Latency of a short operator pushed while the shared workers are busy with a backlog,
+ *        on the shared workers and on its own lane
+ */
+TEST(Engine, ExecutionLaneLatency) {
+  std::unique_ptr<mxnet::Engine> engine(mxnet::engine::CreateThreadedEnginePerDevice());
+  const int lane       = engine->CreateExecutionLane("latency", 1);
+  const int backlog    = test::performance_run ? 200 : 20;
+  const auto sleep     = std::chrono::microseconds(5000);
+  std::vector<mxnet::Engine::VarHandle> vars;
+  for (int i = 0; i < backlog; ++i) {
+    vars.push_back(engine->NewVariable());
+  }
+  for (int short_lane : {0, lane}) {
+    for (auto var : vars) {
+      engine->PushSync(
+          [sleep](mxnet::RunContext) { std::this_thread::sleep_for(sleep); },
+          mxnet::Context::CPU(), {}, {var});
+    }
+    const int prev   = engine->set_execution_lane(short_lane);
+    auto var         = engine->NewVariable();
+    const auto start = std::chrono::steady_clock::now();
+    engine->PushSync([](mxnet::RunContext) {}, mxnet::Context::CPU(), {}, {var});
+    engine->WaitForVar(var);
+    const std::chrono::duration<double, std::milli> latency =
+        std::chrono::steady_clock::now() - start;
+    engine->set_execution_lane(prev);
+    engine->WaitForAll();
+    const double backlog_ms = backlog * sleep.count() / 1000.0;
+    LOG(INFO) << "short operator on lane " << short_lane << " behind a backlog of "
+              << backlog_ms << " ms: " << latency.count() << " ms";
+    if (short_lane == lane) {
+      EXPECT_LT(latency.count(), backlog_ms / 2);
+    }
+    engine->DeleteVariable([](mxnet::RunContext) {}, mxnet::Context::CPU(), var);
+  }
+  for (auto var : vars) {
+    engine->DeleteVariable([](mxnet::RunContext) {}, mxnet::Context::CPU(), var);
+  }
+  engine->WaitForAll();
+}
+
 #ifdef _OPENMP
 
 struct TestSaveAndRestoreOMPState {
@@ -0,0 +1,235 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file batching_cached_op_test.cc
+ * \brief Dynamic batching of concurrent requests through the C API, and its latency and
+ *        throughput under a Poisson load
+ */
+#include <gtest/gtest.h>
+#include <mxnet/c_api.h>
+#include <mxnet/ndarray.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/test_util.h"
+#include "../include/test_cached_op.h"
+
+using namespace mxnet;
+
+namespace {
+
+const int kInputDim = 64;
+const int kHidden   = 256;
+const int kDepth    = 4;
+
+/*! \brief The MLP behind a BatchingCachedOp */
+class BatchedMLP {
+ public:
+  BatchedMLP(int max_batch_size, int max_delay_us)
+      : params_(test::MLPParams(kDepth, kInputDim, kHidden)) {
+    SymbolHandle sym                = test::MLPSymbol(kDepth, kHidden);
+    const std::string param_indices = test::MLPParamIndices(kDepth);
+    std::vector<const char*> op_keys{"data_indices", "param_indices", "static_alloc"};
+    std::vector<const char*> op_vals{"[0]", param_indices.c_str(), "true"};
+    CHECK_EQ(MXCreateCachedOp(sym, op_keys.size(), op_keys.data(), op_vals.data(), &op_, false),
+             0)
+        << MXGetLastError();
+    MXSymbolFree(sym);
+    std::vector<NDArrayHandle> params;
+    for (NDArray& param : params_) {
+      params.push_back(&param);
+    }
+    const std::string max_batch_str = std::to_string(max_batch_size);
+    const std::string max_delay_str = std::to_string(max_delay_us);
+    std::vector<const char*> keys{"max_batch_size", "max_delay_us"};
+    std::vector<const char*> vals{max_batch_str.c_str(), max_delay_str.c_str()};
+    CHECK_EQ(MXCreateBatchingCachedOp(op_,
+                                      params.size(),
+                                      params.data(),
+                                      Context::kCPU,
+                                      0,
+                                      keys.size(),
+                                      keys.data(),
+                                      vals.data(),
+                                      &handle_),
+             0)
+        << MXGetLastError();
+  }
+
+  ~BatchedMLP() {
+    MXFreeBatchingCachedOp(handle_);
+    MXFreeCachedOp(op_);
+  }
+
+  BatchRequestHandle Submit(const NDArray& data) {
+    NDArrayHandle input = const_cast<NDArray*>(&data);
+    BatchRequestHandle request;
+    CHECK_EQ(MXBatchingCachedOpSubmit(handle_, 1, &input, &request), 0) << MXGetLastError();
+    return request;
+  }
+
+  /*! \brief waits for the output of the request, copied, and frees the request */
+  static std::vector<float> Wait(BatchRequestHandle request) {
+    int num_outputs        = 0;
+    NDArrayHandle* outputs = nullptr;
+    CHECK_EQ(MXBatchRequestWait(request, &num_outputs, &outputs), 0) << MXGetLastError();
+    CHECK_EQ(num_outputs, 1);
+    NDArray* out = static_cast<NDArray*>(outputs[0]);
+    out->WaitToRead();
+    const float* begin = out->data().dptr<float>();
+    std::vector<float> ret(begin, begin + out->shape().Size());
+    MXNDArrayFree(out);
+    MXFreeBatchRequest(request);
+    return ret;
+  }
+
+  /*! \brief the output of the model for data, run on its own */
+  std::vector<float> Unbatched(const NDArray& data) {
+    std::vector<NDArrayHandle> inputs{const_cast<NDArray*>(&data)};
+    for (NDArray& param : params_) {
+      inputs.push_back(&param);
+    }
+    int num_outputs        = 0;
+    NDArrayHandle* outputs = nullptr;
+    CHECK_EQ(MXInvokeCachedOp(op_,
+                              inputs.size(),
+                              inputs.data(),
+                              Context::kCPU,
+                              0,
+                              &num_outputs,
+                              &outputs,
+                              nullptr),
+             0)
+        << MXGetLastError();
+    NDArray* out = static_cast<NDArray*>(outputs[0]);
+    out->WaitToRead();
+    const float* begin = out->data().dptr<float>();
+    std::vector<float> ret(begin, begin + out->shape().Size());
+    MXNDArrayFree(out);
+    return ret;
+  }
+
+ private:
+  std::vector<NDArray> params_;
+  CachedOpHandle op_;
+  BatchingCachedOpHandle handle_;
+};
+
+}  // namespace
+
+TEST(BatchingCachedOp, MatchesUnbatched) {
+  const int num_threads = 8;
+  const int repeats     = 10;
+  std::vector<NDArray> data;
+  for (int t = 0; t < num_threads; ++t) {
+    // requests of 1 to 3 samples
+    data.push_back(test::FilledArray(mxnet::TShape({t % 3 + 1, kInputDim}), 10.0f * t));
+  }
+  BatchedMLP model(8, 2000);
+  std::vector<std::vector<float>> expected;
+  for (int t = 0; t < num_threads; ++t) {
+    expected.push_back(model.Unbatched(data[t]));
+  }
+  std::vector<int> mismatches(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int r = 0; r < repeats; ++r) {
+        const std::vector<float> out = BatchedMLP::Wait(model.Submit(data[t]));
+        if (out.size() != expected[t].size()) {
+          ++mismatches[t];
+          continue;
+        }
+        for (size_t i = 0; i < out.size(); ++i) {
+          if (std::fabs(out[i] - expected[t][i]) > 1e-5f * (1.0f + std::fabs(expected[t][i]))) {
+            ++mismatches[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < num_threads; ++t) {
+    EXPECT_EQ(mismatches[t], 0) << "thread " << t;
+  }
+}
+
+/*!
+ * \brief Single sample requests arriving as a Poisson process, run one at a time and in
+ *        batches: achieved throughput and latency percentiles
+ */
+TEST(BatchingCachedOp, PoissonLoadCPU) {
+  const int num_requests = test::performance_run ? 5000 : 200;
+  std::vector<double> rates{1000, 4000};
+  if (test::performance_run) {
+    rates.push_back(16000);
+  }
+  const NDArray data = test::FilledArray(mxnet::TShape({1, kInputDim}), 0.0f);
+  for (double rate : rates) {
+    for (int max_batch_size : {1, 32}) {
+      BatchedMLP model(max_batch_size, 500);
+      BatchedMLP::Wait(model.Submit(data));
+
+      using clock = std::chrono::steady_clock;
+      std::vector<BatchRequestHandle> requests(num_requests);
+      std::vector<clock::time_point> submitted(num_requests);
+      std::vector<double> latency_ms(num_requests);
+      std::atomic<int> num_submitted(0);
+      // waits on the requests in the order they were submitted
+      std::thread collector([&]() {
+        for (int i = 0; i < num_requests; ++i) {
+          while (num_submitted.load(std::memory_order_acquire) <= i) {
+            std::this_thread::yield();
+          }
+          BatchedMLP::Wait(requests[i]);
+          const std::chrono::duration<double, std::milli> latency = clock::now() - submitted[i];
+          latency_ms[i]                                           = latency.count();
+        }
+      });
+      std::mt19937 generator(42);
+      std::exponential_distribution<double> interval(rate);
+      const auto start = clock::now();
+      auto arrival     = start;
+      for (int i = 0; i < num_requests; ++i) {
+        arrival += std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(interval(generator)));
+        std::this_thread::sleep_until(arrival);
+        submitted[i] = clock::now();
+        requests[i]  = model.Submit(data);
+        num_submitted.store(i + 1, std::memory_order_release);
+      }
+      collector.join();
+      const std::chrono::duration<double> elapsed = clock::now() - start;
+      std::sort(latency_ms.begin(), latency_ms.end());
+      std::cout << "rate " << rate << "/s max_batch_size " << max_batch_size << ": "
+                << num_requests / elapsed.count() << " requests/s, latency p50 "
+                << latency_ms[num_requests / 2] << " ms p99 "
+                << latency_ms[num_requests * 99 / 100] << " ms" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file cached_op_threadsafe_test.cc
+ * \brief Concurrent forward of the thread-safe CachedOp, and its throughput against the number
+ *        of calling threads
+ */
+#include <gtest/gtest.h>
+#include <mxnet/c_api.h>
+#include <mxnet/ndarray.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/test_util.h"
+#include "../include/test_cached_op.h"
+
+using namespace mxnet;
+
+namespace {
+
+const int kInputDim = 64;
+const int kHidden   = 256;
+const int kDepth    = 4;
+const int kBatch    = 4;
+
+/*! \brief A thread-safe CachedOp of the MLP with its parameters */
+class ThreadSafeMLP {
+ public:
+  explicit ThreadSafeMLP(bool static_alloc, int num_states = 0) {
+    SymbolHandle sym                = test::MLPSymbol(kDepth, kHidden);
+    const std::string param_indices = test::MLPParamIndices(kDepth);
+    const std::string static_str    = static_alloc ? "true" : "false";
+    const std::string states_str    = std::to_string(num_states);
+    std::vector<const char*> keys{
+        "data_indices", "param_indices", "static_alloc", "static_shape", "num_states"};
+    std::vector<const char*> vals{
+        "[0]", param_indices.c_str(), static_str.c_str(), static_str.c_str(), states_str.c_str()};
+    CHECK_EQ(MXCreateCachedOp(sym, keys.size(), keys.data(), vals.data(), &handle_, true), 0)
+        << MXGetLastError();
+    MXSymbolFree(sym);
+    params_ = test::MLPParams(kDepth, kInputDim, kHidden);
+  }
+
+  ~ThreadSafeMLP() {
+    MXFreeCachedOp(handle_);
+  }
+
+  /*! \brief the output of the model for data, copied once computed */
+  std::vector<float> Forward(const NDArray& data) const {
+    std::vector<NDArrayHandle> inputs{const_cast<NDArray*>(&data)};
+    for (const NDArray& param : params_) {
+      inputs.push_back(const_cast<NDArray*>(&param));
+    }
+    int num_outputs        = 0;
+    NDArrayHandle* outputs = nullptr;
+    const int* stypes;
+    CHECK_EQ(MXInvokeCachedOp(handle_,
+                              inputs.size(),
+                              inputs.data(),
+                              Context::kCPU,
+                              0,
+                              &num_outputs,
+                              &outputs,
+                              &stypes),
+             0)
+        << MXGetLastError();
+    CHECK_EQ(num_outputs, 1);
+    NDArray* out = static_cast<NDArray*>(outputs[0]);
+    out->WaitToRead();
+    const float* begin = out->data().dptr<float>();
+    std::vector<float> ret(begin, begin + out->shape().Size());
+    MXNDArrayFree(out);
+    return ret;
+  }
+
+ private:
+  CachedOpHandle handle_;
+  std::vector<NDArray> params_;
+};
+
+}  // namespace
+
+TEST(CachedOpThreadSafe, ConcurrentForward) {
+  const int num_threads = 8;
+  const int repeats     = 20;
+  std::vector<NDArray> data;
+  for (int t = 0; t < num_threads; ++t) {
+    data.push_back(test::FilledArray(mxnet::TShape({kBatch, kInputDim}), 10.0f * t));
+  }
+  for (bool static_alloc : {false, true}) {
+    // fewer states than threads, so that callers also wait for a free state
+    ThreadSafeMLP model(static_alloc, 3);
+    std::vector<std::vector<float>> expected;
+    for (int t = 0; t < num_threads; ++t) {
+      expected.push_back(model.Forward(data[t]));
+    }
+    std::vector<int> mismatches(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int r = 0; r < repeats; ++r) {
+          const std::vector<float> out = model.Forward(data[t]);
+          for (size_t i = 0; i < out.size(); ++i) {
+            if (std::fabs(out[i] - expected[t][i]) > 1e-5f * (1.0f + std::fabs(expected[t][i]))) {
+              ++mismatches[t];
+            }
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (int t = 0; t < num_threads; ++t) {
+      EXPECT_EQ(mismatches[t], 0) << "static_alloc=" << static_alloc << " thread " << t;
+    }
+  }
+}
+
+/*!
+ * \brief Forwards per second against the number of calling threads, with one shared state
+ *        and with a state per thread
+ */
+TEST(CachedOpThreadSafe, ThroughputCPU) {
+  std::vector<int> thread_counts{1, 2, 4, 8};
+  if (test::performance_run) {
+    thread_counts.push_back(16);
+    thread_counts.push_back(32);
+  }
+  const int forwards = test::performance_run ? 200 : 20;
+  const NDArray data = test::FilledArray(mxnet::TShape({kBatch, kInputDim}), 0.0f);
+  for (bool static_alloc : {false, true}) {
+    for (int num_states : {1, 0}) {
+      ThreadSafeMLP model(static_alloc, num_states);
+      model.Forward(data);
+      for (int num_threads : thread_counts) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+          threads.emplace_back([&]() {
+            for (int r = 0; r < forwards; ++r) {
+              model.Forward(data);
+            }
+          });
+        }
+        for (auto& thread : threads) {
+          thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "static_alloc=" << static_alloc << " num_states=" << num_states << " "
+                  << num_threads << " threads: " << num_threads * forwards / elapsed.count()
+                  << " forwards/s" << std::endl;
+      }
+    }
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file test_cached_op.h
+ * \brief A small model and its parameters for the tests of CachedOp and the layers above it
+ */
+#ifndef TEST_CACHED_OP_H_
+#define TEST_CACHED_OP_H_
+
+#include <mxnet/c_api.h>
+#include <mxnet/ndarray.h>
+#include <nnvm/op.h>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mxnet {
+namespace test {
+
+/*! \brief symbol of the operator op applied to input */
+inline SymbolHandle ApplyOp(const char* op,
+                            const std::string& name,
+                            const std::vector<std::pair<std::string, std::string>>& params,
+                            SymbolHandle input) {
+  std::vector<const char*> keys, vals;
+  for (const auto& param : params) {
+    keys.push_back(param.first.c_str());
+    vals.push_back(param.second.c_str());
+  }
+  AtomicSymbolCreator creator = const_cast<nnvm::Op*>(nnvm::Op::Get(op));
+  SymbolHandle out;
+  CHECK_EQ(MXSymbolCreateAtomicSymbol(creator, keys.size(), keys.data(), vals.data(), &out), 0);
+  CHECK_EQ(MXSymbolCompose(out, name.c_str(), 1, nullptr, &input), 0) << MXGetLastError();
+  return out;
+}
+
+/*!
+ * \brief depth layers of FullyConnected and relu, with the inputs data, fc0_weight, fc0_bias,
+ *        fc1_weight, ...
+ */
+inline SymbolHandle MLPSymbol(int depth, int num_hidden) {
+  SymbolHandle out;
+  CHECK_EQ(MXSymbolCreateVariable("data", &out), 0);
+  for (int i = 0; i < depth; ++i) {
+    const std::string layer = std::to_string(i);
+    SymbolHandle fc =
+        ApplyOp("FullyConnected", "fc" + layer, {{"num_hidden", std::to_string(num_hidden)}}, out);
+    MXSymbolFree(out);
+    out = ApplyOp("Activation", "relu" + layer, {{"act_type", "relu"}}, fc);
+    MXSymbolFree(fc);
+  }
+  return out;
+}
+
+/*! \brief float32 array on the CPU with deterministic values in [-0.1, 0.1] */
+inline NDArray FilledArray(const mxnet::TShape& shape, float seed) {
+  NDArray arr(shape, Context::CPU(), false, mshadow::kFloat32);
+  float* data = arr.data().dptr<float>();
+  for (size_t i = 0; i < shape.Size(); ++i) {
+    data[i] = 0.1f * std::sin(0.37f * i + seed);
+  }
+  return arr;
+}
+
+/*! \brief the parameters of MLPSymbol, in the order of its inputs */
+inline std::vector<NDArray> MLPParams(int depth, int input_dim, int num_hidden) {
+  std::vector<NDArray> params;
+  for (int i = 0; i < depth; ++i) {
+    const int in_dim = i == 0 ? input_dim : num_hidden;
+    params.push_back(FilledArray(mxnet::TShape({num_hidden, in_dim}), i));
+    params.push_back(FilledArray(mxnet::TShape({num_hidden}), -i));
+  }
+  return params;
+}
+
+/*! \brief param_indices flag of a CachedOp of MLPSymbol */
+inline std::string MLPParamIndices(int depth) {
+  std::string ret;
+  for (int i = 1; i <= 2 * depth; ++i) {
+    ret += (i == 1 ? "[" : ", ") + std::to_string(i);
+  }
+  return ret + "]";
+}
+
+}  // namespace test
+}  // namespace mxnet
+
+#endif  // TEST_CACHED_OP_H_
@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file object_pool_test.cc
+ * \brief Lifetime of objects of the per-thread object pools, and the allocations they save
+ */
+#include <gtest/gtest.h>
+#include <mxnet/imperative.h>
+#include <mxnet/ndarray.h>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../../src/common/object_pool.h"
+#include "../include/test_util.h"
+
+using namespace mxnet;
+
+namespace {
+
+struct PooledObject : public common::ObjectPoolAllocatable<PooledObject> {
+  explicit PooledObject(int value) : values(16, value) {}
+  std::vector<int> values;
+};
+
+bool Holds(const PooledObject* object, int value) {
+  for (int v : object->values) {
+    if (v != value)
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(ObjectPool, FreedByOtherThreads) {
+  const int num_objects = 10000;
+  const int num_threads = 4;
+  for (int round = 0; round < 10; ++round) {
+    std::vector<PooledObject*> objects(num_objects);
+    std::thread([&]() {
+      for (int i = 0; i < num_objects; ++i) {
+        objects[i] = PooledObject::New(i);
+      }
+    }).join();
+    std::vector<int> corrupted(num_threads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int i = t; i < num_objects; i += num_threads) {
+          corrupted[t] += !Holds(objects[i], i);
+          PooledObject::Delete(objects[i]);
+        }
+        // reuses what this and the other threads freed
+        std::vector<PooledObject*> own;
+        for (int i = 0; i < 500; ++i) {
+          own.push_back(PooledObject::New(-t));
+        }
+        for (PooledObject* object : own) {
+          corrupted[t] += !Holds(object, -t);
+          PooledObject::Delete(object);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (int t = 0; t < num_threads; ++t) {
+      EXPECT_EQ(corrupted[t], 0) << "round " << round << " thread " << t;
+    }
+  }
+}
+
+TEST(ObjectPool, ExitingThreadsReturnTheirCache) {
+  auto pool = common::ObjectPool<PooledObject>::Get();
+  PooledObject::Delete(PooledObject::New(0));
+  const size_t num_pages = pool->num_pages();
+  for (int i = 0; i < 200; ++i) {
+    std::thread([]() {
+      std::vector<PooledObject*> objects;
+      for (int j = 0; j < 50; ++j) {
+        objects.push_back(PooledObject::New(j));
+      }
+      for (PooledObject* object : objects) {
+        PooledObject::Delete(object);
+      }
+    }).join();
+  }
+  EXPECT_LE(pool->num_pages(), num_pages + 1);
+}
+
+TEST(ObjectPool, NDArrayOutlivesItsHandle) {
+  const mxnet::TShape shape({4, 5});
+  std::vector<NDArray> copies;
+  std::vector<NDArray*> handles;
+  for (int i = 0; i < 100; ++i) {
+    NDArray* handle = new NDArray(shape, Context::CPU());
+    *handle         = static_cast<real_t>(i);
+    handles.push_back(handle);
+    copies.push_back(*handle);
+  }
+  // the handles are freed by another thread, the chunks stay with the copies
+  std::thread([&]() {
+    for (NDArray* handle : handles) {
+      delete handle;
+    }
+  }).join();
+  for (int i = 0; i < 100; ++i) {
+    copies[i].WaitToRead();
+    EXPECT_EQ(copies[i].shape(), shape);
+    const real_t* data = copies[i].data().dptr<real_t>();
+    for (size_t j = 0; j < shape.Size(); ++j) {
+      EXPECT_EQ(data[j], static_cast<real_t>(i));
+    }
+  }
+  // the chunks are released once the copies are gone
+  copies.clear();
+  Engine::Get()->WaitForAll();
+}
+
+/*!
+ * \brief Pages allocated, and time taken, to create and free NDArray handles of unallocated
+ *        arrays as imperative outputs are, after warm-up the pools serve them all
+ */
+TEST(ObjectPool, NDArrayAllocationCount) {
+  const int iterations = test::performance_run ? 1000000 : 10000;
+  const int live       = 16;
+  const mxnet::TShape shape({2, 2});
+  auto run = [&]() {
+    std::vector<NDArray*> handles(live, nullptr);
+    for (int i = 0; i < iterations; ++i) {
+      delete handles[i % live];
+      handles[i % live] = new NDArray(shape, Context::CPU(), true);
+    }
+    for (NDArray* handle : handles) {
+      delete handle;
+    }
+  };
+  run();
+  const size_t handle_pages = common::ObjectPool<NDArray>::Get()->num_pages();
+  const auto start          = std::chrono::steady_clock::now();
+  run();
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(common::ObjectPool<NDArray>::Get()->num_pages(), handle_pages);
+  std::cout << iterations << " NDArray handles with chunks: " << elapsed.count() / iterations
+            << " ns each, " << handle_pages << " pages of handles" << std::endl;
+}
@@ -0,0 +1,208 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  \file vector_math_perf.cc
+ *  \brief Accuracy and perf/profile run of the vectorizable math functions of the CPU
+ *         unary operators
+ */
+
+#include <gtest/gtest.h>
+#include <mxnet/tensor_blob.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include "../../src/operator/vector_math-inl.h"
+#include "../include/test_op_runner.h"
+#include "../include/test_core_op.h"
+
+using namespace mxnet;
+namespace vector_math = mxnet::op::vector_math;
+
+using kwargs_t = test::op::kwargs_t;
+
+/*! \brief Distance in units in the last place between two floats of normal magnitude */
+static int64_t UlpDistance(float a, float b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<int64_t>::max();
+  }
+  int32_t ia, ib;
+  std::memcpy(&ia, &a, sizeof(ia));
+  std::memcpy(&ib, &b, sizeof(ib));
+  // map the sign-magnitude bits to a monotonic integer line
+  const int64_t la = ia < 0 ? INT32_MIN - static_cast<int64_t>(ia) : ia;
+  const int64_t lb = ib < 0 ? INT32_MIN - static_cast<int64_t>(ib) : ib;
+  return la > lb ? la - lb : lb - la;
+}
+
+/*! \brief Largest ulp distance between f and the double precision reference over [lo, hi] */
+template <typename F, typename Ref>
+static int64_t MaxUlpError(F f, Ref ref, float lo, float hi) {
+  int64_t worst   = 0;
+  const int steps = 1 << 20;
+  for (int i = 0; i <= steps; ++i) {
+    const float x = lo + (hi - lo) * (static_cast<float>(i) / steps);
+    const float r = static_cast<float>(ref(static_cast<double>(x)));
+    // denormal results carry fewer significant bits
+    if (std::fabs(r) < std::numeric_limits<float>::min()) {
+      continue;
+    }
+    worst = std::max(worst, UlpDistance(f(x), r));
+  }
+  return worst;
+}
+
+/*!
+ * \brief Error bounds of the approximations over the ranges the activations see
+ */
+TEST(VECTOR_MATH_PERF, Accuracy) {
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::exp(x); },
+                        [](double x) { return std::exp(x); },
+                        -87.0f,
+                        88.0f),
+            1);
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::log(x); },
+                        [](double x) { return std::log(x); },
+                        1e-30f,
+                        1e30f),
+            1);
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::log(x); },
+                        [](double x) { return std::log(x); },
+                        0.5f,
+                        2.0f),
+            1);
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::tanh(x); },
+                        [](double x) { return std::tanh(x); },
+                        -10.0f,
+                        10.0f),
+            2);
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::sigmoid(x); },
+                        [](double x) { return 1.0 / (1.0 + std::exp(-x)); },
+                        -80.0f,
+                        20.0f),
+            2);
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::erf(x); },
+                        [](double x) { return std::erf(x); },
+                        -5.0f,
+                        5.0f),
+            2);
+  // against the rounded x / sqrt(2), whose error the steep tail of gelu amplifies
+  EXPECT_LE(MaxUlpError([](float x) { return vector_math::gelu(x); },
+                        [](double x) {
+                          const float u = static_cast<float>(x) * 0.70710678118654752f;
+                          return 0.5 * x * std::erfc(-static_cast<double>(u));
+                        },
+                        -5.0f,
+                        10.0f),
+            8);
+
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_EQ(vector_math::exp(-inf), 0.0f);
+  EXPECT_EQ(vector_math::exp(100.0f), inf);
+  EXPECT_TRUE(std::isnan(vector_math::exp(nan)));
+  EXPECT_EQ(vector_math::log(0.0f), -inf);
+  EXPECT_EQ(vector_math::log(inf), inf);
+  EXPECT_TRUE(std::isnan(vector_math::log(-1.0f)));
+  EXPECT_EQ(vector_math::log(std::numeric_limits<float>::denorm_min()),
+            std::log(std::numeric_limits<float>::denorm_min()));
+  EXPECT_EQ(vector_math::tanh(inf), 1.0f);
+  EXPECT_EQ(vector_math::tanh(-inf), -1.0f);
+  EXPECT_EQ(vector_math::sigmoid(-inf), 0.0f);
+  EXPECT_EQ(vector_math::sigmoid(inf), 1.0f);
+  EXPECT_EQ(vector_math::erf(inf), 1.0f);
+  EXPECT_EQ(vector_math::erf(-inf), -1.0f);
+  EXPECT_TRUE(std::isnan(vector_math::erf(nan)));
+  EXPECT_EQ(vector_math::gelu(inf), inf);
+}
+
+/*! \brief Milliseconds per pass of out = f(in) */
+template <typename F>
+static double TimeMap(F f, const std::vector<float>& in, std::vector<float>* out, int passes) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < passes; ++p) {
+    for (size_t i = 0; i < in.size(); ++i) {
+      (*out)[i] = f(in[i]);
+    }
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / passes;
+}
+
+/*! \brief Print the time of the vectorized function against its libm counterpart */
+template <typename F, typename Libm>
+static void CompareToLibm(const char* name, F f, Libm libm, const std::vector<float>& in) {
+  const int passes = test::performance_run ? 10 : 2;
+  std::vector<float> out(in.size());
+  const double libm_ms   = TimeMap(libm, in, &out, passes);
+  const double vector_ms = TimeMap(f, in, &out, passes);
+  std::cout << name << ": libm " << libm_ms << " ms, vectorized " << vector_ms << " ms ("
+            << libm_ms / vector_ms << "x) for " << in.size() << " elements" << std::endl;
+}
+
+/*!
+ * \brief Vectorized functions against libm, and the unary operators using them
+ */
+TEST(VECTOR_MATH_PERF, TimingCPU) {
+  std::vector<float> in(test::performance_run ? (1 << 24) : (1 << 16));
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = -8.0f + 16.0f * static_cast<float>(i) / in.size();
+  }
+  CompareToLibm(
+      "exp", [](float x) { return vector_math::exp(x); }, [](float x) { return std::exp(x); }, in);
+  CompareToLibm(
+      "log", [](float x) { return vector_math::log(x); }, [](float x) { return std::log(x); }, in);
+  CompareToLibm(
+      "tanh",
+      [](float x) { return vector_math::tanh(x); },
+      [](float x) { return std::tanh(x); },
+      in);
+  CompareToLibm(
+      "erf", [](float x) { return vector_math::erf(x); }, [](float x) { return std::erf(x); }, in);
+  CompareToLibm(
+      "sigmoid",
+      [](float x) { return vector_math::sigmoid(x); },
+      [](float x) { return 1.0f / (1.0f + std::exp(-x)); },
+      in);
+  CompareToLibm(
+      "gelu",
+      [](float x) { return vector_math::gelu(x); },
+      [](float x) { return 0.5f * x * (1.0f + std::erf(x * static_cast<float>(M_SQRT1_2))); },
+      in);
+
+  std::vector<mxnet::TShape> shapes;
+  if (test::performance_run) {
+    shapes = {{1, 1, 28, 28}, {50, 3, 18, 32}, {20, 3, 128, 128}, {32, 512, 1024}};
+  } else {
+    shapes = {{1, 1, 28, 28}, {50, 3, 18, 32}};
+  }
+  for (const std::string op : {"exp", "log", "tanh", "erf", "sigmoid"}) {
+    const kwargs_t kwargs = test::op::CoreOpExecutor<float>::ArgsWithOpName(
+        {}, op.c_str(), COREOP_BWD_OP_NAME_VALUE_NONE);
+    test::op::CoreOperatorRunner<float> runner;
+    for (const mxnet::TShape& shape : shapes) {
+      runner.TimingTest(op + " Operator CPU", false, false, kwargs, 2, 10, {shape}, false);
+    }
+  }
+}
@@ -271,3 +271,21 @@ def test_bf16_fallback():
     conv_bf16 = mx.sym.Convolution(data_sym_bf16, **conv_params)
     check_operator_accuracy(sym_fp32=conv_fp32, sym_bf16=conv_bf16, data_shape=(3, 32, 28, 28, 4), bf16_use_fp32_params=False)
 
+
+@pytest.mark.parametrize('shape', [(4, 10), (2, 3, 64), (64, 768)])
+def test_bf16_layer_norm_backward(shape):
+    data = mx.nd.random.normal(shape=shape)
+    gamma = mx.nd.random.uniform(low=0.5, high=1.5, shape=(shape[-1],))
+    beta = mx.nd.random.normal(shape=(shape[-1],))
+    ograd = mx.nd.random.normal(shape=shape)
+    outputs = []
+    for dtype in ['float32', bfloat16]:
+        args = [mx.nd.amp_cast(a, dtype=dtype) for a in (data, gamma, beta)]
+        for a in args:
+            a.attach_grad()
+        with mx.autograd.record():
+            out = mx.nd.LayerNorm(*args, axis=-1)
+        out.backward(mx.nd.amp_cast(ograd, dtype=dtype))
+        outputs.append([mx.nd.amp_cast(a, dtype='float32') for a in [out] + [a.grad for a in args]])
+    for fp32, bf16 in zip(*outputs):
+        assert_almost_equal_with_err(bf16, fp32, rtol=1e-1, atol=5e-1, etol=1e-2)
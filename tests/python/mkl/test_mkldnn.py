@@ -18,6 +18,7 @@
 """
 MKL-DNN related test cases
 """
+import gc
 import sys
 import os
 import numpy as np
@@ -29,6 +30,7 @@ from mxnet.gluon import nn
 from mxnet.test_utils import *
 curr_path = os.path.dirname(os.path.abspath(os.path.expanduser(__file__)))
 sys.path.append(os.path.join(curr_path, '../unittest/'))
+from common import TemporaryDirectory
 import itertools
 
 @use_np
@@ -718,3 +720,86 @@ def test_rnn():
 
     for sl, ss, bs, in_s in itertools.product(SEQ_LENGTH, STATE_SIZE, BATCH_SIZE, INPUT_SIZE): 
         batch_check(sl, ss, bs, in_s)
+
+@use_np
+def test_packed_weight_cache():
+    class ConvFC(gluon.HybridBlock):
+        def __init__(self):
+            super(ConvFC, self).__init__()
+            self.conv = nn.Conv2D(channels=16, kernel_size=3)
+            self.fc = nn.Dense(10)
+
+        def forward(self, x):
+            return self.fc(mx.npx.relu(self.conv(x)))
+
+    mx.nd.clear_packed_weights()
+    data = mx.np.random.uniform(size=(2, 4, 8, 8))
+    net = ConvFC()
+    net.initialize()
+    net.hybridize(static_alloc=True, static_shape=True)
+    net.optimize_for(data, backend='MKLDNN')
+    expected = net(data)
+    packed = mx.nd.export_packed_weights()
+    assert len(packed) == 2
+    assert all(name.startswith('onednn:') for name in packed)
+
+    # a second model with the same weights shares the packed copies
+    with TemporaryDirectory() as tmpdir:
+        prefix = os.path.join(tmpdir, 'net')
+        net.export(prefix, packed_weights=True)
+        mx.nd.clear_packed_weights()
+        net2 = gluon.SymbolBlock.imports(prefix + '-symbol.json', ['data'],
+                                         prefix + '-0000.params')
+        assert len(mx.nd.export_packed_weights()) == 2
+        net2.hybridize(static_alloc=True, static_shape=True)
+        net2.optimize_for(data, backend='MKLDNN')
+        assert_almost_equal(net2(data), expected, rtol=1e-5, atol=1e-6)
+        assert len(mx.nd.export_packed_weights()) == 2
+    mx.nd.clear_packed_weights()
+
+    # the entries go with the last model holding them
+    net3 = ConvFC()
+    net3.initialize()
+    net3.hybridize(static_alloc=True, static_shape=True)
+    net3.optimize_for(data, backend='MKLDNN')
+    net3(data).wait_to_read()
+    assert len(mx.nd.export_packed_weights()) == 2
+    del net, net2, net3
+    gc.collect()
+    mx.nd.waitall()
+    assert len(mx.nd.export_packed_weights()) == 0
+
+@pytest.mark.skipif(sys.platform == "win32", reason='shared parameters use POSIX shared memory')
+@use_np
+def test_shared_params_inference():
+    class ConvFC(gluon.HybridBlock):
+        def __init__(self):
+            super(ConvFC, self).__init__()
+            self.conv = nn.Conv2D(channels=16, kernel_size=3, in_channels=4)
+            self.fc = nn.Dense(10, in_units=16 * 6 * 6)
+
+        def forward(self, x):
+            return self.fc(mx.npx.relu(self.conv(x)))
+
+    name = 'test_mkldnn_shared_%d' % os.getpid()
+    data = mx.np.random.uniform(size=(2, 4, 8, 8))
+    net = ConvFC()
+    net.initialize()
+    expected = net(data)
+    params = {k: v.data().as_nd_ndarray() for k, v in net.collect_params().items()}
+    mx.nd.publish_shared_params(name, params)
+    try:
+        shared = ConvFC()
+        shared.load_shared_parameters(name)
+        # the operators pack the weights aside, the segment is never written
+        assert_almost_equal(shared(data), expected, rtol=1e-5, atol=1e-6)
+        shared.hybridize(static_alloc=True, static_shape=True)
+        for _ in range(2):
+            assert_almost_equal(shared(data), expected, rtol=1e-5, atol=1e-6)
+        mx.nd.waitall()
+        mx.nd.detach_shared_params(name)
+        fresh = mx.nd.attach_shared_params(name)
+        for k, v in params.items():
+            assert_almost_equal(fresh[k], v, rtol=0, atol=0)
+    finally:
+        mx.nd.remove_shared_params(name)
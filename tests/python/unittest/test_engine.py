@@ -32,6 +32,21 @@ def test_bulk():
             x += 1
     assert (x.asnumpy() == 104).all()
 
+def test_execution_lane():
+    lane = mx.engine.create_execution_lane('test_lane', 2)
+    assert mx.engine.create_execution_lane('test_lane', 4) == lane
+    with mx.engine.execution_lane('test_lane'):
+        x = mx.nd.ones((10,))
+        for _ in range(10):
+            x += 1
+    assert (x.asnumpy() == 11).all()
+
+    net = mx.gluon.nn.Dense(4, in_units=10)
+    net.initialize()
+    expected = net(x.reshape((1, 10)))
+    net.hybridize(static_alloc=True, execution_lane='test_lane')
+    assert mx.test_utils.almost_equal(net(x.reshape((1, 10))).asnumpy(), expected.asnumpy())
+
 @pytest.mark.skip(reason="OMP platform dependent")
 def test_engine_openmp_after_fork():
     """
@@ -16,6 +16,7 @@
 # under the License.
 
 import os
+import sys
 import gc
 
 import mxnet as mx
@@ -1506,6 +1507,47 @@ def test_hybrid_static_memory_switching(static_alloc, static_shape):
         y.backward()
     mx.npx.waitall()
 
+def test_hybrid_shape_cache():
+    class SeqModel(gluon.HybridBlock):
+        def __init__(self):
+            super(SeqModel, self).__init__()
+            self.dense = nn.Dense(8, flatten=False)
+
+        def forward(self, x):
+            return mx.np.tanh(self.dense(x))
+
+    net = SeqModel()
+    net.initialize()
+    xs = [mx.np.random.uniform(size=(2, length, 4)) for length in [12, 11, 12, 11, 5, 10, 20]]
+    expected = [net(x) for x in xs]
+
+    net.hybridize(static_alloc=True, static_shape=True, shape_cache_size=2)
+    for x, y in zip(xs, expected):
+        assert_almost_equal(net(x), y, rtol=1e-5, atol=1e-6)
+    stats = net._cached_op.shape_cache_stats()
+    assert stats['hits'] == 2 and stats['misses'] == 5
+    assert len(stats['buckets']) == 2
+    assert all('bytes' in bucket for bucket in stats['buckets'])
+
+    # padded to learned buckets along the sequence axis
+    net.hybridize(static_alloc=True, static_shape=True, shape_cache_size=4, bucket_axis=1)
+    for x, y in zip(xs, expected):
+        out = net(x)
+        assert out.shape == y.shape
+        assert_almost_equal(out, y, rtol=1e-5, atol=1e-6)
+
+    # padded to declared buckets, lengths above the last one run unpadded
+    net.hybridize(static_alloc=True, static_shape=True, shape_cache_size=4, bucket_axis=1,
+                  shape_buckets=[8, 16])
+    for x, y in zip(xs, expected):
+        assert_almost_equal(net(x), y, rtol=1e-5, atol=1e-6)
+    stats = net._cached_op.shape_cache_stats()
+    shapes = sorted(shape for bucket in stats['buckets'] for shape in bucket['shapes']
+                    if len(shape) == 3)
+    assert shapes == [[2, 8, 4], [2, 16, 4], [2, 20, 4]]
+    assert stats['hits'] == 4 and stats['misses'] == 3
+
+
 def test_hook():
     global hook_call_count
     hook_call_count = 0
@@ -2874,6 +2916,31 @@ def test_gluon_param_load_dtype_source():
     assert net.weight.dtype == onp.float16
     mx.npx.waitall()
 
+@pytest.mark.skipif(sys.platform == "win32", reason='shared parameters use POSIX shared memory')
+def test_gluon_load_shared_parameters():
+    name = 'test_gluon_shared_%d' % os.getpid()
+    net = mx.gluon.nn.Dense(10, in_units=10)
+    net.initialize()
+    x = mx.np.random.uniform(size=(2, 10))
+    expected = net(x)
+    mx.nd.publish_shared_params(name, {k: v.data() for k, v in net.collect_params().items()})
+    try:
+        nets = []
+        for _ in range(2):
+            shared = mx.gluon.nn.Dense(10, in_units=10)
+            shared.load_shared_parameters(name)
+            shared.hybridize()
+            assert_almost_equal(shared(x), expected)
+            assert shared.weight.grad_req == 'null'
+            nets.append(shared)
+        # the parameters are read-only
+        def write():
+            nets[0].weight.data()[:] = 0
+        assertRaises(mx.base.MXNetError, write)
+        assert_almost_equal(nets[1](x), expected)
+    finally:
+        mx.nd.remove_shared_params(name)
+
 @use_np
 def test_squeeze_consistency():
     class Foo(gluon.HybridBlock):
@@ -20,6 +20,7 @@ import numpy as np
 from distutils.version import LooseVersion
 from itertools import permutations, combinations_with_replacement
 import os
+import sys
 import pickle as pkl
 import random
 import functools
@@ -336,6 +337,27 @@ def test_init_from_scalar():
     assert same(npy, arr.asnumpy())
 
 
+def test_imperative_invoke_cache():
+    # the parsed parameters and inferred outputs of repeated invocations are cached
+    for _ in range(3):
+        for shape in [(2, 3), (4, 5), (2, 3, 4)]:
+            for dtype in ['float32', 'float64', 'int32']:
+                a = np.random.uniform(-5, 5, size=shape).astype(dtype)
+                for axis in [0, 1]:
+                    out = mx.nd.sum(mx.nd.array(a, dtype=dtype), axis=axis)
+                    assert out.dtype == np.dtype(dtype)
+                    assert_almost_equal(out.asnumpy(), a.sum(axis=axis), rtol=1e-5, atol=1e-5)
+                out = mx.nd.zeros(shape[1:], dtype=dtype)
+                mx.nd.sum(mx.nd.array(a, dtype=dtype), axis=0, out=out)
+                assert_almost_equal(out.asnumpy(), a.sum(axis=0), rtol=1e-5, atol=1e-5)
+        # the storage types of the inputs select the output storage type
+        dense = mx.nd.ones((3, 4))
+        sparse = dense.tostype('csr')
+        assert mx.nd.elemwise_add(sparse, sparse).stype == 'csr'
+        assert mx.nd.elemwise_add(dense, dense).stype == 'default'
+        assert_almost_equal(mx.nd.elemwise_add(sparse, sparse).asnumpy(), 2 * np.ones((3, 4)))
+
+
 def test_ndarray_copy():
     c = mx.nd.array(np.random.uniform(-10, 10, (10, 10)))
     d = c.copyto(mx.Context('cpu', 0))
@@ -1257,6 +1279,96 @@ def test_cached():
         o = o * 2
         o.backward()
 
+def test_cached_compiled():
+    sym = mx.sym.Activation(mx.sym.FullyConnected(num_hidden=16, name='fc'), act_type='relu')
+    flags = [('static_alloc', True), ('static_shape', True),
+             ('data_indices', [0]), ('param_indices', [1, 2])]
+    op = mx.nd.CachedOp(sym, flags)
+    data = mx.nd.random.uniform(shape=(4, 8))
+    weight = mx.nd.random.uniform(shape=(16, 8))
+    bias = mx.nd.random.uniform(shape=(16,))
+    expected = op(data, weight, bias)
+    with TemporaryDirectory() as tmpdir:
+        fname = os.path.join(tmpdir, 'model.compiled')
+        op.save_compiled(fname, [data, weight, bias])
+        loaded, inputs = mx.nd.CachedOp.load_compiled(fname)
+        assert inputs[0] is None
+        assert_almost_equal(inputs[1], weight)
+        assert_almost_equal(inputs[2], bias)
+        inputs[0] = data
+        assert_almost_equal(loaded(*inputs), expected, rtol=1e-5, atol=1e-6)
+        # the parameters stay valid once the op is freed
+        del loaded
+        assert_almost_equal(inputs[2], bias)
+        del inputs
+
+def test_cached_partial():
+    data = mx.sym.var('data')
+    stop = mx.sym.var('stop')
+    fc1 = mx.sym.FullyConnected(data, num_hidden=4, name='fc1')
+    fc2 = mx.sym.FullyConnected(fc1, num_hidden=2, name='fc2')
+    sym = mx.sym.Group([mx.sym.identity(stop), mx.sym.sum(fc1), fc2])
+    names = sym.list_inputs()
+    values = {'data': mx.nd.random.uniform(shape=(3, 5)),
+              'stop': mx.nd.zeros((1,)),
+              'fc1_weight': mx.nd.random.uniform(shape=(4, 5)),
+              'fc1_bias': mx.nd.random.uniform(shape=(4,)),
+              'fc2_weight': mx.nd.random.uniform(shape=(2, 4)),
+              'fc2_bias': mx.nd.random.uniform(shape=(2,))}
+    data_indices = [names.index('data'), names.index('stop')]
+    flags = [('static_alloc', True),
+             ('data_indices', data_indices),
+             ('param_indices', [i for i in range(len(names)) if i not in data_indices])]
+    op = mx.nd.CachedOp(sym, flags)
+    for _ in range(2):
+        values['data'] = mx.nd.random.uniform(shape=(3, 5))
+        args = [values[name] for name in names]
+        expected = op(*args)
+        assert_almost_equal(op(*args, requested_outputs=[1]), expected[1])
+        outputs = op(*args, requested_outputs=[1, 2])
+        assert len(outputs) == 2
+        assert_almost_equal(outputs[0], expected[1])
+        assert_almost_equal(outputs[1], expected[2])
+
+    # the operators after the exit output are skipped when it is non-zero
+    exit_op = mx.nd.CachedOp(sym, flags + [('exit_output', 0)])
+    outputs = [mx.nd.zeros((1,)), mx.nd.zeros((1,)), mx.nd.full((3, 2), 7)]
+    exit_op(*args, out=outputs)
+    assert_almost_equal(outputs[2], expected[2])
+    values['stop'] = mx.nd.ones((1,))
+    outputs[2][:] = 7
+    exit_op(*[values[name] for name in names], out=outputs)
+    assert_almost_equal(outputs[0], values['stop'])
+    assert_almost_equal(outputs[2], mx.nd.full((3, 2), 7))
+
+@pytest.mark.skipif(sys.platform == "win32", reason='shared parameters use POSIX shared memory')
+def test_shared_params():
+    name = 'test_shared_params_%d' % os.getpid()
+    params = {'weight': mx.nd.random.uniform(shape=(16, 8)),
+              'bias': mx.nd.arange(16, dtype='int32')}
+    published = mx.nd.publish_shared_params(name, params)
+    try:
+        assertRaises(mx.base.MXNetError, mx.nd.publish_shared_params, name, params)
+        attached = mx.nd.attach_shared_params(name)
+        for k, v in params.items():
+            assert attached[k].dtype == v.dtype
+            assert_almost_equal(attached[k], v)
+        # the arrays are read-only
+        def write():
+            attached['bias'][:] = 0
+        assertRaises(mx.base.MXNetError, write)
+        assertRaises(mx.base.MXNetError, params['bias'].copyto, published['bias'])
+        assertRaises(mx.base.MXNetError, mx.nd.zeros, (16, 8), out=published['weight'])
+        assert_almost_equal(attached['bias'], mx.nd.arange(16, dtype='int32'))
+        assert_almost_equal(published['weight'], params['weight'])
+        mx.nd.detach_shared_params(name)
+        fresh = mx.nd.attach_shared_params(name)
+        assert_almost_equal(fresh['bias'], mx.nd.arange(16, dtype='int32'))
+        assert_almost_equal(attached['weight'], params['weight'])
+    finally:
+        mx.nd.remove_shared_params(name)
+    assertRaises(mx.base.MXNetError, mx.nd.attach_shared_params, name)
+    assert_almost_equal(fresh['weight'], params['weight'])
 
 def test_output():
     shape = (2,2)
@@ -221,3 +221,21 @@ def test_np_arange_default_dtype():
         
         check_deepnp_indices_default_dtype()
         check_np_indices_default_dtype()
+
+
+def test_default_dtype_invoke_cache():
+    # the outputs inferred for an invocation are cached, and must follow the default dtype
+    import platform
+    if 'Windows' not in platform.system():
+        try:
+            for default_dtype, float_dtype in [(False, 'float32'), (True, 'float64'),
+                                               (False, 'float32')]:
+                npx.set_np(dtype=default_dtype)
+                for _ in range(2):
+                    a = np.array([1, 2, 3], dtype='int32')
+                    assert np.true_divide(a, a).dtype == float_dtype
+                    assert np.zeros((2, 3)).dtype == float_dtype
+                    assert np.random.uniform(size=(2,)).dtype == float_dtype
+                npx.reset_np()
+        finally:
+            npx.reset_np()
@@ -8418,6 +8418,47 @@ def test_np_einsum():
                     assert_almost_equal(grad[0][iop], grad[1][iop], rtol=rtol, atol=atol)
 
 
+@use_np
+@pytest.mark.parametrize('optimize', [False, True])
+def test_np_einsum_batched_contraction(optimize):
+    # the same operator sees several shapes, exercising the cached contraction paths and the
+    # batched GEMM lowering of the steps that tensordot cannot handle
+    class TestEinsum(HybridBlock):
+        def __init__(self, subscripts):
+            super(TestEinsum, self).__init__()
+            self._subscripts = subscripts
+
+        def forward(self, *operands):
+            return np.einsum(self._subscripts, *operands, optimize=optimize)
+
+    configs = [
+        ('bij,bjk->bik', [[(2, 3, 4), (2, 4, 5)], [(3, 2, 6), (3, 6, 1)], [(2, 3, 4), (2, 4, 5)]]),
+        ('abcd,adce->ebda', [[(2, 3, 4, 5), (2, 5, 4, 3)], [(1, 2, 2, 3), (1, 3, 2, 4)]]),
+        ('bij,bkj,bkl->bil', [[(2, 3, 4), (2, 5, 4), (2, 5, 6)], [(4, 2, 3), (4, 3, 3), (4, 3, 2)]]),
+    ]
+    for subscripts, shape_list in configs:
+        test_einsum = TestEinsum(subscripts)
+        test_einsum.hybridize()
+        for shapes in shape_list:
+            x_np = [onp.random.uniform(-1.0, 1.0, shape).astype('float32') for shape in shapes]
+            x = [np.array(v) for v in x_np]
+            for v in x:
+                v.attach_grad()
+            with mx.autograd.record():
+                out = test_einsum(*x)
+            out.backward()
+            expected = onp.einsum(subscripts, *x_np)
+            assert_almost_equal(out.asnumpy(), expected, rtol=1e-4, atol=1e-5)
+            for i in range(len(x)):
+                others = [v for j, v in enumerate(x_np) if j != i]
+                inputs_sub, output_sub = subscripts.split('->')
+                terms = inputs_sub.split(',')
+                grad_sub = ','.join([output_sub] + [t for j, t in enumerate(terms) if j != i]) \
+                    + '->' + terms[i]
+                expected_grad = onp.einsum(grad_sub, onp.ones(expected.shape), *others)
+                assert_almost_equal(x[i].grad.asnumpy(), expected_grad, rtol=1e-4, atol=1e-5)
+
+
 @use_np
 @pytest.mark.skip(reason='Skipped as the test is flaky and the feature causes curand error. Tracked in #18100')
 def test_np_diagflat():
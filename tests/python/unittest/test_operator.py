@@ -677,6 +677,29 @@ def test_sigmoid():
     check_symbolic_forward(y, [xa], [ya])
     check_symbolic_backward(y, [xa], [np.ones(shape)], [ya * (1 - ya)])
 
+@pytest.mark.parametrize('op,ref,low,high,rtol', [
+    (mx.nd.exp, np.exp, -87, 88, 1e-6),
+    (mx.nd.log, np.log, 1e-30, 1e30, 1e-6),
+    (mx.nd.tanh, np.tanh, -20, 20, 1e-6),
+    (mx.nd.erf, np.vectorize(math.erf), -6, 6, 1e-6),
+    (mx.nd.sigmoid, lambda x: 1 / (1 + np.exp(-x)), -80, 30, 1e-6),
+    # gelu amplifies the rounding of x / sqrt(2) in its negative tail
+    (lambda x: mx.nd.LeakyReLU(x, act_type='gelu'),
+     lambda x: 0.5 * x * np.vectorize(math.erfc)(-x / math.sqrt(2)), -5, 10, 2e-5)])
+def test_unary_math_float32_accuracy(op, ref, low, high, rtol):
+    # the float32 CPU kernels use vectorized approximations of the math functions
+    x = np.random.uniform(low, high, size=(3, 1000)).astype(np.float32)
+    x[0, :] = np.linspace(low, high, 1000, dtype=np.float32)
+    out = op(mx.nd.array(x, dtype=np.float32)).asnumpy()
+    expected = ref(x.astype(np.float64))
+    assert_almost_equal(out, expected, rtol=rtol, atol=1e-37)
+    special = np.array([np.inf, -np.inf, np.nan, 0], dtype=np.float32)
+    with np.errstate(all='ignore'):
+        expected = ref(special.astype(np.float64))
+    out = op(mx.nd.array(special, dtype=np.float32)).asnumpy()
+    finite = ~np.isnan(expected)
+    assert np.array_equal(out[finite], expected[finite].astype(np.float32))
+
 def test_log_sigmoid():
     def flog_sigmoid(a):
         return np.log(np.divide(1.0, np.add(1.0, np.exp(-a))))
@@ -1698,10 +1721,11 @@ def test_groupnorm():
                                                                       np_beta.astype(dtype),
                                                                       np_mean, np_std,
                                                                       num_groups, eps)
-        check_symbolic_backward(mx_sym, [mx_data, mx_gamma, mx_beta], [mx.nd.array(np_ograd, dtype=np_ograd.dtype)],
-                                [np_data_grad, np_gamma_grad, np_beta_grad],
-                                rtol=1e-2 if dtype == np.float16 else 1e-3,
-                                atol=5e-2 if dtype == np.float16 else 1e-4, dtype=dtype)
+        for req in ['write', 'add']:
+            check_symbolic_backward(mx_sym, [mx_data, mx_gamma, mx_beta], [mx.nd.array(np_ograd, dtype=np_ograd.dtype)],
+                                    [np_data_grad, np_gamma_grad, np_beta_grad],
+                                    rtol=1e-2 if dtype == np.float16 else 1e-3,
+                                    atol=5e-2 if dtype == np.float16 else 1e-4, grad_req=req, dtype=dtype)
 
 
 def test_convolution_grouping():
@@ -1780,6 +1804,34 @@ def test_depthwise_convolution():
                                 assert_allclose(arr1, arr2, rtol=1e-3, atol=1e-3)
 
 
+@pytest.mark.parametrize('shape,num_filter,num_group,kernel,stride,pad,dilate', [
+    ((2, 24, 29, 31), 24, 2, (3, 3), (1, 1), (1, 1), (1, 1)),   # Winograd F(2x2, 3x3)
+    ((2, 32, 23, 25), 32, 2, (3, 3), (1, 1), (0, 2), (1, 1)),   # Winograd F(2x2, 3x3)
+    ((1, 32, 40, 40), 32, 1, (3, 3), (1, 1), (0, 0), (1, 1)),   # Winograd F(4x4, 3x3)
+    ((2, 8, 15, 16), 8, 8, (3, 3), (1, 1), (1, 1), (1, 1)),     # depthwise
+    ((2, 6, 15, 16), 12, 6, (5, 3), (2, 1), (2, 0), (1, 2)),    # depthwise, multiplier 2
+    ((1, 4, 9, 9), 4, 4, (3, 3), (3, 3), (4, 4), (1, 1)),       # depthwise, large padding
+])
+def test_convolution_cpu_native_algorithms(shape, num_filter, num_group, kernel, stride, pad, dilate):
+    x = mx.sym.Variable('x')
+    y = mx.sym.Convolution(data=x, num_filter=num_filter, num_group=num_group, kernel=kernel,
+                           stride=stride, pad=pad, dilate=dilate, cudnn_off=True)
+    args = None
+    results = []
+    for native in ['0', '1']:
+        with environment('MXNET_CPU_CONV_NATIVE', native):
+            exe = y._simple_bind(mx.cpu(), x=shape)
+            if args is None:
+                args = [np.random.normal(size=arr.shape) for arr in exe.arg_arrays]
+            for arr, arg in zip(exe.arg_arrays, args):
+                arr[:] = arg
+            exe.forward(is_train=True)
+            exe.backward(exe.outputs[0])
+            results.append([arr.asnumpy() for arr in exe.outputs + exe.grad_arrays])
+    for im2col, native in zip(*results):
+        assert_allclose(native, im2col, rtol=1e-3, atol=1e-3)
+
+
 def test_convolution_independent_gradients():
     # NOTE(zixuanweeei): Flaky test tracked by https://github.com/apache/incubator-mxnet/issues/15603.
     # GPU context will be enabled after figuring out the possible issue tracked at
@@ -2185,6 +2237,23 @@ def test_broadcast_binary_op():
     test_bor(a, b)
     test_bxor(a, b)
 
+
+@pytest.mark.parametrize('lshape,rshape', [
+    ((64, 33), (1, 33)), ((64, 33), (64, 1)), ((4, 5, 6, 7), (1, 5, 1, 1)),
+    ((2, 3, 40000), (1, 1, 1)), ((1, 20), (30, 1)), ((1, 5, 1, 17), (4, 1, 3, 17)),
+])
+def test_broadcast_binary_row_patterns(lshape, rshape):
+    # row-, column-, channel- and scalar-like broadcasting, with both operand orders
+    a_np = np.random.uniform(-1, 1, lshape).astype(np.float32)
+    b_np = np.random.uniform(0.5, 1.5, rshape).astype(np.float32)
+    for lhs, rhs in [(a_np, b_np), (b_np, a_np)]:
+        l, r = mx.nd.array(lhs), mx.nd.array(rhs)
+        assert_almost_equal(mx.nd.broadcast_add(l, r), lhs + rhs)
+        assert_almost_equal(mx.nd.broadcast_sub(l, r), lhs - rhs)
+        assert_almost_equal(mx.nd.broadcast_mul(l, r), lhs * rhs)
+        assert_almost_equal(mx.nd.broadcast_div(l, r), lhs / rhs, rtol=1e-5, atol=1e-5)
+        assert_almost_equal(mx.nd.broadcast_maximum(l, r), np.maximum(lhs, rhs))
+
 def test_run_convolution_dilated_impulse_response(dil=(1,1), kernel_shape=(3,3), verbose=False):
     dim = len(dil)
     assert(len(kernel_shape) == dim)
@@ -2516,6 +2585,31 @@ def test_reduce():
                           mx.symbol.norm, test_exclude=False, test_none_axis=test_none)
 
 
+@pytest.mark.parametrize('shape,axis', [
+    ((300, 7), 0), ((300, 7), 1), ((7, 40000), 1), ((40000, 3), 0),
+    ((5, 300, 9), 1), ((3, 4, 5, 6), (1, 2)), ((3, 4, 5, 6), (0, 2)), ((4, 1, 300), (0, 2)),
+])
+def test_reduce_axis_patterns(shape, axis):
+    # innermost, outermost and middle reductions, with few outputs and long reductions
+    data = np.random.uniform(0.5, 1.5, shape).astype(np.float32)
+    x = mx.nd.array(data)
+    reference = [
+        (mx.nd.sum, np.sum), (mx.nd.mean, np.mean), (mx.nd.max, np.max),
+        (mx.nd.min, np.min), (mx.nd.norm, lambda a, axis: np.sqrt(np.sum(a * a, axis=axis))),
+    ]
+    for mx_func, np_func in reference:
+        assert_almost_equal(mx_func(x, axis=axis), np_func(data.astype(np.float64), axis=axis),
+                            rtol=1e-4, atol=1e-4)
+    kept = tuple(i for i in range(len(shape)) if i not in _as_list(axis))
+    assert_almost_equal(mx.nd.sum(x, axis=axis, exclude=True),
+                        np.sum(data.astype(np.float64), axis=kept), rtol=1e-4, atol=1e-4)
+    small = mx.nd.array(np.random.uniform(0.99, 1.01, shape).astype(np.float32))
+    assert_almost_equal(mx.nd.prod(small, axis=axis),
+                        np.prod(small.asnumpy().astype(np.float64), axis=axis), rtol=1e-3, atol=1e-4)
+    data[tuple(d // 2 for d in shape)] = np.nan
+    assert np.isnan(mx.nd.max(mx.nd.array(data), axis=axis).asnumpy()).any()
+
+
 def test_broadcast():
     sample_num = 200
     for _ in range(sample_num):
@@ -4111,6 +4205,25 @@ def test_order():
                     is_ascend=True)])
 
 
+@pytest.mark.parametrize('k', [1, 7, 1000, 20000, 70000])
+@pytest.mark.parametrize('is_ascend', [True, False])
+def test_topk_long_rows(k, is_ascend):
+    # few rows of many elements are sorted with all the threads inside each row
+    m, n = 2, 70000
+    a_npy = np.stack([np.random.permutation(n) for _ in range(m)]).astype(np.float32)
+    order = np.argsort(a_npy, axis=-1)
+    if not is_ascend:
+        order = order[:, ::-1]
+    gt_indices = order[:, :k]
+    gt_values = np.take_along_axis(a_npy, gt_indices, axis=-1)
+    values, indices = mx.nd.topk(mx.nd.array(a_npy), axis=-1, k=k, ret_typ='both',
+                                 is_ascend=is_ascend)
+    assert_almost_equal(values.asnumpy(), gt_values)
+    assert_almost_equal(indices.asnumpy(), gt_indices)
+    mask = mx.nd.topk(mx.nd.array(a_npy), axis=-1, k=k, ret_typ='mask', is_ascend=is_ascend)
+    assert_almost_equal(mask.asnumpy().sum(axis=-1), np.full((m,), k))
+
+
 def test_blockgrad():
     a = mx.sym.Variable('a')
     b = mx.sym.BlockGrad(a)
@@ -4890,6 +5003,65 @@ def test_log_softmax():
             check_symbolic_forward(sym, [data], [np.log(np_softmax(data, axis=axis)+1e-20)], rtol=1e-3, atol=1e-4)
             check_numeric_gradient(sym, [data], rtol=1e-1, atol=1e-2)
 
+@pytest.mark.parametrize('shape', [(3, 5), (4, 129), (1, 70000), (2, 40000)])
+@pytest.mark.parametrize('temperature', [1.0, 2.5])
+def test_softmax_long_rows(shape, temperature):
+    data = np.random.uniform(-10, 10, size=shape).astype(np.float32)
+    # masked out logits and rows that start far from their maximum
+    data[:, ::7] = -np.inf
+    data[:, -1] = 20
+    expected = np_softmax(data, axis=-1, temperature=temperature)
+    out = mx.nd.softmax(mx.nd.array(data), axis=-1, temperature=temperature)
+    assert_almost_equal(out, expected, rtol=1e-4, atol=1e-6)
+    out = mx.nd.log_softmax(mx.nd.array(data), axis=-1, temperature=temperature)
+    finite = np.isfinite(data)
+    assert_almost_equal(out.asnumpy()[finite], np.log(expected[finite]), rtol=1e-4, atol=1e-4)
+    assert np.all(out.asnumpy()[~finite] == -np.inf)
+
+@pytest.mark.parametrize('shape,axis', [((5,), 0), ((4, 7), -1), ((4, 3000), 1),
+                                        ((3, 6, 2), 1), ((2, 3, 4), 0)])
+@pytest.mark.parametrize('temperature', [None, 0.5])
+def test_log_softmax_nll(shape, axis, temperature):
+    t = 1.0 if temperature is None else temperature
+    ax = axis % len(shape)
+    # the label has the shape of the data without the axis, kept as (1,) for 1-d data
+    keep_shape = shape[:ax] + (1,) + shape[ax + 1:]
+    label_shape = shape[:ax] + shape[ax + 1:] or (1,)
+    data = np.random.uniform(-5, 5, size=shape)
+    label = np.random.randint(0, shape[ax], size=label_shape)
+    index = label.reshape(keep_shape)
+    log_prob = np.log(np_softmax(data, axis=axis, temperature=t))
+    expected_fwd = -np.take_along_axis(log_prob, index, axis=ax).reshape(label_shape)
+    ograd = np.random.uniform(0.5, 1.5, size=label_shape)
+    one_hot = np.zeros(shape)
+    np.put_along_axis(one_hot, index, 1, axis=ax)
+    expected_bwd = (np.exp(log_prob) - one_hot) / t * ograd.reshape(keep_shape)
+    sym = mx.sym.log_softmax_nll(mx.sym.Variable('data'), mx.sym.Variable('label'),
+                                 axis=axis, temperature=temperature)
+    location = {'data': data, 'label': label}
+    check_symbolic_forward(sym, location, [expected_fwd], rtol=1e-4, atol=1e-5)
+    check_symbolic_backward(sym, location, [ograd], [expected_bwd, np.zeros(label_shape)],
+                            rtol=1e-4, atol=1e-5)
+    check_symbolic_backward(sym, location, [ograd], {'data': expected_bwd}, rtol=1e-4, atol=1e-5,
+                            grad_req={'data': 'add', 'label': 'null'})
+
+@pytest.mark.parametrize('idtype,odtype', [('float16', 'float32'), ('float32', 'float64')])
+def test_log_softmax_nll_dtype(idtype, odtype):
+    data = np.random.uniform(-5, 5, size=(6, 10))
+    label = np.random.randint(0, 10, size=(6,))
+    ograd = np.random.uniform(0.5, 1.5, size=(6,))
+    x = mx.nd.array(data, dtype=idtype)
+    x.attach_grad()
+    with mx.autograd.record():
+        loss = mx.nd.log_softmax_nll(x, mx.nd.array(label), axis=-1, dtype=odtype)
+    loss.backward(mx.nd.array(ograd, dtype=odtype))
+    assert loss.dtype == np.dtype(odtype)
+    assert x.grad.dtype == np.dtype(idtype)
+    log_prob = np.log(np_softmax(x.asnumpy().astype(np.float64), axis=-1))
+    one_hot = np.eye(10)[label]
+    expected_bwd = (np.exp(log_prob) - one_hot) * ograd[:, None]
+    assert_almost_equal(x.grad, expected_bwd, rtol=1e-2, atol=1e-3)
+
 def test_softmax_with_large_inputs():
     def softmax_forward(input_data, true_output):
         data = mx.sym.Variable('data')
@@ -9462,6 +9634,7 @@ def test_sldwin_selfatten_operators():
         for d in [1, 2, 3]:
             test_sldwin_atten_op_impl(2, 128, 2, 8, 16, symmetric, d)
             test_sldwin_atten_op_impl(1, 8, 2, 4, 2, symmetric, d)
+            test_sldwin_atten_op_impl(1, 67, 3, 12, 5, symmetric, d)
 
 def test_zero_sized_dim():
 
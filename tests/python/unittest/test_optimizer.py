@@ -463,6 +463,44 @@ def test_adam():
                               rtol=1e-4, atol=2e-5)
 
 
+@pytest.mark.parametrize('dtype', [np.float32, np.float16,
+                                   np.dtype([('bfloat16', np.uint16)])])
+def test_multi_adam_update(dtype):
+    # many weights of mixed sizes, some larger than one chunk of the CPU kernel
+    shapes = [(3, 4), (5000,), (7,), (65, 130)] * 16
+    kwargs = {'beta1': 0.8, 'beta2': 0.95, 'epsilon': 1e-6,
+              'rescale_grad': 0.7, 'clip_gradient': 0.5}
+    lrs = [0.01 * (i % 5 + 1) for i in range(len(shapes))]
+    wds = [0.001 * (i % 3) for i in range(len(shapes))]
+    multi_precision = dtype != np.float32
+    fused_args, expected = [], []
+    for shape, lr, wd in zip(shapes, lrs, wds):
+        weight32 = mx.nd.random.uniform(-1, 1, shape)
+        grad32 = mx.nd.random.uniform(-1, 1, shape)
+        mean = mx.nd.random.uniform(0, 1, shape)
+        var = mx.nd.random.uniform(0, 1, shape)
+        weight, grad = weight32.astype(dtype), grad32.astype(dtype)
+        ref = [weight32.copy(), mean.copy(), var.copy()]
+        mx.nd.adam_update(ref[0], grad.astype(np.float32), ref[1], ref[2], out=ref[0],
+                          lr=lr, wd=wd, **kwargs)
+        expected.append(ref)
+        if multi_precision:
+            fused_args.append([weight, grad, mean, var, weight32])
+        else:
+            fused_args.append([weight, grad, mean, var])
+    op = mx.nd.multi_mp_adam_update if multi_precision else mx.nd.multi_adam_update
+    op(*[a for args in fused_args for a in args], out=[args[0] for args in fused_args],
+       lrs=lrs, wds=wds, num_weights=len(shapes), **kwargs)
+    for args, ref in zip(fused_args, expected):
+        assert_almost_equal(args[2], ref[1], rtol=1e-4, atol=1e-5)
+        assert_almost_equal(args[3], ref[2], rtol=1e-4, atol=1e-5)
+        if multi_precision:
+            assert_almost_equal(args[4], ref[0], rtol=1e-4, atol=1e-5)
+        # allow the low precision weight to round differently
+        rtol = 1e-2 if multi_precision else 1e-4
+        assert_almost_equal(args[0].astype(np.float32), ref[0], rtol=rtol, atol=1e-2 * rtol)
+
+
 @xfail_when_nonstandard_decimal_separator
 def test_sparse_adam():
     opt1 = PySparseAdam
@@ -858,6 +896,40 @@ def test_sparse_adagrad():
                                   g_stype='row_sparse')
 
 
+@pytest.mark.parametrize('w_stype', ['default', 'row_sparse'])
+@pytest.mark.parametrize('op_name,num_states,kwargs', [
+    ('adam_update', 2, {'beta1': 0.8, 'beta2': 0.95, 'epsilon': 1e-6}),
+    ('adagrad_update', 1, {'epsilon': 1e-6}),
+    ('ftrl_update', 2, {'lamda1': 0.01, 'beta': 1.5}),
+])
+def test_sparse_multi_update(op_name, num_states, kwargs, w_stype):
+    # the fused update of many weights must match one single-tensor update per weight
+    shapes = [(50, 4), (7, 3, 2), (200, 1), (1, 9)]
+    lrs = [0.1, 0.05, 0.2, 0.01]
+    wds = [0.0, 0.01, 0.0, 0.03] if op_name != 'adagrad_update' else [0.0] * len(shapes)
+    kwargs = dict(kwargs, rescale_grad=0.7, clip_gradient=0.5)
+    fused_args, expected = [], []
+    for i, shape in enumerate(shapes):
+        weight = rand_ndarray(shape, 'default')
+        grad = rand_ndarray(shape, 'row_sparse', density=0.3 if i else 0.0)
+        states = [mx.nd.abs(rand_ndarray(shape, 'default')) for _ in range(num_states)]
+        # row_sparse weights select the lazy update of the single-tensor operators
+        ref = [weight.tostype('row_sparse')] + [s.tostype('row_sparse') for s in states]
+        extra = {'wd': wds[i]} if op_name != 'adagrad_update' else {}
+        getattr(mx.nd.sparse, op_name)(ref[0], grad, *ref[1:], out=ref[0],
+                                        lr=lrs[i], **dict(kwargs, **extra))
+        expected.append(ref)
+        fused_args.append([weight.tostype(w_stype), grad] + [s.tostype(w_stype) for s in states])
+    weights = [args[0] for args in fused_args]
+    getattr(mx.nd.sparse, 'multi_' + op_name)(*[a for args in fused_args for a in args],
+                                               out=weights, lrs=lrs, wds=wds,
+                                               num_weights=len(shapes), **kwargs)
+    for args, ref in zip(fused_args, expected):
+        for arr, ref_arr in zip(args[:1] + args[2:], ref):
+            assert_almost_equal(arr.tostype('default'), ref_arr.tostype('default'),
+                                rtol=1e-4, atol=1e-5)
+
+
 def test_adadelta():
     opt1 = mx.optimizer.AdaDelta
     opt2 = mx.optimizer.AdaDelta
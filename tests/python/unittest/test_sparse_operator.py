@@ -1375,6 +1375,19 @@ def test_sparse_dot():
     test_sparse_dot_zero_output(rand_shape_2d(50, 200), False, 40)
     test_sparse_dot_zero_output(rand_shape_2d(50, 200), True, 40)
 
+def test_sparse_dot_skewed_rows():
+    # a few rows hold most of the nonzeros, so some of them are split between threads
+    num_rows, num_cols = 64, 3000
+    lhs_dns = np.zeros((num_rows, num_cols), dtype=np.float32)
+    lhs_dns[np.arange(num_rows), rnd.randint(0, num_cols, size=num_rows)] = 1
+    for row in [0, 7, 63]:
+        lhs_dns[row, :] = np.random.uniform(size=num_cols)
+    lhs_nd = mx.nd.array(lhs_dns).tostype('csr')
+    for rhs_num_cols in [1, 7, 16]:
+        rhs_dns = np.random.uniform(size=(num_cols, rhs_num_cols)).astype(np.float32)
+        out = mx.nd.sparse.dot(lhs_nd, mx.nd.array(rhs_dns))
+        assert_almost_equal(out.asnumpy(), np.dot(lhs_dns, rhs_dns), rtol=1e-3, atol=1e-3)
+
 @pytest.mark.serial
 def test_sparse_dot_determinism():
     def check_dot_determinism(lhs_stype, rhs_stype, lhs_density, rhs_density, transpose_a, transpose_b, forward_stype):
@@ -1789,6 +1802,8 @@ def test_sparse_embedding():
     sparse_grads = [True, False]
     for sparse_grad in sparse_grads:
         check_sparse_embedding(in_dim, out_dim, batch, densities, sparse_grad)
+    # many repeated lookups per row, spanning several radix digits of the row ids
+    check_sparse_embedding(3000, 5, 2048, [0.5], True)
 
 def test_sparse_broadcast_add_sub():
     def check_broadcast_add(mx_lhs, mx_rhs, np_lhs, np_rhs, dtype):